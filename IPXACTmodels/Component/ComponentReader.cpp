@@ -14,12 +14,21 @@
 
 #include <IPXACTmodels/common/ChoiceReader.h>
 #include <IPXACTmodels/common/NameGroupReader.h>
+#include <IPXACTmodels/common/XmlFragmentReader.h>
 #include <IPXACTmodels/Component/BusInterfaceReader.h>
 #include <IPXACTmodels/Component/ChannelReader.h>
 #include <IPXACTmodels/Component/RemapStateReader.h>
 #include <IPXACTmodels/Component/ModeReader.h>
 #include <IPXACTmodels/Component/AddressSpaceReader.h>
 #include <IPXACTmodels/Component/MemoryMapReader.h>
+#include <IPXACTmodels/Component/MemoryMap.h>
+#include <IPXACTmodels/Component/AddressBlockReader.h>
+#include <IPXACTmodels/Component/AddressBlock.h>
+#include <IPXACTmodels/Component/SubspaceMapReader.h>
+#include <IPXACTmodels/Component/SubSpaceMap.h>
+#include <IPXACTmodels/Component/RegisterReader.h>
+#include <IPXACTmodels/Component/Register.h>
+#include <IPXACTmodels/Component/RegisterFile.h>
 #include <IPXACTmodels/Component/ViewReader.h>
 #include <IPXACTmodels/Component/InstantiationsReader.h>
 #include <IPXACTmodels/Component/PortReader.h>
@@ -117,6 +126,89 @@ QSharedPointer<Component> ComponentReader::createComponentFrom(QDomDocument cons
     return newComponent;
 }
 
+//-----------------------------------------------------------------------------
+// Function: ComponentReader::createComponentFrom()
+//-----------------------------------------------------------------------------
+QSharedPointer<Component> ComponentReader::createComponentFrom(QXmlStreamReader& componentReader) const
+{
+    QList<QSharedPointer<BusInterface> > busInterfaces;
+    QList<QSharedPointer<MemoryMap> > memoryMaps;
+    QList<QSharedPointer<Port> > ports;
+    QList<QSharedPointer<FileSet> > fileSets;
+
+    // The repeated top level items are parsed as separate fragments and left out of the component document.
+    auto readComponentItem = [&](QXmlStreamReader& reader, QDomElement const& parentElement)
+    {
+        QDomElement componentElement = parentElement.ownerDocument().documentElement();
+        QDomNode containerParent = parentElement.parentNode();
+        QString itemName = reader.qualifiedName().toString();
+        QString containerName = parentElement.nodeName();
+
+        bool isComponentContainer = containerParent == componentElement;
+        bool isModelContainer = containerParent.nodeName() == QLatin1String("ipxact:model") &&
+            containerParent.parentNode() == componentElement;
+
+        if ((isComponentContainer || isModelContainer) == false)
+        {
+            return false;
+        }
+
+        Document::Revision revision = getXMLDocumentRevision(componentElement);
+
+        if (isComponentContainer && containerName == QLatin1String("ipxact:memoryMaps") &&
+            itemName == QLatin1String("ipxact:memoryMap"))
+        {
+            memoryMaps.append(readMemoryMap(reader, revision));
+            return true;
+        }
+
+        QDomDocument itemDocument;
+        if (isComponentContainer && containerName == QLatin1String("ipxact:busInterfaces") &&
+            itemName == QLatin1String("ipxact:busInterface"))
+        {
+            QDomElement itemElement = XmlFragmentReader::readElement(reader, itemDocument);
+            busInterfaces.append(BusinterfaceReader::createBusinterfaceFrom(itemElement, revision));
+            return true;
+        }
+        else if (isComponentContainer && containerName == QLatin1String("ipxact:fileSets") &&
+            itemName == QLatin1String("ipxact:fileSet"))
+        {
+            QDomElement itemElement = XmlFragmentReader::readElement(reader, itemDocument);
+            fileSets.append(FileSetReader::createFileSetFrom(itemElement, revision));
+            return true;
+        }
+        else if (isModelContainer && containerName == QLatin1String("ipxact:ports") &&
+            itemName == QLatin1String("ipxact:port"))
+        {
+            QDomElement itemElement = XmlFragmentReader::readElement(reader, itemDocument);
+            ports.append(PortReader::createPortFrom(itemElement, revision));
+            return true;
+        }
+
+        return false;
+    };
+
+    QDomDocument componentDocument;
+    if (XmlFragmentReader::readDocument(componentReader, componentDocument, readComponentItem) == false ||
+        componentDocument.documentElement().nodeName() != QLatin1String("ipxact:component"))
+    {
+        return QSharedPointer<Component>();
+    }
+
+    QSharedPointer<Component> newComponent = createComponentFrom(componentDocument);
+
+    newComponent->getBusInterfaces()->append(busInterfaces);
+    newComponent->getMemoryMaps()->append(memoryMaps);
+    newComponent->getFileSets()->append(fileSets);
+
+    if (newComponent->getModel())
+    {
+        newComponent->getModel()->getPorts()->append(ports);
+    }
+
+    return newComponent;
+}
+
 //-----------------------------------------------------------------------------
 // Function: ComponentReader::parsePowerDomains()
 //-----------------------------------------------------------------------------
@@ -858,3 +950,89 @@ void ComponentReader::parseAuthor(QDomNode const& authorNode, QSharedPointer<Com
 {
     newComponent->setAuthor(authorNode.firstChild().nodeValue());
 }
+
+//-----------------------------------------------------------------------------
+// Function: ComponentReader::readMemoryMap()
+//-----------------------------------------------------------------------------
+QSharedPointer<MemoryMap> ComponentReader::readMemoryMap(QXmlStreamReader& reader,
+    Document::Revision docRevision) const
+{
+    QList<QSharedPointer<MemoryBlockBase> > memoryBlocks;
+
+    auto readMemoryBlock = [&](QXmlStreamReader& blockReader, QDomElement const& parentElement)
+    {
+        if (parentElement != parentElement.ownerDocument().documentElement())
+        {
+            return false;
+        }
+
+        QString blockName = blockReader.qualifiedName().toString();
+        if (blockName == QLatin1String("ipxact:addressBlock"))
+        {
+            memoryBlocks.append(readAddressBlock(blockReader, docRevision));
+            return true;
+        }
+        else if (blockName == QLatin1String("ipxact:subspaceMap"))
+        {
+            QDomDocument subspaceDocument;
+            QDomElement subspaceElement = XmlFragmentReader::readElement(blockReader, subspaceDocument);
+            memoryBlocks.append(SubspaceMapReader::createSubspaceMapFrom(subspaceElement, docRevision));
+            return true;
+        }
+
+        return false;
+    };
+
+    QDomDocument memoryMapDocument;
+    QDomElement memoryMapElement = XmlFragmentReader::readElement(reader, memoryMapDocument, readMemoryBlock);
+
+    QSharedPointer<MemoryMap> newMemoryMap = MemoryMapReader::createMemoryMapFrom(memoryMapElement, docRevision);
+    newMemoryMap->getMemoryBlocks()->append(memoryBlocks);
+
+    return newMemoryMap;
+}
+
+//-----------------------------------------------------------------------------
+// Function: ComponentReader::readAddressBlock()
+//-----------------------------------------------------------------------------
+QSharedPointer<AddressBlock> ComponentReader::readAddressBlock(QXmlStreamReader& reader,
+    Document::Revision docRevision) const
+{
+    QList<QSharedPointer<RegisterBase> > registerData;
+
+    auto readRegisterData = [&](QXmlStreamReader& registerReader, QDomElement const& parentElement)
+    {
+        if (parentElement != parentElement.ownerDocument().documentElement())
+        {
+            return false;
+        }
+
+        QString registerName = registerReader.qualifiedName().toString();
+        if (registerName != QLatin1String("ipxact:register") && registerName != QLatin1String("ipxact:registerFile"))
+        {
+            return false;
+        }
+
+        QDomDocument registerDocument;
+        QDomElement registerElement = XmlFragmentReader::readElement(registerReader, registerDocument);
+        if (registerName == QLatin1String("ipxact:register"))
+        {
+            registerData.append(RegisterReader::createRegisterfrom(registerElement, docRevision));
+        }
+        else
+        {
+            registerData.append(RegisterReader::createRegisterFileFrom(registerElement, docRevision));
+        }
+
+        return true;
+    };
+
+    QDomDocument addressBlockDocument;
+    QDomElement addressBlockElement = XmlFragmentReader::readElement(reader, addressBlockDocument, readRegisterData);
+
+    QSharedPointer<AddressBlock> newAddressBlock =
+        AddressBlockReader::createAddressBlockFrom(addressBlockElement, docRevision);
+    newAddressBlock->getRegisterData()->append(registerData);
+
+    return newAddressBlock;
+}
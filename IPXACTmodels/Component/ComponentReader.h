@@ -18,8 +18,11 @@
 
 #include <QSharedPointer>
 #include <QDomNode>
+#include <QXmlStreamReader>
 
+class AddressBlock;
 class Component;
+class MemoryMap;
 class Model;
 
 //-----------------------------------------------------------------------------
@@ -46,6 +49,18 @@ public:
      */
     QSharedPointer<Component> createComponentFrom(QDomDocument const& componentDocument) const;
 
+    /*!
+     *  Creates a new component by streaming the component document.
+     *
+     *  Bus interfaces, memory maps, ports and file sets are parsed one at a time as they are read instead of
+     *  building the whole document tree first. Memory maps are streamed down to their registers.
+     *
+     *    @param [in] componentReader     Stream for the component document.
+     *
+     *    @return The created component, or a null pointer if the document could not be read.
+     */
+    QSharedPointer<Component> createComponentFrom(QXmlStreamReader& componentReader) const;
+
 private:
 
     //! No copying allowed.
@@ -287,6 +302,26 @@ private:
      *    @param [in] newComponent    The new component.
      */
     void parseAuthor(QDomNode const& authorNode, QSharedPointer<Component> newComponent) const;
+
+    /*!
+     *  Reads a memory map from the stream, parsing its memory blocks one at a time.
+     *
+     *    @param [in] reader          The stream positioned at the start of the memory map.
+     *    @param [in] docRevision     The IP-XACT standard revision of the document.
+     *
+     *    @return The created memory map.
+     */
+    QSharedPointer<MemoryMap> readMemoryMap(QXmlStreamReader& reader, Document::Revision docRevision) const;
+
+    /*!
+     *  Reads an address block from the stream, parsing its registers and register files one at a time.
+     *
+     *    @param [in] reader          The stream positioned at the start of the address block.
+     *    @param [in] docRevision     The IP-XACT standard revision of the document.
+     *
+     *    @return The created address block.
+     */
+    QSharedPointer<AddressBlock> readAddressBlock(QXmlStreamReader& reader, Document::Revision docRevision) const;
 };
 
 #endif // COMPONENTREADER_H
\ No newline at end of file
@@ -48,6 +48,7 @@ HEADERS += ./generaldeclarations.h \
     ./common/BuildModel.h \
     ./common/CellSpecification.h \
     ./common/ClockUnit.h \
+    ./common/XmlFragmentReader.h \
     ./common/ConfigurableElementValue.h \
     ./common/ConfigurableVLNVReference.h \
     ./common/DirectionTypes.h \
@@ -359,6 +360,7 @@ SOURCES += ./Component/validators/CollectionValidators.cpp \
     ./common/DocumentReader.cpp \
     ./common/DocumentUtils.cpp \
     ./common/DocumentWriter.cpp \
+    ./common/XmlFragmentReader.cpp \
     ./common/Enumeration.cpp \
     ./common/Extendable.cpp \
     ./common/FileBuilder.cpp \
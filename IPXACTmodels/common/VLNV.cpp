@@ -11,6 +11,7 @@
 
 #include "VLNV.h"
 
+#include <QHashFunctions>
 #include <QString>
 #include <QStringBuilder>
 #include <QStringList>
@@ -34,6 +35,30 @@ namespace
         { QStringLiteral("invalid"), VLNV::INVALID }
 
     };
+
+    //-----------------------------------------------------------------------------
+    // Function: hashCaseInsensitive()
+    //-----------------------------------------------------------------------------
+    size_t hashCaseInsensitive(QString const& text, size_t seed)
+    {
+        // Fold the case of whole code points like the case-insensitive compare does, without copying the text.
+        // The number of code points separates the fields from each other.
+        qsizetype codePointCount = 0;
+        for (qsizetype i = 0; i < text.size(); ++i)
+        {
+            char32_t codePoint = text.at(i).unicode();
+            if (QChar::isHighSurrogate(codePoint) && i + 1 < text.size() && text.at(i + 1).isLowSurrogate())
+            {
+                codePoint = QChar::surrogateToUcs4(text.at(i).unicode(), text.at(i + 1).unicode());
+                ++i;
+            }
+
+            seed = qHashMulti(seed, QChar::toCaseFolded(codePoint));
+            ++codePointCount;
+        }
+
+        return qHashMulti(seed, codePointCount);
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -350,3 +375,14 @@ QString VLNV::IPXactType2String(IPXactType const& type)
 {
     return types.key(type, QStringLiteral("invalid"));	
 }
+
+//-----------------------------------------------------------------------------
+// Function: qHash()
+//-----------------------------------------------------------------------------
+size_t qHash(VLNV const& vlnv, size_t seed) noexcept
+{
+    seed = hashCaseInsensitive(vlnv.getVendor(), seed);
+    seed = hashCaseInsensitive(vlnv.getLibrary(), seed);
+    seed = hashCaseInsensitive(vlnv.getName(), seed);
+    return hashCaseInsensitive(vlnv.getVersion(), seed);
+}
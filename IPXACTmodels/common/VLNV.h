@@ -260,6 +260,17 @@ private:
 	IPXactType type_ = VLNV::INVALID;
 };
 
+/*! Calculates a hash for the VLNV.
+ *
+ *    The hash is consistent with the == operator, so the letter case of the fields and the type are ignored.
+ *
+ *    @param [in] vlnv    The VLNV to hash.
+ *    @param [in] seed    The seed for the hash.
+ *
+ *    @return The hash of the VLNV.
+ */
+IPXACTMODELS_EXPORT size_t qHash(VLNV const& vlnv, size_t seed = 0) noexcept;
+
 // With this declaration, VLNV can be used as a QVariant.
 Q_DECLARE_METATYPE(VLNV);
 
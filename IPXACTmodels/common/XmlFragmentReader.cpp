@@ -0,0 +1,146 @@
+//-----------------------------------------------------------------------------
+// File: XmlFragmentReader.cpp
+//-----------------------------------------------------------------------------
+// Project: Kactus 2
+// Author: Kactus2 team
+// Date: 16.10.2026
+//
+// Description:
+// Builds DOM fragments from a streamed XML document.
+//-----------------------------------------------------------------------------
+
+#include "XmlFragmentReader.h"
+
+#include <QXmlStreamAttributes>
+
+//-----------------------------------------------------------------------------
+// Function: XmlFragmentReader::readDocument()
+//-----------------------------------------------------------------------------
+bool XmlFragmentReader::readDocument(QXmlStreamReader& reader, QDomDocument& document,
+    ChildHandler const& handler)
+{
+    reader.setNamespaceProcessing(false);
+
+    while (reader.atEnd() == false)
+    {
+        reader.readNext();
+
+        if (reader.isStartElement())
+        {
+            if (document.documentElement().isNull() == false)
+            {
+                reader.raiseError(QStringLiteral("Multiple root elements."));
+                break;
+            }
+
+            readElement(reader, document, handler);
+        }
+        else if (reader.isComment())
+        {
+            document.appendChild(document.createComment(reader.text().toString()));
+        }
+        else if (reader.isProcessingInstruction())
+        {
+            document.appendChild(document.createProcessingInstruction(
+                reader.processingInstructionTarget().toString(), reader.processingInstructionData().toString()));
+        }
+    }
+
+    return reader.hasError() == false && document.documentElement().isNull() == false;
+}
+
+//-----------------------------------------------------------------------------
+// Function: XmlFragmentReader::readElement()
+//-----------------------------------------------------------------------------
+QDomElement XmlFragmentReader::readElement(QXmlStreamReader& reader, QDomNode& parentNode,
+    ChildHandler const& handler)
+{
+    QDomDocument document = parentNode.isDocument() ? parentNode.toDocument() : parentNode.ownerDocument();
+
+    QDomElement element = Details::createElement(reader, document);
+    parentNode.appendChild(element);
+
+    QDomElement currentElement = element;
+    QString text;
+    int depth = 1;
+
+    while (depth > 0 && reader.atEnd() == false)
+    {
+        reader.readNext();
+
+        if (reader.isStartElement())
+        {
+            Details::appendText(text, currentElement, document);
+
+            if (handler && handler(reader, currentElement))
+            {
+                continue;
+            }
+
+            QDomElement childElement = Details::createElement(reader, document);
+            currentElement.appendChild(childElement);
+            currentElement = childElement;
+            ++depth;
+        }
+        else if (reader.isEndElement())
+        {
+            Details::appendText(text, currentElement, document);
+
+            --depth;
+            if (depth > 0)
+            {
+                currentElement = currentElement.parentNode().toElement();
+            }
+        }
+        else if (reader.isCDATA())
+        {
+            Details::appendText(text, currentElement, document);
+            currentElement.appendChild(document.createCDATASection(reader.text().toString()));
+        }
+        else if (reader.isCharacters())
+        {
+            text.append(reader.text());
+        }
+        else if (reader.isComment())
+        {
+            Details::appendText(text, currentElement, document);
+            currentElement.appendChild(document.createComment(reader.text().toString()));
+        }
+        else if (reader.isProcessingInstruction())
+        {
+            Details::appendText(text, currentElement, document);
+            currentElement.appendChild(document.createProcessingInstruction(
+                reader.processingInstructionTarget().toString(), reader.processingInstructionData().toString()));
+        }
+    }
+
+    return element;
+}
+
+//-----------------------------------------------------------------------------
+// Function: XmlFragmentReader::Details::createElement()
+//-----------------------------------------------------------------------------
+QDomElement XmlFragmentReader::Details::createElement(QXmlStreamReader const& reader, QDomDocument& document)
+{
+    QDomElement element = document.createElement(reader.qualifiedName().toString());
+
+    for (QXmlStreamAttribute const& attribute : reader.attributes())
+    {
+        element.setAttribute(attribute.qualifiedName().toString(), attribute.value().toString());
+    }
+
+    return element;
+}
+
+//-----------------------------------------------------------------------------
+// Function: XmlFragmentReader::Details::appendText()
+//-----------------------------------------------------------------------------
+void XmlFragmentReader::Details::appendText(QString& text, QDomElement& element, QDomDocument& document)
+{
+    if (text.trimmed().isEmpty() == false)
+    {
+        element.appendChild(document.createTextNode(text));
+    }
+
+    text.clear();
+}
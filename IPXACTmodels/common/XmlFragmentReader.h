@@ -0,0 +1,90 @@
+//-----------------------------------------------------------------------------
+// File: XmlFragmentReader.h
+//-----------------------------------------------------------------------------
+// Project: Kactus 2
+// Author: Kactus2 team
+// Date: 16.10.2026
+//
+// Description:
+// Builds DOM fragments from a streamed XML document.
+//-----------------------------------------------------------------------------
+
+#ifndef XMLFRAGMENTREADER_H
+#define XMLFRAGMENTREADER_H
+
+#include <IPXACTmodels/ipxactmodels_global.h>
+
+#include <QDomDocument>
+#include <QDomElement>
+#include <QXmlStreamReader>
+
+#include <functional>
+
+//-----------------------------------------------------------------------------
+//! Builds DOM fragments from a streamed XML document.
+//!
+//! The element readers use the DOM API. Reading the document through a stream and handing large repeated
+//! child elements to a handler allows them to be parsed one at a time instead of building the whole document
+//! tree in memory first. The built nodes match the ones created by QDomDocument::setContent().
+//-----------------------------------------------------------------------------
+namespace XmlFragmentReader
+{
+    /*!
+     *  Handler for the child elements found while reading.
+     *
+     *    @param [in] reader          The stream positioned at the start of the child element.
+     *    @param [in] parentElement   The already read parent of the child element.
+     *
+     *    @return True, if the handler consumed the child element leaving the stream at its end element,
+     *            false if the child element should be added to the parent element.
+     */
+    using ChildHandler = std::function<bool(QXmlStreamReader& reader, QDomElement const& parentElement)>;
+
+    /*!
+     *  Reads a whole document from the stream.
+     *
+     *    @param [in] reader      The stream to read. Namespace processing is disabled for the stream.
+     *    @param [in] document    The document to read the contents into.
+     *    @param [in] handler     Handler for the child elements, if any.
+     *
+     *    @return True, if the document was read successfully, otherwise false.
+     */
+    IPXACTMODELS_EXPORT bool readDocument(QXmlStreamReader& reader, QDomDocument& document,
+        ChildHandler const& handler = ChildHandler());
+
+    /*!
+     *  Reads the element at the current position of the stream and appends it to the given parent.
+     *
+     *    @param [in] reader      The stream positioned at the start of the element.
+     *    @param [in] parentNode  The node to append the element to.
+     *    @param [in] handler     Handler for the child elements, if any.
+     *
+     *    @return The read element. The stream is left at the end of the element.
+     */
+    IPXACTMODELS_EXPORT QDomElement readElement(QXmlStreamReader& reader, QDomNode& parentNode,
+        ChildHandler const& handler = ChildHandler());
+
+    namespace Details
+    {
+        /*!
+         *  Creates an element with the attributes of the current start element of the stream.
+         *
+         *    @param [in] reader      The stream positioned at the start of an element.
+         *    @param [in] document    The document owning the element.
+         *
+         *    @return The created element.
+         */
+        QDomElement createElement(QXmlStreamReader const& reader, QDomDocument& document);
+
+        /*!
+         *  Appends the collected text to the given element and clears it. Whitespace-only text is discarded.
+         *
+         *    @param [in] text        The collected text.
+         *    @param [in] element     The element to append the text to.
+         *    @param [in] document    The document owning the element.
+         */
+        void appendText(QString& text, QDomElement& element, QDomDocument& document);
+    }
+}
+
+#endif // XMLFRAGMENTREADER_H
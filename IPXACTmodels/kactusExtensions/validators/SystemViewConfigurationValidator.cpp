@@ -75,8 +75,8 @@ void SystemViewConfigurationValidator::changeAvailableSystemViews(QSharedPointer
             {
                 if (instance->getComponentRef() && instance->getComponentRef()->isValid())
                 {
-                    QSharedPointer<Component> component = getLibraryHandler()->getModel(
-                        *instance->getComponentRef().data()).dynamicCast<Component>();
+                    QSharedPointer<Component const> component = getLibraryHandler()->getModelReadOnly<Component>(
+                        *instance->getComponentRef().data());
 
                     if (component)
                     {
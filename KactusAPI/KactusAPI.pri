@@ -24,6 +24,9 @@ HEADERS += ./KactusAPI.h \
     ./include/ConsoleMediator.h \
     ./include/DesignParameterFinder.h \
     ./include/DocumentFileAccess.h \
+    ./include/DocumentMetadata.h \
+    ./include/LibraryArchive.h \
+    ./include/DocumentWriteQueue.h \
     ./include/DocumentValidator.h \
     ./include/ExpressionFormatter.h \
     ./include/ExpressionFormatterFactory.h \
@@ -45,8 +48,14 @@ HEADERS += ./KactusAPI.h \
     ./include/IPlugin.h \
     ./include/IPluginUtility.h \
     ./include/IPXactSystemVerilogParser.h \
+    ./include/ExpressionValue.h \
+    ./include/WideInteger.h \
+    ./include/ResolvedValueCache.h \
     ./include/LibraryInterface.h \
+    ./include/SharedDocument.h \
     ./include/LibraryLoader.h \
+    ./include/LibraryIndex.h \
+    ./include/VLNVTable.h \
     ./include/ListHelper.h \
     ./include/ListParameterFinder.h \
     ./include/MasterPortInterface.h \
@@ -83,6 +92,7 @@ HEADERS += ./KactusAPI.h \
     ./include/SystemVerilogExpressionParser.h \
     ./include/SystemVerilogSyntax.h \
     ./include/TagManager.h \
+    ./include/Tracing.h \
     ./include/TransparentBridgeInterface.h \
     ./include/utils.h \
     ./include/VersionHelper.h \
@@ -107,6 +117,9 @@ SOURCES += ./KactusAPI.cpp \
     ./expressions/ExpressionFormatterFactoryImplementation.cpp \
     ./expressions/FieldExpressionsGatherer.cpp \
     ./expressions/IPXactSystemVerilogParser.cpp \
+    ./expressions/ExpressionValue.cpp \
+    ./expressions/WideInteger.cpp \
+    ./expressions/ResolvedValueCache.cpp \
     ./expressions/ListParameterFinder.cpp \
     ./expressions/MemoryMapExpressionsGatherer.cpp \
     ./expressions/MemoryRemapExpressionGatherer.cpp \
@@ -158,12 +171,18 @@ SOURCES += ./KactusAPI.cpp \
     ./utilities/NullChannel.cpp \
     ./utilities/utils.cpp \
     ./utilities/VersionHelper.cpp \
+    ./utilities/Tracing.cpp \
     ./library/DocumentFileAccess.cpp \
+    ./library/DocumentMetadata.cpp \
+    ./library/LibraryArchive.cpp \
+    ./library/DocumentWriteQueue.cpp \
     ./library/DocumentValidator.cpp \
     ./library/hierarchyitem.cpp \
     ./library/hierarchymodel.cpp \
     ./library/LibraryHandler.cpp \
     ./library/LibraryItem.cpp \
     ./library/LibraryLoader.cpp \
+    ./library/LibraryIndex.cpp \
+    ./library/VLNVTable.cpp \
     ./library/LibraryTreeModel.cpp \
     ./library/TagManager.cpp
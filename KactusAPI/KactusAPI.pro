@@ -6,7 +6,14 @@ TEMPLATE = lib
 TARGET = KactusAPI
 DESTDIR = ../executable
 CONFIG += c++17 release
-QT += xml widgets
+QT += xml widgets concurrent
+
+# The files in library archives are decompressed with the zlib of Qt.
+qtConfig(system-zlib) {
+    LIBS += -lz
+} else {
+    QT_PRIVATE += zlib-private
+}
 DEFINES +=  KACTUS2_EXPORTS
 LIBS += -L"../executable" \
     -lIPXACTmodels 
@@ -157,6 +157,7 @@ void ComponentParameterFinder::registerParameterModel(QAbstractItemModel const*
 void ComponentParameterFinder::setComponent(QSharedPointer<Component const> component)
 {
     component_ = component;
+    parameterIndex_.clear();
 }
 
 //-----------------------------------------------------------------------------
@@ -169,63 +170,256 @@ QSharedPointer<Parameter> ComponentParameterFinder::searchParameter(QStringView
         return nullptr;
     }
 
-    for (QSharedPointer<Parameter> parameter : *component_->getParameters())
+    if (QSharedPointer<Parameter> indexedParameter = findIndexedParameter(parameterId);
+        indexedParameter)
     {
-        if (parameter->getValueId() == parameterId)
-        {
-            return parameter;
-        }
+        return indexedParameter;
     }
 
-    for (QSharedPointer<Parameter> busInterfaceParameter : allBusInterfaceParameters())
+    // The parameter has been added or moved, or it does not exist. The index is rebuilt only when the parameter
+    // is found, so unknown ids cost a single pass over the parameters.
+    QSharedPointer<Parameter> parameter = scanParameter(parameterId);
+    if (parameter)
     {
-        if (busInterfaceParameter->getValueId() == parameterId)
+        rebuildIndex();
+    }
+
+    return parameter;
+}
+
+//-----------------------------------------------------------------------------
+// Function: ComponentParameterFinder::findIndexedParameter()
+//-----------------------------------------------------------------------------
+QSharedPointer<Parameter> ComponentParameterFinder::findIndexedParameter(QStringView parameterId) const
+{
+    auto entry = parameterIndex_.constFind(parameterId.toString());
+    if (entry == parameterIndex_.cend())
+    {
+        return nullptr;
+    }
+
+    // The list is found again from the component, so removing any of its owners is also detected.
+    ParameterList container = parameterListAt(entry->location);
+    if (container.isNull() || entry->position >= container->size() ||
+        container->at(entry->position) != entry->parameter || entry->parameter->getValueId() != parameterId)
+    {
+        return nullptr;
+    }
+
+    return entry->parameter;
+}
+
+//-----------------------------------------------------------------------------
+// Function: ComponentParameterFinder::scanParameter()
+//-----------------------------------------------------------------------------
+QSharedPointer<Parameter> ComponentParameterFinder::scanParameter(QStringView parameterId) const
+{
+    for (LocatedList const& parameterList : allParameterLists())
+    {
+        for (QSharedPointer<Parameter> const& parameter : *parameterList.parameters)
         {
-            return busInterfaceParameter;
+            if (parameter->getValueId() == parameterId)
+            {
+                return parameter;
+            }
         }
     }
 
-    for (QSharedPointer<Parameter> cpuParameter : allCpuParameters())
+    return QSharedPointer<Parameter>();
+}
+
+//-----------------------------------------------------------------------------
+// Function: ComponentParameterFinder::rebuildIndex()
+//-----------------------------------------------------------------------------
+void ComponentParameterFinder::rebuildIndex() const
+{
+    parameterIndex_.clear();
+
+    for (LocatedList const& parameterList : allParameterLists())
     {
-        if (cpuParameter->getValueId() == parameterId)
+        for (int i = 0; i < parameterList.parameters->size(); ++i)
         {
-            return cpuParameter;
+            QSharedPointer<Parameter> const& parameter = parameterList.parameters->at(i);
+
+            // The first parameter with the id is found, as in the search.
+            if (QString const id = parameter->getValueId();
+                id.isEmpty() == false && parameterIndex_.contains(id) == false)
+            {
+                parameterIndex_.insert(id, IndexEntry{ parameter, parameterList.location, i });
+            }
         }
     }
+}
+
+//-----------------------------------------------------------------------------
+// Function: ComponentParameterFinder::allParameterLists()
+//-----------------------------------------------------------------------------
+QVector<ComponentParameterFinder::LocatedList> ComponentParameterFinder::allParameterLists() const
+{
+    QVector<LocatedList> parameterLists({ LocatedList{ ListLocation(), component_->getParameters() } });
+
+    const auto busInterfaces = component_->getBusInterfaces();
+    for (int i = 0; i < busInterfaces->size(); ++i)
+    {
+        parameterLists.append(LocatedList{ { ListOwner::BusInterface, { i, 0, 0 } },
+            busInterfaces->at(i)->getParameters() });
+    }
+
+    const auto cpus = component_->getCpus();
+    for (int i = 0; i < cpus->size(); ++i)
+    {
+        parameterLists.append(LocatedList{ { ListOwner::Cpu, { i, 0, 0 } },
+            cpus->at(i)->getParameters() });
+    }
+
+    const auto generators = component_->getComponentGenerators();
+    for (int i = 0; i < generators->size(); ++i)
+    {
+        parameterLists.append(LocatedList{ { ListOwner::Generator, { i, 0, 0 } },
+            generators->at(i)->getParameters() });
+    }
 
-    for (QSharedPointer<Parameter> generatorParameter : allGeneratorParameters())
+    const auto addressSpaces = component_->getAddressSpaces();
+    for (int i = 0; i < addressSpaces->size(); ++i)
     {
-        if (generatorParameter->getValueId() == parameterId)
+        QSharedPointer<AddressSpace> addressSpace = addressSpaces->at(i);
+        parameterLists.append(LocatedList{ { ListOwner::AddressSpace, { i, 0, 0 } }, addressSpace->getParameters() });
+
+        if (addressSpace->getLocalMemoryMap())
         {
-            return generatorParameter;
+            const auto memoryBlocks = addressSpace->getLocalMemoryMap()->getMemoryBlocks();
+            for (int j = 0; j < memoryBlocks->size(); ++j)
+            {
+                if (QSharedPointer<AddressBlock> addressBlock = memoryBlocks->at(j).dynamicCast<AddressBlock>();
+                    addressBlock)
+                {
+                    const auto registers = addressBlock->getRegisterData();
+                    for (int k = 0; k < registers->size(); ++k)
+                    {
+                        parameterLists.append(LocatedList{ { ListOwner::LocalMemoryMapRegister, { i, j, k } },
+                            registers->at(k)->getParameters() });
+                    }
+                }
+            }
         }
     }
 
-    for (QSharedPointer<Parameter> addressSpaceParameter : allAddressSpaceParameters())
+    const auto memoryMaps = component_->getMemoryMaps();
+    for (int i = 0; i < memoryMaps->size(); ++i)
     {
-        if (addressSpaceParameter->getValueId() == parameterId)
+        const auto memoryBlocks = memoryMaps->at(i)->getMemoryBlocks();
+        for (int j = 0; j < memoryBlocks->size(); ++j)
         {
-            return addressSpaceParameter;
+            if (QSharedPointer<AddressBlock> addressBlock = memoryBlocks->at(j).dynamicCast<AddressBlock>();
+                addressBlock)
+            {
+                const auto registers = addressBlock->getRegisterData();
+                for (int k = 0; k < registers->size(); ++k)
+                {
+                    parameterLists.append(LocatedList{ { ListOwner::MemoryMapRegister, { i, j, k } },
+                        registers->at(k)->getParameters() });
+                }
+            }
         }
     }
 
-    for (QSharedPointer<Parameter> registerParameter : allRegisterParameters())
+    const auto indirectInterfaces = component_->getIndirectInterfaces();
+    for (int i = 0; i < indirectInterfaces->size(); ++i)
     {
-        if (registerParameter->getValueId() == parameterId)
+        parameterLists.append(LocatedList{ { ListOwner::IndirectInterface, { i, 0, 0 } },
+            indirectInterfaces->at(i)->getParameters() });
+    }
+
+    return parameterLists;
+}
+
+//-----------------------------------------------------------------------------
+// Function: ComponentParameterFinder::parameterListAt()
+//-----------------------------------------------------------------------------
+ComponentParameterFinder::ParameterList ComponentParameterFinder::parameterListAt(
+    ListLocation const& location) const
+{
+    // Finds the element at the given position, if the list still has one.
+    auto elementAt = [](auto const& list, int position)
+    {
+        return position < list->size() ? list->at(position) : nullptr;
+    };
+
+    // Finds the register at the given block and register positions of a memory map.
+    auto registerAt = [&elementAt](QSharedPointer<MemoryMapBase> const& memoryMap, int block, int position)
+    {
+        QSharedPointer<AddressBlock> addressBlock;
+        if (memoryMap)
         {
-            return registerParameter;
+            addressBlock = elementAt(memoryMap->getMemoryBlocks(), block).dynamicCast<AddressBlock>();
         }
-    }
 
-    for (auto indirectInterfaceParameter : allIndirectInterfacesParameters())
+        return addressBlock ? elementAt(addressBlock->getRegisterData(), position) : nullptr;
+    };
+
+    const auto& path = location.path;
+    switch (location.owner)
     {
-        if (indirectInterfaceParameter->getValueId() == parameterId)
+    case ListOwner::Component:
+        return component_->getParameters();
+
+    case ListOwner::BusInterface:
+        if (auto busInterface = elementAt(component_->getBusInterfaces(), path[0]); busInterface)
+        {
+            return busInterface->getParameters();
+        }
+        break;
+
+    case ListOwner::Cpu:
+        if (auto cpu = elementAt(component_->getCpus(), path[0]); cpu)
+        {
+            return cpu->getParameters();
+        }
+        break;
+
+    case ListOwner::Generator:
+        if (auto generator = elementAt(component_->getComponentGenerators(), path[0]); generator)
+        {
+            return generator->getParameters();
+        }
+        break;
+
+    case ListOwner::AddressSpace:
+        if (auto addressSpace = elementAt(component_->getAddressSpaces(), path[0]); addressSpace)
+        {
+            return addressSpace->getParameters();
+        }
+        break;
+
+    case ListOwner::LocalMemoryMapRegister:
+        if (auto addressSpace = elementAt(component_->getAddressSpaces(), path[0]); addressSpace)
+        {
+            if (auto registerBase = registerAt(addressSpace->getLocalMemoryMap(), path[1], path[2]); registerBase)
+            {
+                return registerBase->getParameters();
+            }
+        }
+        break;
+
+    case ListOwner::MemoryMapRegister:
+        if (auto memoryMap = elementAt(component_->getMemoryMaps(), path[0]); memoryMap)
         {
-            return indirectInterfaceParameter;
+            if (auto registerBase = registerAt(memoryMap, path[1], path[2]); registerBase)
+            {
+                return registerBase->getParameters();
+            }
+        }
+        break;
+
+    case ListOwner::IndirectInterface:
+        if (auto indirectInterface = elementAt(component_->getIndirectInterfaces(), path[0]); indirectInterface)
+        {
+            return indirectInterface->getParameters();
         }
+        break;
     }
 
-    return QSharedPointer<Parameter>();
+    return ParameterList();
 }
 
 //-----------------------------------------------------------------------------
@@ -57,11 +57,12 @@ QString ExpressionFormatter::format(QString const& expression, QSharedPointer<Ex
 //-----------------------------------------------------------------------------
 QString ExpressionFormatter::getFormattedValue(QString const& expression, QSharedPointer<ExpressionParser> parser, bool* expressionIsValid)
 {
-    QString value = parser->parseExpression(expression, expressionIsValid);
+    int base = 0;
+    QString value = parser->parseExpressionWithBase(expression, expressionIsValid, &base);
     if (expressionIsValid)
     {
         ValueFormatter formatter;
-        return formatter.format(value, parser->baseForExpression(expression));
+        return formatter.format(value, base);
     }
     else
     {
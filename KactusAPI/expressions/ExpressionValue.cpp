@@ -0,0 +1,176 @@
+//-----------------------------------------------------------------------------
+// File: ExpressionValue.cpp
+//-----------------------------------------------------------------------------
+// Project: Kactus2
+// Author: Kactus2 team
+// Date: 16.10.2026
+//
+// Description:
+// Intermediate value in the evaluation of an expression.
+//-----------------------------------------------------------------------------
+
+#include "ExpressionValue.h"
+
+namespace
+{
+    //-----------------------------------------------------------------------------
+    // Function: isCanonicalInteger()
+    //-----------------------------------------------------------------------------
+    bool isCanonicalInteger(QString const& text) noexcept
+    {
+        const bool negative = text.startsWith(QLatin1Char('-'));
+        const QStringView digits = QStringView(text).mid(negative ? 1 : 0);
+
+        // No leading zeros and no negative zero, so the integer prints back to the same text.
+        if (digits.isEmpty() || (digits.front() == QLatin1Char('0') && (digits.size() > 1 || negative)))
+        {
+            return false;
+        }
+
+        for (QChar const& digit : digits)
+        {
+            if (digit < QLatin1Char('0') || digit > QLatin1Char('9'))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------
+    // Function: isDecimalNumber()
+    //-----------------------------------------------------------------------------
+    bool isDecimalNumber(QString const& text) noexcept
+    {
+        const int point = text.indexOf(QLatin1Char('.'));
+        return point > 0 && point < text.size() - 1 && text.indexOf(QLatin1Char('.'), point + 1) == -1;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: ExpressionValue::fromInteger()
+//-----------------------------------------------------------------------------
+ExpressionValue ExpressionValue::fromInteger(qint64 value) noexcept
+{
+    ExpressionValue integerValue;
+    integerValue.type_ = Type::Integer;
+    integerValue.integer_ = value;
+    return integerValue;
+}
+
+//-----------------------------------------------------------------------------
+// Function: ExpressionValue::fromWide()
+//-----------------------------------------------------------------------------
+ExpressionValue ExpressionValue::fromWide(WideInteger const& value) noexcept
+{
+    if (value.fitsInteger())
+    {
+        return fromInteger(value.toInteger());
+    }
+
+    ExpressionValue wideValue;
+    wideValue.type_ = Type::Wide;
+    wideValue.wide_ = value;
+    return wideValue;
+}
+
+//-----------------------------------------------------------------------------
+// Function: ExpressionValue::fromReal()
+//-----------------------------------------------------------------------------
+ExpressionValue ExpressionValue::fromReal(double value, int precision) noexcept
+{
+    ExpressionValue realValue;
+    realValue.type_ = Type::Real;
+    realValue.real_ = value;
+    realValue.precision_ = precision;
+    return realValue;
+}
+
+//-----------------------------------------------------------------------------
+// Function: ExpressionValue::fromText()
+//-----------------------------------------------------------------------------
+ExpressionValue ExpressionValue::fromText(QString const& text)
+{
+    if (text == QLatin1String("x"))
+    {
+        return ExpressionValue();
+    }
+
+    if (isCanonicalInteger(text))
+    {
+        bool isInteger = false;
+        const qint64 value = text.toLongLong(&isInteger);
+        if (isInteger)
+        {
+            return fromInteger(value);
+        }
+
+        if (WideInteger wideValue; WideInteger::fromDecimal(text, wideValue))
+        {
+            return fromWide(wideValue);
+        }
+    }
+    else if (isDecimalNumber(text))
+    {
+        // Only reals printing back to the same text are kept as numbers, so the text is never changed.
+        bool isReal = false;
+        const double value = text.toDouble(&isReal);
+        const int precision = text.size() - text.indexOf(QLatin1Char('.')) - 1;
+        if (isReal && QString::number(value, 'f', precision) == text)
+        {
+            return fromReal(value, precision);
+        }
+    }
+
+    ExpressionValue textValue;
+    textValue.type_ = Type::Text;
+    textValue.text_ = text;
+    return textValue;
+}
+
+//-----------------------------------------------------------------------------
+// Function: ExpressionValue::toDouble()
+//-----------------------------------------------------------------------------
+double ExpressionValue::toDouble() const
+{
+    if (type_ == Type::Integer)
+    {
+        return static_cast<double>(integer_);
+    }
+    else if (type_ == Type::Wide)
+    {
+        return wide_.toDouble();
+    }
+    else if (type_ == Type::Real)
+    {
+        return real_;
+    }
+
+    return text_.toDouble();
+}
+
+//-----------------------------------------------------------------------------
+// Function: ExpressionValue::toString()
+//-----------------------------------------------------------------------------
+QString ExpressionValue::toString() const
+{
+    if (type_ == Type::Integer)
+    {
+        return QString::number(integer_);
+    }
+    else if (type_ == Type::Wide)
+    {
+        return wide_.toString();
+    }
+    else if (type_ == Type::Real)
+    {
+        return QString::number(real_, 'f', precision_);
+    }
+    else if (type_ == Type::Unknown)
+    {
+        return QStringLiteral("x");
+    }
+
+    return text_;
+}
@@ -13,13 +13,52 @@
 
 #include "ParameterFinder.h"
 
+namespace
+{
+    //! The smallest number of cached values at which the values of removed parameters are pruned.
+    const int MINIMUM_PRUNE_LIMIT = 1024;
+}
+
 //-----------------------------------------------------------------------------
 // Function: IPXactSystemVerilogParser::IPXactSystemVerilogParser()
 //-----------------------------------------------------------------------------
 IPXactSystemVerilogParser::IPXactSystemVerilogParser(QSharedPointer<ParameterFinder> finder):
-SystemVerilogExpressionParser(), finder_(finder)
+SystemVerilogExpressionParser(), finder_(finder), pruneLimit_(MINIMUM_PRUNE_LIMIT)
+{
+
+}
+
+//-----------------------------------------------------------------------------
+// Function: IPXactSystemVerilogParser::parseExpression()
+//-----------------------------------------------------------------------------
+QString IPXactSystemVerilogParser::parseExpression(QStringView expression, bool* validExpression) const
 {
+    beginEvaluation();
+    QString value = SystemVerilogExpressionParser::parseExpression(expression, validExpression);
+    endEvaluation();
 
+    return value;
+}
+
+//-----------------------------------------------------------------------------
+// Function: IPXactSystemVerilogParser::parseExpressionWithBase()
+//-----------------------------------------------------------------------------
+QString IPXactSystemVerilogParser::parseExpressionWithBase(QStringView expression, bool* validExpression,
+    int* base) const
+{
+    beginEvaluation();
+    QString value = SystemVerilogExpressionParser::parseExpressionWithBase(expression, validExpression, base);
+    endEvaluation();
+
+    return value;
+}
+
+//-----------------------------------------------------------------------------
+// Function: IPXactSystemVerilogParser::cachedValueCount()
+//-----------------------------------------------------------------------------
+int IPXactSystemVerilogParser::cachedValueCount() const
+{
+    return resolvedValues_.count();
 }
 
 //-----------------------------------------------------------------------------
@@ -27,7 +66,16 @@ SystemVerilogExpressionParser(), finder_(finder)
 //-----------------------------------------------------------------------------
 bool IPXactSystemVerilogParser::isSymbol(QStringView expression) const
 {
-    return finder_->hasId(expression);
+    const bool symbol = finder_->hasId(expression);
+
+    // A value referring to a missing parameter must be resolved again, once the parameter is added.
+    if (symbol == false && resolving_.isEmpty() == false && resolving_.last().recordReferences &&
+        isIdentifier(expression))
+    {
+        resolving_.last().unknownSymbols.append(expression.toString());
+    }
+
+    return symbol;
 }
 
 //-----------------------------------------------------------------------------
@@ -35,18 +83,55 @@ bool IPXactSystemVerilogParser::isSymbol(QStringView expression) const
 //-----------------------------------------------------------------------------
 QString IPXactSystemVerilogParser::findSymbolValue(QStringView expression) const
 {
+    if (resolving_.isEmpty())
+    {
+        // A symbol resolved outside an expression is a pass of its own.
+        if (evaluationDepth_ == 0)
+        {
+            ++resolutionPass_;
+        }
+
+        loopFound_ = false;
+    }
+    else if (resolving_.last().recordReferences)
+    {
+        resolving_.last().dependencies.append(expression.toString());
+    }
+
     // Check for ring references.
-    if (symbolStack_.contains(expression))
+    if (resolvingIds_.contains(expression))
     {
-        symbolStack_.clear();
+        loopFound_ = true;
         return QStringLiteral("x");
     }
 
-    symbolStack_.append(expression);
-    QString value = parseExpression(finder_->valueForId(expression));
-    if (symbolStack_.isEmpty() == false)
+    const QString key = expression.toString();
+    if (ResolvedValueCache::Entry const* cached = findValidValue(expression, key); cached != nullptr)
     {
-        symbolStack_.removeLast();
+        return cached->value;
+    }
+
+    const QString valueExpression = finder_->valueForId(expression);
+
+    resolving_.append(ResolutionFrame{ expression });
+    resolvingIds_.insert(expression);
+
+    QString value = parseExpression(valueExpression);
+
+    resolvingIds_.remove(expression);
+    const ResolutionFrame frame = resolving_.takeLast();
+
+    // Values within a loop depend on where the loop was entered, so they are not cached.
+    if (loopFound_ == false)
+    {
+        ResolvedValueCache::Entry resolved;
+        resolved.expression = valueExpression;
+        resolved.value = value;
+        resolved.dependencies = frame.dependencies;
+        resolved.unknownSymbols = frame.unknownSymbols;
+        resolved.verifiedPass = resolutionPass_;
+
+        resolvedValues_.insert(key, resolved);
     }
 
     return value;
@@ -59,3 +144,105 @@ int IPXactSystemVerilogParser::getBaseForSymbol(QStringView symbol) const
 {
     return baseForExpression(finder_->valueForId(symbol));
 }
+
+//-----------------------------------------------------------------------------
+// Function: IPXactSystemVerilogParser::findValidValue()
+//-----------------------------------------------------------------------------
+ResolvedValueCache::Entry const* IPXactSystemVerilogParser::findValidValue(QStringView symbol,
+    QString const& key) const
+{
+    ResolvedValueCache::Entry* cached = resolvedValues_.find(key);
+    if (cached == nullptr || cached->verifiedPass == resolutionPass_)
+    {
+        return cached;
+    }
+
+    if (cached->expression != finder_->valueForId(symbol))
+    {
+        resolvedValues_.invalidate(key);
+        return nullptr;
+    }
+
+    for (QString const& name : cached->unknownSymbols)
+    {
+        if (finder_->hasId(name))
+        {
+            resolvedValues_.invalidate(key);
+            return nullptr;
+        }
+    }
+
+    // Resolving the referenced parameters invalidates this value, if any of them has changed.
+    const QStringList dependencies = cached->dependencies;
+
+    resolving_.append(ResolutionFrame{ symbol, false });
+    resolvingIds_.insert(symbol);
+
+    for (QString const& dependency : dependencies)
+    {
+        findSymbolValue(dependency);
+    }
+
+    resolvingIds_.remove(symbol);
+    resolving_.removeLast();
+
+    cached = resolvedValues_.find(key);
+    if (cached != nullptr)
+    {
+        cached->verifiedPass = resolutionPass_;
+    }
+
+    return cached;
+}
+
+//-----------------------------------------------------------------------------
+// Function: IPXactSystemVerilogParser::beginEvaluation()
+//-----------------------------------------------------------------------------
+void IPXactSystemVerilogParser::beginEvaluation() const
+{
+    if (evaluationDepth_ == 0)
+    {
+        ++resolutionPass_;
+        pruneResolvedValues();
+    }
+
+    ++evaluationDepth_;
+}
+
+//-----------------------------------------------------------------------------
+// Function: IPXactSystemVerilogParser::endEvaluation()
+//-----------------------------------------------------------------------------
+void IPXactSystemVerilogParser::endEvaluation() const
+{
+    --evaluationDepth_;
+}
+
+//-----------------------------------------------------------------------------
+// Function: IPXactSystemVerilogParser::pruneResolvedValues()
+//-----------------------------------------------------------------------------
+void IPXactSystemVerilogParser::pruneResolvedValues() const
+{
+    if (resolvedValues_.count() < pruneLimit_)
+    {
+        return;
+    }
+
+    // The values depending on a removed parameter are invalidated with it.
+    for (QString const& id : resolvedValues_.ids())
+    {
+        if (resolvedValues_.find(id) != nullptr && finder_->hasId(id) == false)
+        {
+            resolvedValues_.invalidate(id);
+        }
+    }
+
+    pruneLimit_ = qMax(MINIMUM_PRUNE_LIMIT, 2 * resolvedValues_.count());
+}
+
+//-----------------------------------------------------------------------------
+// Function: IPXactSystemVerilogParser::isIdentifier()
+//-----------------------------------------------------------------------------
+bool IPXactSystemVerilogParser::isIdentifier(QStringView name) noexcept
+{
+    return name.isEmpty() == false && (name.front().isLetter() || name.front() == QLatin1Char('_'));
+}
@@ -0,0 +1,119 @@
+//-----------------------------------------------------------------------------
+// File: ResolvedValueCache.cpp
+//-----------------------------------------------------------------------------
+// Project: Kactus2
+// Author: Kactus2 team
+// Date: 16.10.2026
+//
+// Description:
+// Cache of resolved parameter values and the dependencies between the parameters.
+//-----------------------------------------------------------------------------
+
+#include "ResolvedValueCache.h"
+
+//-----------------------------------------------------------------------------
+// Function: ResolvedValueCache::find()
+//-----------------------------------------------------------------------------
+ResolvedValueCache::Entry* ResolvedValueCache::find(QString const& id)
+{
+    auto entry = entries_.find(id);
+    if (entry == entries_.end())
+    {
+        return nullptr;
+    }
+
+    return &entry.value();
+}
+
+//-----------------------------------------------------------------------------
+// Function: ResolvedValueCache::insert()
+//-----------------------------------------------------------------------------
+void ResolvedValueCache::insert(QString const& id, Entry const& entry)
+{
+    remove(id);
+
+    entries_.insert(id, entry);
+    for (QString const& dependency : entry.dependencies)
+    {
+        dependents_[dependency].insert(id);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: ResolvedValueCache::invalidate()
+//-----------------------------------------------------------------------------
+void ResolvedValueCache::invalidate(QString const& id)
+{
+    QStringList invalidated({ id });
+    QSet<QString> visited({ id });
+
+    // The dependents are kept for the parameters without a value, so the chain continues through them.
+    for (int i = 0; i < invalidated.size(); ++i)
+    {
+        for (QString const& dependent : dependents_.value(invalidated.at(i)))
+        {
+            if (visited.contains(dependent) == false)
+            {
+                visited.insert(dependent);
+                invalidated.append(dependent);
+            }
+        }
+    }
+
+    for (QString const& invalidId : invalidated)
+    {
+        remove(invalidId);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: ResolvedValueCache::clear()
+//-----------------------------------------------------------------------------
+void ResolvedValueCache::clear()
+{
+    entries_.clear();
+    dependents_.clear();
+}
+
+//-----------------------------------------------------------------------------
+// Function: ResolvedValueCache::ids()
+//-----------------------------------------------------------------------------
+QStringList ResolvedValueCache::ids() const
+{
+    return entries_.keys();
+}
+
+//-----------------------------------------------------------------------------
+// Function: ResolvedValueCache::count()
+//-----------------------------------------------------------------------------
+int ResolvedValueCache::count() const
+{
+    return entries_.size();
+}
+
+//-----------------------------------------------------------------------------
+// Function: ResolvedValueCache::remove()
+//-----------------------------------------------------------------------------
+void ResolvedValueCache::remove(QString const& id)
+{
+    auto entry = entries_.find(id);
+    if (entry == entries_.end())
+    {
+        return;
+    }
+
+    for (QString const& dependency : entry->dependencies)
+    {
+        auto dependents = dependents_.find(dependency);
+        if (dependents != dependents_.end())
+        {
+            dependents->remove(id);
+            if (dependents->isEmpty())
+            {
+                dependents_.erase(dependents);
+            }
+        }
+    }
+
+    entries_.erase(entry);
+}
@@ -10,10 +10,15 @@
 //-----------------------------------------------------------------------------
 
 #include "SystemVerilogExpressionParser.h"
+#include "ExpressionValue.h"
 #include "SystemVerilogSyntax.h"
+#include "Tracing.h"
 
+#include <QHash>
+#include <QtNumeric>
 #include <QRegularExpression>
 #include <QMap>
+#include <QReadWriteLock>
 #include <QStringBuilder>
 #include <QStringList>
 #include <QVector>
@@ -21,6 +26,10 @@
 #include <qmath.h>
 
 #include <algorithm>
+#include <atomic>
+#include <limits>
+#include <typeindex>
+#include <typeinfo>
 
 namespace
 {
@@ -57,16 +66,583 @@ namespace
         QStringLiteral("|") % SystemVerilogSyntax::REAL_NUMBER% QStringLiteral(")\\s*$"));
 
     const QRegularExpression BASE_FORMAT(QStringLiteral("'[sS]?([dDbBoOhH]?)"));
+
+    //! The maximum number of compiled expressions kept in the cache. The cache is emptied when it is full.
+    const int MAXIMUM_CACHED_EXPRESSIONS = 4096;
+
+    //! The operations solved directly on integers.
+    enum class Operation
+    {
+        Power,
+        PowerFunction,
+        Multiply,
+        Divide,
+        Modulo,
+        Add,
+        Subtract,
+        ShiftLeft,
+        ShiftRight,
+        Greater,
+        Less,
+        Equal,
+        GreaterOrEqual,
+        LessOrEqual,
+        NotEqual,
+        LogicalOr,
+        LogicalAnd,
+        BitwiseOr,
+        BitwiseXor,
+        BitwiseAnd,
+        Negate,
+        Invert,
+        Clog2,
+        Other
+    };
+
+    //-----------------------------------------------------------------------------
+    // Function: operationOf()
+    //-----------------------------------------------------------------------------
+    Operation operationOf(QStringView token)
+    {
+        const static QHash<QString, Operation> operations =
+        {
+            { QStringLiteral("**"), Operation::Power },
+            { QStringLiteral("$pow"), Operation::PowerFunction },
+            { QStringLiteral("*"), Operation::Multiply },
+            { QStringLiteral("/"), Operation::Divide },
+            { QStringLiteral("%"), Operation::Modulo },
+            { QStringLiteral("+"), Operation::Add },
+            { QStringLiteral("-"), Operation::Subtract },
+            { QStringLiteral("<<"), Operation::ShiftLeft },
+            { QStringLiteral(">>"), Operation::ShiftRight },
+            { QStringLiteral(">"), Operation::Greater },
+            { QStringLiteral("<"), Operation::Less },
+            { QStringLiteral("=="), Operation::Equal },
+            { QStringLiteral(">="), Operation::GreaterOrEqual },
+            { QStringLiteral("<="), Operation::LessOrEqual },
+            { QStringLiteral("!="), Operation::NotEqual },
+            { QStringLiteral("||"), Operation::LogicalOr },
+            { QStringLiteral("&&"), Operation::LogicalAnd },
+            { QStringLiteral("|"), Operation::BitwiseOr },
+            { QStringLiteral("^"), Operation::BitwiseXor },
+            { QStringLiteral("&"), Operation::BitwiseAnd },
+            { QStringLiteral("`"), Operation::Negate },
+            { QStringLiteral("~"), Operation::Invert },
+            { QStringLiteral("$clog2"), Operation::Clog2 }
+        };
+
+        return operations.value(token.toString(), Operation::Other);
+    }
+
+    //-----------------------------------------------------------------------------
+    // Function: integerPower()
+    //-----------------------------------------------------------------------------
+    bool integerPower(qint64 base, qint64 exponent, qint64& result) noexcept
+    {
+        result = 1;
+        while (exponent > 0)
+        {
+            if ((exponent & 1) && qMulOverflow(result, base, &result))
+            {
+                return false;
+            }
+
+            exponent >>= 1;
+            if (exponent > 0 && qMulOverflow(base, base, &base))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------
+    // Function: solveIntegerBinary()
+    //-----------------------------------------------------------------------------
+    bool solveIntegerBinary(Operation operation, qint64 left, qint64 right, ExpressionValue& result) noexcept
+    {
+        // Results that do not fit in 64 bits are left to be solved as text.
+        qint64 value = 0;
+        bool solved = true;
+
+        switch (operation)
+        {
+        case Operation::Power:
+        case Operation::PowerFunction:
+            if (left == 0 && right < 0)
+            {
+                result = ExpressionValue();
+                return true;
+            }
+            else if (right < 0 && operation == Operation::Power)
+            {
+                value = static_cast<int>(qPow(left, right));
+            }
+            else
+            {
+                solved = right >= 0 && integerPower(left, right, value);
+            }
+            break;
+        case Operation::Multiply:
+            solved = qMulOverflow(left, right, &value) == false;
+            break;
+        case Operation::Divide:
+        case Operation::Modulo:
+            if (right == 0)
+            {
+                result = ExpressionValue();
+                return true;
+            }
+            else if (right == -1)
+            {
+                solved = operation == Operation::Modulo || left != std::numeric_limits<qint64>::min();
+                value = operation == Operation::Modulo ? 0 : -left;
+            }
+            else
+            {
+                value = operation == Operation::Divide ? left / right : left % right;
+            }
+            break;
+        case Operation::Add:
+            solved = qAddOverflow(left, right, &value) == false;
+            break;
+        case Operation::Subtract:
+            solved = qSubOverflow(left, right, &value) == false;
+            break;
+        case Operation::ShiftLeft:
+            solved = right >= 0 && right < 64;
+            value = solved ? static_cast<qint64>(static_cast<quint64>(left) << right) : 0;
+            break;
+        case Operation::ShiftRight:
+            solved = right >= 0 && right < 64;
+            value = solved ? left >> right : 0;
+            break;
+        case Operation::Greater:
+            value = left > right;
+            break;
+        case Operation::Less:
+            value = left < right;
+            break;
+        case Operation::Equal:
+            value = left == right;
+            break;
+        case Operation::GreaterOrEqual:
+            value = left >= right;
+            break;
+        case Operation::LessOrEqual:
+            value = left <= right;
+            break;
+        case Operation::NotEqual:
+            value = left != right;
+            break;
+        case Operation::LogicalOr:
+            value = left || right;
+            break;
+        case Operation::LogicalAnd:
+            value = left && right;
+            break;
+        case Operation::BitwiseOr:
+            value = left | right;
+            break;
+        case Operation::BitwiseXor:
+            value = left ^ right;
+            break;
+        case Operation::BitwiseAnd:
+            value = left & right;
+            break;
+        default:
+            value = 0;
+            break;
+        }
+
+        if (solved)
+        {
+            result = ExpressionValue::fromInteger(value);
+        }
+
+        return solved;
+    }
+
+    //-----------------------------------------------------------------------------
+    // Function: solveIntegerUnary()
+    //-----------------------------------------------------------------------------
+    bool solveIntegerUnary(Operation operation, qint64 term, ExpressionValue& result) noexcept
+    {
+        if (operation == Operation::Negate && term != std::numeric_limits<qint64>::min())
+        {
+            result = ExpressionValue::fromInteger(-term);
+            return true;
+        }
+        else if (operation == Operation::Invert)
+        {
+            result = ExpressionValue::fromInteger(~term);
+            return true;
+        }
+        else if (operation == Operation::Clog2)
+        {
+            if (term < 0)
+            {
+                result = ExpressionValue();
+                return true;
+            }
+
+            qreal quotient = term;
+            qint64 answer = 0;
+            while (quotient > 1)
+            {
+                quotient /= 2;
+                ++answer;
+            }
+
+            result = ExpressionValue::fromInteger(answer);
+            return true;
+        }
+
+        return false;
+    }
+
+    //-----------------------------------------------------------------------------
+    // Function: solveWideBinary()
+    //-----------------------------------------------------------------------------
+    bool solveWideBinary(Operation operation, WideInteger const& left, WideInteger const& right,
+        ExpressionValue& result) noexcept
+    {
+        // Results that do not fit in 128 bits are left to be solved as text.
+        WideInteger value;
+        bool solved = true;
+
+        const bool shiftInRange = right.fitsInteger() && right.toInteger() >= 0 && right.toInteger() < 128;
+        const int shift = shiftInRange ? static_cast<int>(right.toInteger()) : 0;
+        const int comparison = WideInteger::compare(left, right);
+
+        switch (operation)
+        {
+        case Operation::Power:
+        case Operation::PowerFunction:
+            if (left.isZero() && right.isNegative())
+            {
+                result = ExpressionValue();
+                return true;
+            }
+
+            solved = right.fitsInteger() && WideInteger::power(left, right.toInteger(), value);
+            break;
+        case Operation::Multiply:
+            solved = WideInteger::multiply(left, right, value);
+            break;
+        case Operation::Divide:
+        case Operation::Modulo:
+            if (right.isZero())
+            {
+                result = ExpressionValue();
+                return true;
+            }
+
+            solved = operation == Operation::Divide ? WideInteger::divide(left, right, value) :
+                WideInteger::modulo(left, right, value);
+            break;
+        case Operation::Add:
+            solved = WideInteger::add(left, right, value);
+            break;
+        case Operation::Subtract:
+            solved = WideInteger::subtract(left, right, value);
+            break;
+        case Operation::ShiftLeft:
+            // The shifted value must keep all its bits.
+            value = left.shiftedLeft(shift);
+            solved = shiftInRange && WideInteger::compare(value.shiftedRight(shift), left) == 0;
+            break;
+        case Operation::ShiftRight:
+            value = left.shiftedRight(shift);
+            solved = shiftInRange;
+            break;
+        case Operation::Greater:
+            value = WideInteger(comparison > 0);
+            break;
+        case Operation::Less:
+            value = WideInteger(comparison < 0);
+            break;
+        case Operation::Equal:
+            value = WideInteger(comparison == 0);
+            break;
+        case Operation::GreaterOrEqual:
+            value = WideInteger(comparison >= 0);
+            break;
+        case Operation::LessOrEqual:
+            value = WideInteger(comparison <= 0);
+            break;
+        case Operation::NotEqual:
+            value = WideInteger(comparison != 0);
+            break;
+        case Operation::LogicalOr:
+            value = WideInteger(left.isZero() == false || right.isZero() == false);
+            break;
+        case Operation::LogicalAnd:
+            value = WideInteger(left.isZero() == false && right.isZero() == false);
+            break;
+        case Operation::BitwiseOr:
+            value = left | right;
+            break;
+        case Operation::BitwiseXor:
+            value = left ^ right;
+            break;
+        case Operation::BitwiseAnd:
+            value = left & right;
+            break;
+        default:
+            solved = false;
+            break;
+        }
+
+        if (solved)
+        {
+            result = ExpressionValue::fromWide(value);
+        }
+
+        return solved;
+    }
+
+    //-----------------------------------------------------------------------------
+    // Function: solveWideUnary()
+    //-----------------------------------------------------------------------------
+    bool solveWideUnary(Operation operation, WideInteger const& term, ExpressionValue& result) noexcept
+    {
+        WideInteger value;
+        if (operation == Operation::Negate && WideInteger::negate(term, value))
+        {
+            result = ExpressionValue::fromWide(value);
+            return true;
+        }
+        else if (operation == Operation::Invert)
+        {
+            result = ExpressionValue::fromWide(~term);
+            return true;
+        }
+        else if (operation == Operation::Clog2)
+        {
+            if (term.isNegative())
+            {
+                result = ExpressionValue();
+                return true;
+            }
+
+            // The bits needed for the values below the term.
+            WideInteger largest;
+            WideInteger::subtract(term, WideInteger(1), largest);
+            result = ExpressionValue::fromInteger(term.isZero() ? 0 : largest.bitLength());
+            return true;
+        }
+
+        return false;
+    }
+
+    //-----------------------------------------------------------------------------
+    // Function: solveRealBinary()
+    //-----------------------------------------------------------------------------
+    bool solveRealBinary(Operation operation, ExpressionValue const& left, ExpressionValue const& right,
+        ExpressionValue& result) noexcept
+    {
+        // Solved as in SystemVerilogExpressionParser::solveBinary(), but without forming the text of the terms.
+        // The operations not defined for reals are left to it.
+        const double leftOperand = left.toDouble();
+        const double rightOperand = right.toDouble();
+        double value = 0;
+
+        switch (operation)
+        {
+        case Operation::Power:
+        case Operation::PowerFunction:
+            if (leftOperand == 0 && rightOperand < 0)
+            {
+                result = ExpressionValue();
+                return true;
+            }
+
+            value = qPow(leftOperand, rightOperand);
+            break;
+        case Operation::Multiply:
+            value = leftOperand * rightOperand;
+            break;
+        case Operation::Divide:
+            if (rightOperand == 0)
+            {
+                result = ExpressionValue();
+                return true;
+            }
+
+            value = leftOperand / rightOperand;
+            break;
+        case Operation::Add:
+            value = leftOperand + rightOperand;
+            break;
+        case Operation::Subtract:
+            value = leftOperand - rightOperand;
+            break;
+        case Operation::Greater:
+        case Operation::Less:
+        case Operation::Equal:
+        case Operation::GreaterOrEqual:
+        case Operation::LessOrEqual:
+        case Operation::NotEqual:
+            if ((operation == Operation::Greater && leftOperand > rightOperand) ||
+                (operation == Operation::Less && leftOperand < rightOperand) ||
+                (operation == Operation::Equal && leftOperand == rightOperand) ||
+                (operation == Operation::GreaterOrEqual && leftOperand >= rightOperand) ||
+                (operation == Operation::LessOrEqual && leftOperand <= rightOperand) ||
+                (operation == Operation::NotEqual && leftOperand != rightOperand))
+            {
+                result = ExpressionValue::fromInteger(1);
+                return true;
+            }
+            break;
+        default:
+            return false;
+        }
+
+        // An integer divided by a real or raised to a negative power is truncated, as in the textual solving.
+        if (left.isReal() == false && (operation == Operation::Divide ||
+            (operation == Operation::Power && rightOperand < 0)))
+        {
+            result = ExpressionValue::fromInteger(static_cast<int>(value));
+        }
+        else
+        {
+            result = ExpressionValue::fromReal(value, qMax(left.precision(), right.precision()));
+        }
+
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------
+    // Function: solveNumberBinary()
+    //-----------------------------------------------------------------------------
+    bool solveNumberBinary(Operation operation, ExpressionValue const& left, ExpressionValue const& right,
+        ExpressionValue& result) noexcept
+    {
+        if (left.isInteger() && right.isInteger() &&
+            solveIntegerBinary(operation, left.integer(), right.integer(), result))
+        {
+            return true;
+        }
+        else if (left.isIntegral() && right.isIntegral())
+        {
+            return solveWideBinary(operation, left.wide(), right.wide(), result);
+        }
+        else if (left.isNumber() && right.isNumber())
+        {
+            return solveRealBinary(operation, left, right, result);
+        }
+
+        return false;
+    }
+
+    //-----------------------------------------------------------------------------
+    // Function: solveNumberUnary()
+    //-----------------------------------------------------------------------------
+    bool solveNumberUnary(Operation operation, ExpressionValue const& term, ExpressionValue& result) noexcept
+    {
+        if (term.isInteger() && solveIntegerUnary(operation, term.integer(), result))
+        {
+            return true;
+        }
+        else if (term.isIntegral())
+        {
+            return solveWideUnary(operation, term.wide(), result);
+        }
+        else if (term.isReal() && operation == Operation::Negate)
+        {
+            result = ExpressionValue::fromReal(-term.toDouble(), term.precision());
+            return true;
+        }
+
+        return false;
+    }
 }
 
+//-----------------------------------------------------------------------------
+//! An expression compiled for evaluation.
+//!
+//! The tokens are in RPN and classified by the parser class that compiled the expression. Only the symbols are
+//! left to be resolved at evaluation, since their values may change.
+//-----------------------------------------------------------------------------
+struct SystemVerilogExpressionParser::CompiledExpression
+{
+    //! The kinds of the tokens.
+    enum class TokenKind
+    {
+        UnaryOperator,      //!< Operator taking one term.
+        BinaryOperator,     //!< Operator taking two terms.
+        TernaryCondition,   //!< The condition part of a ternary operation, e.g. '?'.
+        TernaryOperator,    //!< Operator selecting between the two terms by the condition, i.e. ':'.
+        CloseArray,         //!< End of an array collecting the terms after the start of the array.
+        Value,              //!< Token with a value known at compile time.
+        Operand             //!< Symbol or constant, resolved at evaluation.
+    };
+
+    //! A classified token.
+    struct Token
+    {
+        TokenKind kind = TokenKind::Value;          //!< The kind of the token.
+        QStringView text;                           //!< The token in the expression.
+        ExpressionValue value;                      //!< The value of the token, if it is a constant.
+        Operation operation = Operation::Other;     //!< The operation of an operator token.
+        int literalBase = -1;                       //!< The base of a numeric literal, -1 for other tokens.
+    };
+
+    QString expression;         //!< The compiled expression, which the key in the cache refers to.
+    QString rewritten;          //!< The expression with unary operators marked, which the tokens refer to.
+    QVector<Token> tokens;      //!< The tokens in RPN.
+};
+
+//-----------------------------------------------------------------------------
+//! The cache of compiled expressions shared by all parsers.
+//-----------------------------------------------------------------------------
+struct SystemVerilogExpressionParser::ExpressionCache
+{
+    //! Key for finding a compiled expression.
+    struct Key
+    {
+        QStringView expression;     //!< The expression text.
+        std::type_index grammar;    //!< The parser class that compiled the expression.
+
+        bool operator==(Key const& other) const
+        {
+            return grammar == other.grammar && expression == other.expression;
+        }
+
+        friend size_t qHash(Key const& key, size_t seed) noexcept
+        {
+            return qHashMulti(seed, key.expression, key.grammar.hash_code());
+        }
+    };
+
+    //! The constructor. Adds the statistics to the traces.
+    ExpressionCache()
+    {
+        Tracing::addCounters("SystemVerilogExpressionParser::expressionCache", []()
+            {
+                const auto statistics = cacheStatistics();
+                return Tracing::Counters({ { QStringLiteral("hits"), statistics.hits },
+                    { QStringLiteral("misses"), statistics.misses },
+                    { QStringLiteral("size"), statistics.size } });
+            });
+    }
+
+    QReadWriteLock lock;                                                //!< Guards the expressions.
+    QHash<Key, QSharedPointer<CompiledExpression const> > expressions;  //!< The compiled expressions.
+    std::atomic<qint64> hits{ 0 };                                      //!< The number of cache hits.
+    std::atomic<qint64> misses{ 0 };                                    //!< The number of cache misses.
+};
+
 //-----------------------------------------------------------------------------
 // Function: SystemVerilogExpressionParser::parseExpression()
 //-----------------------------------------------------------------------------
 QString SystemVerilogExpressionParser::parseExpression(QStringView expression, bool* validExpression) const
 {
-    // Copy of expression needs to be created for replacing unary minuses with special character.
-    QString expressionCopy = expression.toString();
-    return solveRPN(convertToRPN(expressionCopy), validExpression);
+    // The program is held for the evaluation, since the tokens passed on refer to it.
+    const auto program = compiledExpression(expression);
+    return solveRPN(*program, validExpression);
 }
 
 //-----------------------------------------------------------------------------
@@ -89,24 +665,201 @@ bool SystemVerilogExpressionParser::isPlainValue(QStringView expression) const
 // Function: SystemVerilogExpressionParser::baseForExpression()
 //-----------------------------------------------------------------------------
 int SystemVerilogExpressionParser::baseForExpression(QStringView expression) const
+{
+    const auto program = compiledExpression(expression);
+    return commonBase(*program);
+}
+
+//-----------------------------------------------------------------------------
+// Function: SystemVerilogExpressionParser::parseExpressionWithBase()
+//-----------------------------------------------------------------------------
+QString SystemVerilogExpressionParser::parseExpressionWithBase(QStringView expression, bool* validExpression,
+    int* base) const
+{
+    const auto program = compiledExpression(expression);
+    QString value = solveRPN(*program, validExpression);
+    if (base != nullptr)
+    {
+        *base = commonBase(*program);
+    }
+
+    return value;
+}
+
+//-----------------------------------------------------------------------------
+// Function: SystemVerilogExpressionParser::commonBase()
+//-----------------------------------------------------------------------------
+int SystemVerilogExpressionParser::commonBase(CompiledExpression const& program) const
 {
     int greatestBase = 0;
-    QString asStr = expression.toString();
-    for (auto const& token : convertToRPN(asStr))
+    for (auto const& token : program.tokens)
     {
-        if (isLiteral(token))
+        if (token.literalBase != -1)
         {
-            greatestBase = qMax(greatestBase, baseOf(token));
+            greatestBase = qMax(greatestBase, token.literalBase);
         }
-        else if (isSymbol(token))
+        else if (isSymbol(token.text))
         {
-            greatestBase = qMax(greatestBase, getBaseForSymbol(token));
+            greatestBase = qMax(greatestBase, getBaseForSymbol(token.text));
         }
     }
 
     return greatestBase;
 }
 
+//-----------------------------------------------------------------------------
+// Function: SystemVerilogExpressionParser::cacheStatistics()
+//-----------------------------------------------------------------------------
+SystemVerilogExpressionParser::CacheStatistics SystemVerilogExpressionParser::cacheStatistics()
+{
+    ExpressionCache& cache = expressionCache();
+
+    CacheStatistics statistics;
+    statistics.hits = cache.hits.load();
+    statistics.misses = cache.misses.load();
+
+    QReadLocker locker(&cache.lock);
+    statistics.size = cache.expressions.size();
+
+    return statistics;
+}
+
+//-----------------------------------------------------------------------------
+// Function: SystemVerilogExpressionParser::clearCache()
+//-----------------------------------------------------------------------------
+void SystemVerilogExpressionParser::clearCache()
+{
+    ExpressionCache& cache = expressionCache();
+
+    QWriteLocker locker(&cache.lock);
+    cache.expressions.clear();
+    cache.hits.store(0);
+    cache.misses.store(0);
+}
+
+//-----------------------------------------------------------------------------
+// Function: SystemVerilogExpressionParser::expressionCache()
+//-----------------------------------------------------------------------------
+SystemVerilogExpressionParser::ExpressionCache& SystemVerilogExpressionParser::expressionCache()
+{
+    static ExpressionCache cache;
+    return cache;
+}
+
+//-----------------------------------------------------------------------------
+// Function: SystemVerilogExpressionParser::compiledExpression()
+//-----------------------------------------------------------------------------
+QSharedPointer<SystemVerilogExpressionParser::CompiledExpression const>
+    SystemVerilogExpressionParser::compiledExpression(QStringView expression) const
+{
+    ExpressionCache& cache = expressionCache();
+    const std::type_index grammar(typeid(*this));
+
+    {
+        QReadLocker locker(&cache.lock);
+        if (auto cached = cache.expressions.constFind(ExpressionCache::Key{ expression, grammar });
+            cached != cache.expressions.cend())
+        {
+            ++cache.hits;
+            return cached.value();
+        }
+    }
+
+    // Compiling is done without the lock, so other threads can evaluate their expressions meanwhile.
+    auto program = compile(expression);
+    ++cache.misses;
+
+    QWriteLocker locker(&cache.lock);
+    if (auto cached = cache.expressions.constFind(ExpressionCache::Key{ expression, grammar });
+        cached != cache.expressions.cend())
+    {
+        return cached.value();
+    }
+
+    if (cache.expressions.size() >= MAXIMUM_CACHED_EXPRESSIONS)
+    {
+        cache.expressions.clear();
+    }
+
+    // The key must refer to the text kept in the program, not to the text of the caller.
+    cache.expressions.insert(ExpressionCache::Key{ program->expression, grammar }, program);
+    return program;
+}
+
+//-----------------------------------------------------------------------------
+// Function: SystemVerilogExpressionParser::compile()
+//-----------------------------------------------------------------------------
+QSharedPointer<SystemVerilogExpressionParser::CompiledExpression const>
+    SystemVerilogExpressionParser::compile(QStringView expression) const
+{
+    using TokenKind = CompiledExpression::TokenKind;
+
+    auto program = QSharedPointer<CompiledExpression>::create();
+    program->expression = expression.toString();
+
+    // Copy of expression needs to be created for replacing unary minuses with special character.
+    program->rewritten = program->expression;
+    const auto rpn = convertToRPN(program->rewritten);
+
+    program->tokens.reserve(rpn.size());
+    for (auto const& token : rpn)
+    {
+        CompiledExpression::Token compiled;
+        compiled.text = token;
+
+        if (isLiteral(token))
+        {
+            compiled.literalBase = baseOf(token);
+        }
+
+        if (isUnaryOperator(token))
+        {
+            compiled.kind = TokenKind::UnaryOperator;
+            compiled.operation = operationOf(token);
+        }
+        else if (isBinaryOperator(token))
+        {
+            compiled.kind = TokenKind::BinaryOperator;
+            compiled.operation = operationOf(token);
+        }
+        else if (isTernaryOperator(token))
+        {
+            compiled.kind = token.compare(TERNARY_COLON_STRING) == 0 ? 
+                TokenKind::TernaryOperator : TokenKind::TernaryCondition;
+        }
+        else if (token.compare(OPEN_ARRAY_STRING) == 0)
+        {
+            compiled.value = ExpressionValue::fromText(token.toString());
+        }
+        else if (token.compare(CLOSE_ARRAY_STRING) == 0)
+        {
+            compiled.kind = TokenKind::CloseArray;
+        }
+        else if (token.compare(QLatin1String("true"), Qt::CaseInsensitive) == 0)
+        {
+            compiled.value = ExpressionValue::fromInteger(1);
+        }
+        else if (token.compare(QLatin1String("false"), Qt::CaseInsensitive) == 0)
+        {
+            compiled.value = ExpressionValue::fromInteger(0);
+        }
+        else if (isStringLiteral(token))
+        {
+            compiled.value = ExpressionValue::fromText(token.toString());
+        }
+        else
+        {
+            // The token may also be a symbol, which is known only at evaluation.
+            compiled.kind = TokenKind::Operand;
+            compiled.value = ExpressionValue::fromText(parseConstant(token));
+        }
+
+        program->tokens.append(compiled);
+    }
+
+    return program;
+}
+
 //-----------------------------------------------------------------------------
 // Function: SystemVerilogExpressionParser::convertToRPN()
 //-----------------------------------------------------------------------------
@@ -265,15 +1018,23 @@ QVector<QStringView> SystemVerilogExpressionParser::convertToRPN(QString& expres
 //-----------------------------------------------------------------------------
 // Function: SystemVerilogExpressionParser::solveRPN()
 //-----------------------------------------------------------------------------
-QString SystemVerilogExpressionParser::solveRPN(QVector<QStringView> rpn, bool* validExpression) const
+QString SystemVerilogExpressionParser::solveRPN(CompiledExpression const& program, bool* validExpression) const
 {
-    QStringList result;
+    using TokenKind = CompiledExpression::TokenKind;
+
+    // Numbers are calculated as such and the other values as text, as they are formatted by the operations.
+    QVector<ExpressionValue> result;
+    result.reserve(program.tokens.size());
+
     bool isWellFormed = true;
     int ternaryCount = 0;
 
-    for (auto const& token : rpn)
+    for (auto const& compiled : program.tokens)
     {
-        if (isUnaryOperator(token))
+        const auto token = compiled.text;
+        const auto kind = compiled.kind;
+
+        if (kind == TokenKind::UnaryOperator)
         {
             if (result.isEmpty())
             {
@@ -281,10 +1042,17 @@ QString SystemVerilogExpressionParser::solveRPN(QVector<QStringView> rpn, bool*
             }
             else
             {
-                result.append(solveUnary(token, result.takeLast()));
+                ExpressionValue term = result.takeLast();
+                ExpressionValue solved;
+                if (solveNumberUnary(compiled.operation, term, solved) == false)
+                {
+                    solved = ExpressionValue::fromText(solveUnary(token, term.toString()));
+                }
+
+                result.append(solved);
             }
         }
-        else if (isBinaryOperator(token))
+        else if (kind == TokenKind::BinaryOperator)
         {
             if (result.size() < 2)
             {
@@ -292,39 +1060,46 @@ QString SystemVerilogExpressionParser::solveRPN(QVector<QStringView> rpn, bool*
             }
             else
             {
-                result.append(solveBinary(token, result.takeLast(), result.takeLast()));
+                ExpressionValue rightTerm = result.takeLast();
+                ExpressionValue leftTerm = result.takeLast();
+
+                ExpressionValue solved;
+                if (solveNumberBinary(compiled.operation, leftTerm, rightTerm, solved) == false)
+                {
+                    solved = ExpressionValue::fromText(
+                        solveBinary(token, leftTerm.toString(), rightTerm.toString()));
+                }
+
+                result.append(solved);
             }
         }
-        else if (isTernaryOperator(token))
+        else if (kind == TokenKind::TernaryOperator)
         {
-            if (token.compare(TERNARY_COLON_STRING) == 0)
-            {
-                ++ternaryCount;
+            ++ternaryCount;
 
-                if (result.size() < 3)
-                {
-                    isWellFormed = false;
-                }
-                else
-                {
-                    result.append(solveTernary(result.takeLast(), result.takeLast(), result.takeLast()));
-                }
+            if (result.size() < 3)
+            {
+                isWellFormed = false;
             }
             else
             {
-                --ternaryCount;
+                ExpressionValue falseCase = result.takeLast();
+                ExpressionValue trueCase = result.takeLast();
+                ExpressionValue condition = result.takeLast();
+
+                result.append(condition.toDouble() != 0 ? trueCase : falseCase);
             }
         }
-        else if (token.compare(OPEN_ARRAY_STRING) == 0)
+        else if (kind == TokenKind::TernaryCondition)
         {
-            result.append(token.toString());
+            --ternaryCount;
         }
-        else if (token.compare(CLOSE_ARRAY_STRING) == 0)
+        else if (kind == TokenKind::CloseArray)
         {
             QStringList items;
-            while (result.isEmpty() == false && result.last().compare(OPEN_ARRAY_STRING) != 0)
+            while (result.isEmpty() == false && result.last().isText(OPEN_ARRAY_STRING) == false)
             {
-                items.prepend(result.takeLast());
+                items.prepend(result.takeLast().toString());
             }
 
             if (result.isEmpty())
@@ -333,36 +1108,27 @@ QString SystemVerilogExpressionParser::solveRPN(QVector<QStringView> rpn, bool*
             }
             else
             {
-                QString arrayItem(result.takeLast() % items.join(QLatin1Char(',')) % token);
-                result.append(arrayItem);
+                QString arrayItem(result.takeLast().toString() % items.join(QLatin1Char(',')) % token);
+                result.append(ExpressionValue::fromText(arrayItem));
             }
         }
-        else if (token.compare(QLatin1String("true"), Qt::CaseInsensitive) == 0)
+        else if (kind == TokenKind::Value)
         {
-            result.append(QStringLiteral("1"));
+            result.append(compiled.value);
         }
-        else if (token.compare(QLatin1String("false"), Qt::CaseInsensitive) == 0)
+        else if (compiled.literalBase == -1 && isSymbol(token))
         {
-            result.append(QStringLiteral("0"));
-        }
-        else if (isStringLiteral(token))
-        {
-            result.append(token.toString());
-        }
-        else if (isSymbol(token))
-        {
-            result.append(findSymbolValue(token));
+            // Numeric literals cannot be symbols, so the finder is asked only for the other operands.
+            result.append(ExpressionValue::fromText(findSymbolValue(token)));
         }
         else
         {
-            const auto constant = parseConstant(token);
-
-            if (constant == QLatin1String("x"))
+            if (compiled.value.isUnknown())
             {
                 isWellFormed = false;
             }
 
-            result.append(constant);
+            result.append(compiled.value);
         }
 
         if (isWellFormed == false)
@@ -373,10 +1139,25 @@ QString SystemVerilogExpressionParser::solveRPN(QVector<QStringView> rpn, bool*
 
     if (validExpression != nullptr)
     {
-        *validExpression = (isWellFormed && result.contains(QLatin1String("x")) == false && ternaryCount == 0);
+        const bool hasUnknown = std::any_of(result.cbegin(), result.cend(),
+            [](ExpressionValue const& value) { return value.isUnknown(); });
+
+        *validExpression = (isWellFormed && hasUnknown == false && ternaryCount == 0);
     }
 
-    return result.join(QString());
+    // Strings are formed only for the final result.
+    if (result.size() == 1)
+    {
+        return result.first().toString();
+    }
+
+    QString joined;
+    for (auto const& value : result)
+    {
+        joined.append(value.toString());
+    }
+
+    return joined;
 }
 
 //-----------------------------------------------------------------------------
@@ -421,22 +1202,6 @@ bool SystemVerilogExpressionParser::isTernaryOperator(QStringView token) const
     return TERNARY_OPERATOR.match(token).hasMatch();
 }
 
-//-----------------------------------------------------------------------------
-// Function: SystemVerilogExpressionParser::solveTernary()
-//-----------------------------------------------------------------------------
-QString SystemVerilogExpressionParser::solveTernary(QStringView condition,
-    QString const& trueCase, QString const& falseCase) const
-{
-    if (condition.toDouble() != 0)
-    {
-        return trueCase;
-    }
-    else
-    {
-        return falseCase;
-    }
-}
-
 //-----------------------------------------------------------------------------
 // Function: SystemVerilogExpressionParser::solveBinary()
 //-----------------------------------------------------------------------------
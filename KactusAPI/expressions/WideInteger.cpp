@@ -0,0 +1,475 @@
+//-----------------------------------------------------------------------------
+// File: WideInteger.cpp
+//-----------------------------------------------------------------------------
+// Project: Kactus2
+// Author: Kactus2 team
+// Date: 16.10.2026
+//
+// Description:
+// Signed 128-bit integer for expression results that do not fit in 64 bits.
+//-----------------------------------------------------------------------------
+
+#include "WideInteger.h"
+
+namespace
+{
+    //! The sign bit of the high half.
+    constexpr quint64 SIGN_BIT = Q_UINT64_C(0x8000000000000000);
+
+    //-----------------------------------------------------------------------------
+    // Function: multiplyHalves()
+    //-----------------------------------------------------------------------------
+    void multiplyHalves(quint64 left, quint64 right, quint64& high, quint64& low) noexcept
+    {
+        // The full 128-bit product of two 64-bit values from four 32-bit products.
+        const quint64 leftLow = left & 0xFFFFFFFFu;
+        const quint64 leftHigh = left >> 32;
+        const quint64 rightLow = right & 0xFFFFFFFFu;
+        const quint64 rightHigh = right >> 32;
+
+        const quint64 lowLow = leftLow * rightLow;
+        const quint64 lowHigh = leftLow * rightHigh;
+        const quint64 highLow = leftHigh * rightLow;
+        const quint64 highHigh = leftHigh * rightHigh;
+
+        const quint64 middle = (lowLow >> 32) + (lowHigh & 0xFFFFFFFFu) + (highLow & 0xFFFFFFFFu);
+
+        low = (middle << 32) | (lowLow & 0xFFFFFFFFu);
+        high = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: WideInteger::WideInteger()
+//-----------------------------------------------------------------------------
+WideInteger::WideInteger(qint64 value) noexcept :
+high_(value < 0 ? ~Q_UINT64_C(0) : 0),
+low_(static_cast<quint64>(value))
+{
+
+}
+
+//-----------------------------------------------------------------------------
+// Function: WideInteger::fromDecimal()
+//-----------------------------------------------------------------------------
+bool WideInteger::fromDecimal(QStringView text, WideInteger& result) noexcept
+{
+    const bool negative = text.startsWith(QLatin1Char('-'));
+    const QStringView digits = text.mid(negative ? 1 : 0);
+    if (digits.isEmpty())
+    {
+        return false;
+    }
+
+    const WideInteger ten(10);
+    WideInteger magnitude;
+    for (QChar const& digit : digits)
+    {
+        if (digit < QLatin1Char('0') || digit > QLatin1Char('9'))
+        {
+            return false;
+        }
+
+        // The magnitude is accumulated as a positive value, which leaves out only the smallest value.
+        if (multiply(magnitude, ten, magnitude) == false ||
+            add(magnitude, WideInteger(digit.unicode() - '0'), magnitude) == false)
+        {
+            return false;
+        }
+    }
+
+    if (negative)
+    {
+        return negate(magnitude, result);
+    }
+
+    result = magnitude;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Function: WideInteger::fitsInteger()
+//-----------------------------------------------------------------------------
+bool WideInteger::fitsInteger() const noexcept
+{
+    // The high half must be the sign extension of the low half.
+    return high_ == (static_cast<qint64>(low_) < 0 ? ~Q_UINT64_C(0) : 0);
+}
+
+//-----------------------------------------------------------------------------
+// Function: WideInteger::toDouble()
+//-----------------------------------------------------------------------------
+double WideInteger::toDouble() const noexcept
+{
+    const WideInteger absolute = magnitude();
+    const double value = static_cast<double>(absolute.high_) * 18446744073709551616.0 +
+        static_cast<double>(absolute.low_);
+
+    return isNegative() ? -value : value;
+}
+
+//-----------------------------------------------------------------------------
+// Function: WideInteger::toString()
+//-----------------------------------------------------------------------------
+QString WideInteger::toString() const
+{
+    if (fitsInteger())
+    {
+        return QString::number(toInteger());
+    }
+
+    // The magnitude is printed in groups of 18 digits, which fit in a 64-bit integer.
+    const WideInteger groupSize(Q_INT64_C(1000000000000000000));
+
+    QString digits;
+    WideInteger remaining = magnitude();
+    while (remaining.isZero() == false)
+    {
+        WideInteger group;
+        divideUnsigned(remaining, groupSize, remaining, group);
+
+        QString groupDigits = QString::number(group.low_);
+        if (remaining.isZero() == false)
+        {
+            groupDigits = groupDigits.rightJustified(18, QLatin1Char('0'));
+        }
+
+        digits.prepend(groupDigits);
+    }
+
+    if (isNegative())
+    {
+        digits.prepend(QLatin1Char('-'));
+    }
+
+    return digits;
+}
+
+//-----------------------------------------------------------------------------
+// Function: WideInteger::compare()
+//-----------------------------------------------------------------------------
+int WideInteger::compare(WideInteger const& left, WideInteger const& right) noexcept
+{
+    if (left.high_ != right.high_)
+    {
+        return static_cast<qint64>(left.high_) < static_cast<qint64>(right.high_) ? -1 : 1;
+    }
+
+    if (left.low_ != right.low_)
+    {
+        return left.low_ < right.low_ ? -1 : 1;
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+// Function: WideInteger::add()
+//-----------------------------------------------------------------------------
+bool WideInteger::add(WideInteger const& left, WideInteger const& right, WideInteger& result) noexcept
+{
+    const quint64 low = left.low_ + right.low_;
+    const quint64 high = left.high_ + right.high_ + (low < left.low_ ? 1 : 0);
+
+    // Overflow turns the sign of the sum of two values with the same sign.
+    if (((left.high_ ^ right.high_) & SIGN_BIT) == 0 && ((high ^ left.high_) & SIGN_BIT) != 0)
+    {
+        return false;
+    }
+
+    result = WideInteger(high, low);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Function: WideInteger::subtract()
+//-----------------------------------------------------------------------------
+bool WideInteger::subtract(WideInteger const& left, WideInteger const& right, WideInteger& result) noexcept
+{
+    const quint64 low = left.low_ - right.low_;
+    const quint64 high = left.high_ - right.high_ - (left.low_ < right.low_ ? 1 : 0);
+
+    // Overflow turns the sign of the difference of two values with different signs.
+    if (((left.high_ ^ right.high_) & SIGN_BIT) != 0 && ((high ^ left.high_) & SIGN_BIT) != 0)
+    {
+        return false;
+    }
+
+    result = WideInteger(high, low);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Function: WideInteger::multiply()
+//-----------------------------------------------------------------------------
+bool WideInteger::multiply(WideInteger const& left, WideInteger const& right, WideInteger& result) noexcept
+{
+    const WideInteger leftMagnitude = left.magnitude();
+    const WideInteger rightMagnitude = right.magnitude();
+
+    // Both high halves set always overflow.
+    if (leftMagnitude.high_ != 0 && rightMagnitude.high_ != 0)
+    {
+        return false;
+    }
+
+    quint64 high = 0;
+    quint64 low = 0;
+    multiplyHalves(leftMagnitude.low_, rightMagnitude.low_, high, low);
+
+    quint64 crossHigh = 0;
+    quint64 crossLow = 0;
+    if (leftMagnitude.high_ != 0)
+    {
+        multiplyHalves(leftMagnitude.high_, rightMagnitude.low_, crossHigh, crossLow);
+    }
+    else
+    {
+        multiplyHalves(leftMagnitude.low_, rightMagnitude.high_, crossHigh, crossLow);
+    }
+
+    if (crossHigh != 0 || high + crossLow < high)
+    {
+        return false;
+    }
+
+    return withSign(WideInteger(high + crossLow, low), left.isNegative() != right.isNegative(), result);
+}
+
+//-----------------------------------------------------------------------------
+// Function: WideInteger::divide()
+//-----------------------------------------------------------------------------
+bool WideInteger::divide(WideInteger const& left, WideInteger const& right, WideInteger& result) noexcept
+{
+    if (right.isZero())
+    {
+        return false;
+    }
+
+    // The quotient is truncated toward zero.
+    WideInteger quotient;
+    WideInteger remainder;
+    divideUnsigned(left.magnitude(), right.magnitude(), quotient, remainder);
+
+    return withSign(quotient, left.isNegative() != right.isNegative(), result);
+}
+
+//-----------------------------------------------------------------------------
+// Function: WideInteger::modulo()
+//-----------------------------------------------------------------------------
+bool WideInteger::modulo(WideInteger const& left, WideInteger const& right, WideInteger& result) noexcept
+{
+    if (right.isZero())
+    {
+        return false;
+    }
+
+    // The remainder has the sign of the dividend.
+    WideInteger quotient;
+    WideInteger remainder;
+    divideUnsigned(left.magnitude(), right.magnitude(), quotient, remainder);
+
+    return withSign(remainder, left.isNegative(), result);
+}
+
+//-----------------------------------------------------------------------------
+// Function: WideInteger::power()
+//-----------------------------------------------------------------------------
+bool WideInteger::power(WideInteger const& base, qint64 exponent, WideInteger& result) noexcept
+{
+    if (exponent < 0)
+    {
+        return false;
+    }
+
+    WideInteger value(1);
+    WideInteger square = base;
+    while (exponent > 0)
+    {
+        if ((exponent & 1) && multiply(value, square, value) == false)
+        {
+            return false;
+        }
+
+        exponent >>= 1;
+        if (exponent > 0 && multiply(square, square, square) == false)
+        {
+            return false;
+        }
+    }
+
+    result = value;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Function: WideInteger::negate()
+//-----------------------------------------------------------------------------
+bool WideInteger::negate(WideInteger const& value, WideInteger& result) noexcept
+{
+    return subtract(WideInteger(), value, result);
+}
+
+//-----------------------------------------------------------------------------
+// Function: WideInteger::shiftedLeft()
+//-----------------------------------------------------------------------------
+WideInteger WideInteger::shiftedLeft(int count) const noexcept
+{
+    if (count <= 0)
+    {
+        return *this;
+    }
+    else if (count >= 64)
+    {
+        return WideInteger(low_ << (count - 64), 0);
+    }
+
+    return WideInteger((high_ << count) | (low_ >> (64 - count)), low_ << count);
+}
+
+//-----------------------------------------------------------------------------
+// Function: WideInteger::shiftedRight()
+//-----------------------------------------------------------------------------
+WideInteger WideInteger::shiftedRight(int count) const noexcept
+{
+    const quint64 signFill = isNegative() ? ~Q_UINT64_C(0) : 0;
+
+    if (count <= 0)
+    {
+        return *this;
+    }
+    else if (count >= 64)
+    {
+        return WideInteger(signFill, static_cast<quint64>(static_cast<qint64>(high_) >> (count - 64)));
+    }
+
+    return WideInteger(static_cast<quint64>(static_cast<qint64>(high_) >> count),
+        (low_ >> count) | (high_ << (64 - count)));
+}
+
+//-----------------------------------------------------------------------------
+// Function: WideInteger::bitLength()
+//-----------------------------------------------------------------------------
+int WideInteger::bitLength() const noexcept
+{
+    int length = 0;
+    for (quint64 bits = high_ != 0 ? high_ : low_; bits != 0; bits >>= 1)
+    {
+        ++length;
+    }
+
+    return high_ != 0 ? length + 64 : length;
+}
+
+//-----------------------------------------------------------------------------
+// Function: WideInteger::operator~()
+//-----------------------------------------------------------------------------
+WideInteger WideInteger::operator~() const noexcept
+{
+    return WideInteger(~high_, ~low_);
+}
+
+//-----------------------------------------------------------------------------
+// Function: WideInteger::operator&()
+//-----------------------------------------------------------------------------
+WideInteger WideInteger::operator&(WideInteger const& other) const noexcept
+{
+    return WideInteger(high_ & other.high_, low_ & other.low_);
+}
+
+//-----------------------------------------------------------------------------
+// Function: WideInteger::operator|()
+//-----------------------------------------------------------------------------
+WideInteger WideInteger::operator|(WideInteger const& other) const noexcept
+{
+    return WideInteger(high_ | other.high_, low_ | other.low_);
+}
+
+//-----------------------------------------------------------------------------
+// Function: WideInteger::operator^()
+//-----------------------------------------------------------------------------
+WideInteger WideInteger::operator^(WideInteger const& other) const noexcept
+{
+    return WideInteger(high_ ^ other.high_, low_ ^ other.low_);
+}
+
+//-----------------------------------------------------------------------------
+// Function: WideInteger::magnitude()
+//-----------------------------------------------------------------------------
+WideInteger WideInteger::magnitude() const noexcept
+{
+    if (isNegative() == false)
+    {
+        return *this;
+    }
+
+    // Two's complement, wrapping the smallest value to 2^127 as an unsigned value.
+    const quint64 low = ~low_ + 1;
+    return WideInteger(~high_ + (low == 0 ? 1 : 0), low);
+}
+
+//-----------------------------------------------------------------------------
+// Function: WideInteger::divideUnsigned()
+//-----------------------------------------------------------------------------
+void WideInteger::divideUnsigned(WideInteger const& dividend, WideInteger const& divisor, WideInteger& quotient,
+    WideInteger& remainder) noexcept
+{
+    // Both values are unsigned here, so the comparisons are made on the halves as unsigned values.
+    auto notLess = [](WideInteger const& left, WideInteger const& right)
+    {
+        return left.high_ != right.high_ ? left.high_ > right.high_ : left.low_ >= right.low_;
+    };
+
+    WideInteger result;
+    WideInteger rest;
+    for (int bit = 127; bit >= 0; --bit)
+    {
+        const quint64 dividendBit = bit >= 64 ? (dividend.high_ >> (bit - 64)) & 1 : (dividend.low_ >> bit) & 1;
+        rest = WideInteger((rest.high_ << 1) | (rest.low_ >> 63), (rest.low_ << 1) | dividendBit);
+
+        if (notLess(rest, divisor))
+        {
+            const quint64 low = rest.low_ - divisor.low_;
+            rest = WideInteger(rest.high_ - divisor.high_ - (rest.low_ < divisor.low_ ? 1 : 0), low);
+
+            if (bit >= 64)
+            {
+                result.high_ |= Q_UINT64_C(1) << (bit - 64);
+            }
+            else
+            {
+                result.low_ |= Q_UINT64_C(1) << bit;
+            }
+        }
+    }
+
+    quotient = result;
+    remainder = rest;
+}
+
+//-----------------------------------------------------------------------------
+// Function: WideInteger::withSign()
+//-----------------------------------------------------------------------------
+bool WideInteger::withSign(WideInteger const& magnitude, bool negative, WideInteger& result) noexcept
+{
+    if (negative)
+    {
+        // The magnitude of a negative value may be at most 2^127.
+        if ((magnitude.high_ & SIGN_BIT) != 0 && (magnitude.high_ != SIGN_BIT || magnitude.low_ != 0))
+        {
+            return false;
+        }
+
+        const quint64 low = ~magnitude.low_ + 1;
+        result = WideInteger(~magnitude.high_ + (low == 0 ? 1 : 0), low);
+        return true;
+    }
+
+    if ((magnitude.high_ & SIGN_BIT) != 0)
+    {
+        return false;
+    }
+
+    result = magnitude;
+    return true;
+}
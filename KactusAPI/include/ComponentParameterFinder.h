@@ -16,11 +16,23 @@
 
 #include "KactusAPI/KactusAPIGlobal.h"
 
+#include <QHash>
+#include <QList>
+#include <QVector>
+
+#include <array>
+
 class AbstractParameterModel;
 class Component;
 
 //-----------------------------------------------------------------------------
 //! The implementation for finding parameters with the correct ID.
+//!
+//! The parameters are found through an index by their ids. An indexed parameter is used only while it is still
+//! found with the same id at the same position of the component, following the elements owning its parameter
+//! list, e.g. the memory map, address block and register. The index is therefore rebuilt after the parameters or
+//! their owners have been added, removed or moved and no change notifications are needed. Because the index is
+//! updated during the searches, a finder must not be used from several threads at the same time.
 //-----------------------------------------------------------------------------
 class KACTUS2_API ComponentParameterFinder : public ParameterFinder
 {
@@ -158,7 +170,84 @@ protected:
     QSharedPointer<const Component> getComponent() const noexcept;
 
 private:
-    
+
+    //! A list of parameters in the component.
+    using ParameterList = QSharedPointer<QList<QSharedPointer<Parameter> > >;
+
+    //! The elements owning the parameter lists in the component.
+    enum class ListOwner
+    {
+        Component,
+        BusInterface,
+        Cpu,
+        Generator,
+        AddressSpace,
+        LocalMemoryMapRegister,
+        MemoryMapRegister,
+        IndirectInterface
+    };
+
+    //! The location of a parameter list in the component.
+    struct ListLocation
+    {
+        ListOwner owner = ListOwner::Component;     //!< The type of the element owning the list.
+        std::array<int, 3> path = { 0, 0, 0 };      //!< The positions of the owning elements from the component.
+    };
+
+    //! A parameter list with its location in the component.
+    struct LocatedList
+    {
+        ListLocation location;      //!< The location of the list.
+        ParameterList parameters;   //!< The parameters in the list.
+    };
+
+    //! The location of an indexed parameter.
+    struct IndexEntry
+    {
+        QSharedPointer<Parameter> parameter;    //!< The indexed parameter.
+        ListLocation location;                  //!< The location of the list containing the parameter.
+        int position = 0;                       //!< The position in the list.
+    };
+
+    /*!
+     *  Finds the parameter with the given id from the index.
+     *
+     *    @param [in] parameterId     The id of the parameter being searched for.
+     *
+     *    @return The parameter, or null if the parameter is not in the index or it has changed.
+     */
+    QSharedPointer<Parameter> findIndexedParameter(QStringView parameterId) const;
+
+    /*!
+     *  Searches the parameter with the given id from all the parameters in the component.
+     *
+     *    @param [in] parameterId     The id of the parameter being searched for.
+     *
+     *    @return The first parameter with the id, or null if there is none.
+     */
+    QSharedPointer<Parameter> scanParameter(QStringView parameterId) const;
+
+    /*!
+     *  Indexes all the parameters in the component by their ids.
+     */
+    void rebuildIndex() const;
+
+    /*!
+     *  Gets all the parameter lists in the component in the search order.
+     *
+     *    @return The parameter lists with their locations.
+     */
+    QVector<LocatedList> allParameterLists() const;
+
+    /*!
+     *  Finds the parameter list currently at the given location in the component.
+     *
+     *    @param [in] location    The location of the list.
+     *
+     *    @return The parameter list, or null if the component no longer has an element at the location.
+     */
+    ParameterList parameterListAt(ListLocation const& location) const;
+
     /*!
      *  Returns number of parameters in bus interfaces.
      */
@@ -175,6 +264,9 @@ private:
 
     //! The parameters are searched from this component.
     QSharedPointer<Component const> component_;
+
+    //! The locations of the parameters by their ids.
+    mutable QHash<QString, IndexEntry> parameterIndex_;
 };
 
 #endif // COMPONENTPARAMETERFINDER_H
@@ -14,6 +14,8 @@
 
 #include <KactusAPI/KactusAPIGlobal.h>
 
+#include <QByteArray>
+#include <QIODevice>
 #include <QSharedPointer>
 #include <QString>
 
@@ -29,9 +31,19 @@ namespace DocumentFileAccess
     //! Reads the document from given path.
     KACTUS2_API QSharedPointer<Document> readDocument(QString const& path);
 
+    //! Reads the document from given path and calculates the hash of the read file content.
+    KACTUS2_API QSharedPointer<Document> readDocument(QString const& path, QByteArray& contentHash);
+
+    //! Calculates the hash of the file content in the given path. Returns an empty hash if the file cannot be read.
+    KACTUS2_API QByteArray hashFile(QString const& path);
+
     //! Writes to document model to the given path.
+    //! The file is replaced only once the whole document has been written.
     KACTUS2_API bool writeDocument(QSharedPointer<Document> model, QString const& path);
 
+    //! Writes to document model to the given device.
+    KACTUS2_API bool writeDocument(QSharedPointer<Document> model, QIODevice& device);
+
 };
 
 #endif // DOCUMENTFILEACCESS_H
@@ -0,0 +1,107 @@
+//-----------------------------------------------------------------------------
+// File: DocumentMetadata.h
+//-----------------------------------------------------------------------------
+// Project: Kactus2
+// Author: Kactus2 team
+// Date: 16.10.2026
+//
+// Description:
+// Summary of a library document for filtering the library without its model.
+//-----------------------------------------------------------------------------
+
+#ifndef DOCUMENTMETADATA_H
+#define DOCUMENTMETADATA_H
+
+#include <KactusAPI/KactusAPIGlobal.h>
+
+#include <IPXACTmodels/common/Document.h>
+#include <IPXACTmodels/common/TagData.h>
+#include <IPXACTmodels/common/VLNV.h>
+#include <IPXACTmodels/kactusExtensions/KactusAttribute.h>
+
+#include <QDataStream>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+//-----------------------------------------------------------------------------
+//! A reference placing another document under a document in the library hierarchy.
+//-----------------------------------------------------------------------------
+struct HierarchyReference
+{
+    //! The referenced document. The type tells a design from a design configuration in a component view.
+    VLNV vlnv;
+
+    //! The hierarchical view of a component referencing a design or a configuration, otherwise empty.
+    QString viewName;
+};
+
+//-----------------------------------------------------------------------------
+//! Summary of a library document for filtering the library without its model.
+//-----------------------------------------------------------------------------
+struct KACTUS2_API DocumentMetadata
+{
+    //! The type of the document. Invalid, if the document has not been read.
+    VLNV::IPXactType type = VLNV::INVALID;
+
+    //! The implementation of the document.
+    KactusAttribute::Implementation implementation = KactusAttribute::HW;
+
+    //! The firmness of the document.
+    KactusAttribute::Firmness firmness = KactusAttribute::MUTABLE;
+
+    //! The product hierarchy of the document.
+    KactusAttribute::ProductHierarchy productHierarchy = KactusAttribute::FLAT;
+
+    //! The IP-XACT standard revision of the document.
+    Document::Revision revision = Document::Revision::Unknown;
+
+    //! The tags of the document.
+    QVector<TagData> tags;
+
+    //! Flag for components with hierarchical views.
+    bool isHierarchical = false;
+
+    //! Flag for components with system views.
+    bool hasSystemViews = false;
+
+    //! Flag for components with any views.
+    bool hasViews = false;
+
+    //! Flag for well-formed content.
+    bool isValid = false;
+
+    //! The short description of the document.
+    QString shortDescription;
+
+    //! The other documents referenced by the document, for finding the owners of an item without reading them.
+    QVector<VLNV> dependencies;
+
+    //! The documents placed under the document in the library hierarchy, for building the hierarchy without
+    //! reading the documents: the designs or configurations of the hierarchical views of a component, the
+    //! instantiated components of a design, the design of a configuration, the bus type of an abstraction
+    //! definition and the items listed in a catalog.
+    QVector<HierarchyReference> hierarchyReferences;
+
+    /*!
+     *  Collects the summary of the given document.
+     *
+     *    @param [in] document    The document to summarize.
+     *
+     *    @return The summary of the document. The validity is not set.
+     */
+    static DocumentMetadata fromDocument(QSharedPointer<Document const> document);
+
+    /*!
+     *  Checks if the summary has been collected from a document.
+     *
+     *    @return True, if the summary is available, otherwise false.
+     */
+    bool isKnown() const { return type != VLNV::INVALID; }
+};
+
+//! Serialization of the document summaries for the persistent library index.
+KACTUS2_API QDataStream& operator<<(QDataStream& stream, DocumentMetadata const& metadata);
+KACTUS2_API QDataStream& operator>>(QDataStream& stream, DocumentMetadata& metadata);
+
+#endif // DOCUMENTMETADATA_H
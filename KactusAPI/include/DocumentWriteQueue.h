@@ -0,0 +1,168 @@
+//-----------------------------------------------------------------------------
+// File: DocumentWriteQueue.h
+//-----------------------------------------------------------------------------
+// Project: Kactus2
+// Author: Kactus2 team
+// Date: 16.10.2026
+//
+// Description:
+// Queue for writing IP-XACT documents to files in a background thread.
+//-----------------------------------------------------------------------------
+
+#ifndef DOCUMENTWRITEQUEUE_H
+#define DOCUMENTWRITEQUEUE_H
+
+#include <KactusAPI/KactusAPIGlobal.h>
+
+#include <IPXACTmodels/common/Document.h>
+
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QSharedPointer>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QVector>
+
+//-----------------------------------------------------------------------------
+//! Queue for writing IP-XACT documents to files in a background thread.
+//!
+//! The documents are serialized and written by a single worker thread in the order they were queued. Each file
+//! is first written to a temporary file next to the target and then renamed over it, so that an interrupted
+//! write never leaves a partial document behind. The writes queued within a group are committed together:
+//! the files are renamed only after all of them have been written, and none of them if any write fails.
+//! Renaming the files is not atomic as a whole, however. If renaming a file fails, the files renamed before it
+//! keep their new content and the rest of the group is left unchanged and reported as failed.
+//-----------------------------------------------------------------------------
+class KACTUS2_API DocumentWriteQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    /*!
+     *  The constructor.
+     *
+     *    @param [in] parent  The owner of the queue.
+     */
+    explicit DocumentWriteQueue(QObject* parent = nullptr);
+
+    //! The destructor. Submits any open group and waits for the queued writes to finish.
+    ~DocumentWriteQueue() override;
+
+    //! No copying.
+    DocumentWriteQueue(DocumentWriteQueue const& other) = delete;
+    DocumentWriteQueue& operator=(DocumentWriteQueue const& other) = delete;
+
+    //! Starts a group of writes to commit together. Groups may be nested.
+    void beginGroup();
+
+    //! Ends a group of writes and submits the writes in it, once the outermost group ends.
+    void endGroup();
+
+    /*!
+     *  Queues a document to be written. The document must not be changed until it has been written.
+     *
+     *    @param [in] document    The document to write.
+     *    @param [in] path        The path to the target file.
+     */
+    void enqueue(QSharedPointer<Document> document, QString const& path);
+
+    /*!
+     *  Checks if there are unfinished writes to the given file.
+     *
+     *    @param [in] path    The path to the file.
+     *
+     *    @return True, if the file is waiting to be written, otherwise false.
+     */
+    bool isPending(QString const& path) const;
+
+    /*!
+     *  Gets the document waiting to be written to the given file. Until the write has finished, the document
+     *  is more recent than the file.
+     *
+     *    @param [in] path    The path to the file.
+     *
+     *    @return The last document queued for the file, or null if the file is not waiting to be written.
+     */
+    QSharedPointer<Document> queuedDocument(QString const& path) const;
+
+    /*!
+     *  Drops the writes to the given file from the open group, e.g. when the file is removed. Writes already
+     *  submitted are not affected.
+     *
+     *    @param [in] path    The path to the file.
+     */
+    void cancelGroupedWrites(QString const& path);
+
+    /*!
+     *  Checks if there are unfinished writes in the queue.
+     *
+     *    @return True, if any file is waiting to be written, otherwise false.
+     */
+    bool hasPendingWrites() const;
+
+    /*!
+     *  Blocks until all submitted writes have finished. The writes in an open group are submitted only when
+     *  the group ends, so that a group is never committed partially.
+     */
+    void waitForDone();
+
+signals:
+
+    /*!
+     *  Informs that a batch of writes has finished.
+     *
+     *    @param [in] writtenPaths    The files that were written.
+     *    @param [in] failedPaths     The files that could not be written.
+     */
+    void writesFinished(QStringList const& writtenPaths, QStringList const& failedPaths);
+
+private:
+
+    //! A document waiting to be written.
+    struct PendingWrite
+    {
+        QSharedPointer<Document> document;  //<! The document to write.
+        QString path;                       //<! The path to the target file.
+    };
+
+    /*!
+     *  Submits the given writes to the worker thread as one batch.
+     *
+     *    @param [in] batch   The writes to commit together.
+     */
+    void submit(QVector<PendingWrite> const& batch);
+
+    /*!
+     *  Writes and commits a batch of documents. Run in the worker thread.
+     *
+     *    @param [in] batch   The writes to commit together.
+     */
+    void commitBatch(QVector<PendingWrite> const& batch);
+
+    //-----------------------------------------------------------------------------
+    // Data.
+    //-----------------------------------------------------------------------------
+
+    //! The nesting depth of the open groups.
+    int groupDepth_{ 0 };
+
+    //! The writes in the open group.
+    QVector<PendingWrite> group_;
+
+    //! Guards the pending file counts shared with the worker thread.
+    mutable QMutex pendingMutex_;
+
+    //! The number of unfinished writes to each file.
+    QHash<QString, int> pendingPaths_;
+
+    //! The last document queued for each file with unfinished writes.
+    QHash<QString, QSharedPointer<Document> > queuedDocuments_;
+
+    //! The single worker thread keeping the writes in order.
+    QThreadPool worker_;
+};
+
+#endif // DOCUMENTWRITEQUEUE_H
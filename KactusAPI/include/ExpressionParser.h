@@ -52,6 +52,28 @@ public:
      *    @return The common base for the expression.
      */
     virtual int baseForExpression(QStringView expression) const = 0;
+
+    /*!
+     *  Parses an expression to decimal number and finds the common base in the expression.
+     *
+     *  Parsers should override this to find both from a single parse of the expression.
+     *
+     *    @param [in]  expression         The expression to parse.
+     *    @param [out] validExpression    Set to true, if the parsing was successful, otherwise false.
+     *    @param [out] base               Set to the common base for the expression.
+     *
+     *    @return The decimal value of the evaluated expression.
+     */
+    virtual QString parseExpressionWithBase(QStringView expression, bool* validExpression, int* base) const
+    {
+        QString value = parseExpression(expression, validExpression);
+        if (base != nullptr)
+        {
+            *base = baseForExpression(expression);
+        }
+
+        return value;
+    }
 };
 
 #endif // EXPRESSIONPARSER_H
@@ -0,0 +1,194 @@
+//-----------------------------------------------------------------------------
+// File: ExpressionValue.h
+//-----------------------------------------------------------------------------
+// Project: Kactus2
+// Author: Kactus2 team
+// Date: 16.10.2026
+//
+// Description:
+// Intermediate value in the evaluation of an expression.
+//-----------------------------------------------------------------------------
+
+#ifndef EXPRESSIONVALUE_H
+#define EXPRESSIONVALUE_H
+
+#include <KactusAPI/KactusAPIGlobal.h>
+
+#include "WideInteger.h"
+
+#include <QString>
+
+//-----------------------------------------------------------------------------
+//! Intermediate value in the evaluation of an expression.
+//!
+//! Integers are kept as exact 64-bit values, so they can be calculated without converting them to text and
+//! back. Integers that do not fit in 64 bits, e.g. unsigned 64-bit addresses, are kept as exact 128-bit values.
+//! Real numbers are kept with the number of decimals they are printed with. All other values, e.g. strings and
+//! arrays, are kept in their textual form. Values become text only when the result of an expression is formed.
+//! A value read from text always prints back to the same text.
+//-----------------------------------------------------------------------------
+class KACTUS2_API ExpressionValue
+{
+public:
+
+    //! The types of the values.
+    enum class Type
+    {
+        Unknown,    //!< The value could not be evaluated.
+        Integer,    //!< 64-bit signed integer.
+        Wide,       //!< 128-bit signed integer outside the 64-bit range.
+        Real,       //!< Real number with a fixed number of decimals.
+        Text        //!< Any other value in its textual form.
+    };
+
+    //! The constructor. Creates an unknown value.
+    ExpressionValue() = default;
+
+    /*!
+     *  Creates an integer value.
+     *
+     *    @param [in] value   The integer.
+     *
+     *    @return The value.
+     */
+    static ExpressionValue fromInteger(qint64 value) noexcept;
+
+    /*!
+     *  Creates an integer value from a 128-bit integer.
+     *
+     *    @param [in] value   The integer.
+     *
+     *    @return The value. Integers within the 64-bit range are stored as 64-bit integers.
+     */
+    static ExpressionValue fromWide(WideInteger const& value) noexcept;
+
+    /*!
+     *  Creates a real value.
+     *
+     *    @param [in] value       The real number.
+     *    @param [in] precision   The number of decimals to print.
+     *
+     *    @return The value.
+     */
+    static ExpressionValue fromReal(double value, int precision) noexcept;
+
+    /*!
+     *  Creates a value from its textual form.
+     *
+     *    @param [in] text    The value as text, e.g. the result of an expression.
+     *
+     *    @return The value. Integers in their canonical decimal form are stored as integers and decimal numbers
+     *            printing back to the same text as reals.
+     */
+    static ExpressionValue fromText(QString const& text);
+
+    /*!
+     *  Gets the type of the value.
+     *
+     *    @return The value type.
+     */
+    Type type() const noexcept { return type_; }
+
+    /*!
+     *  Checks if the value is an integer.
+     *
+     *    @return True, if the value is an integer, otherwise false.
+     */
+    bool isInteger() const noexcept { return type_ == Type::Integer; }
+
+    /*!
+     *  Checks if the value is an integer of any width.
+     *
+     *    @return True, if the value is a 64-bit or a 128-bit integer, otherwise false.
+     */
+    bool isIntegral() const noexcept { return type_ == Type::Integer || type_ == Type::Wide; }
+
+    /*!
+     *  Checks if the value is a number.
+     *
+     *    @return True, if the value is an integer or a real number, otherwise false.
+     */
+    bool isNumber() const noexcept { return isIntegral() || type_ == Type::Real; }
+
+    /*!
+     *  Checks if the value is a real number.
+     *
+     *    @return True, if the value is a real number, otherwise false.
+     */
+    bool isReal() const noexcept { return type_ == Type::Real; }
+
+    /*!
+     *  Checks if the value is unknown.
+     *
+     *    @return True, if the value could not be evaluated, otherwise false.
+     */
+    bool isUnknown() const noexcept { return type_ == Type::Unknown; }
+
+    /*!
+     *  Gets the integer value.
+     *
+     *    @return The integer, or 0 if the value is not an integer.
+     */
+    qint64 integer() const noexcept { return integer_; }
+
+    /*!
+     *  Gets the integer value as a 128-bit integer.
+     *
+     *    @return The integer, or 0 if the value is not an integer.
+     */
+    WideInteger wide() const noexcept { return type_ == Type::Wide ? wide_ : WideInteger(integer_); }
+
+    /*!
+     *  Gets the number of decimals printed for the value.
+     *
+     *    @return The number of decimals of a real number, otherwise 0.
+     */
+    int precision() const noexcept { return type_ == Type::Real ? precision_ : 0; }
+
+    /*!
+     *  Checks if the value is the given text.
+     *
+     *    @param [in] text    The text to compare to.
+     *
+     *    @return True, if the value is text and equal to the given text, otherwise false.
+     */
+    bool isText(QStringView text) const noexcept { return type_ == Type::Text && text_ == text; }
+
+    /*!
+     *  Gets the value as a real number.
+     *
+     *    @return The numeric value, or 0 if the value is not a number.
+     */
+    double toDouble() const;
+
+    /*!
+     *  Gets the textual form of the value.
+     *
+     *    @return The value as text, or x if the value is unknown.
+     */
+    QString toString() const;
+
+private:
+
+    //! The type of the value.
+    Type type_ = Type::Unknown;
+
+    //! The value of an integer.
+    qint64 integer_ = 0;
+
+    //! The value of an integer outside the 64-bit range.
+    WideInteger wide_;
+
+    //! The value of a real number.
+    double real_ = 0;
+
+    //! The number of decimals printed for a real number.
+    int precision_ = 0;
+
+    //! The textual form of other values.
+    QString text_;
+};
+
+Q_DECLARE_TYPEINFO(ExpressionValue, Q_RELOCATABLE_TYPE);
+
+#endif // EXPRESSIONVALUE_H
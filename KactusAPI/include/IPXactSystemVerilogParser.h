@@ -13,17 +13,25 @@
 #define IPXACTSYSTEMVERILOGPARSER_H
 
 #include "SystemVerilogExpressionParser.h"
+#include "ResolvedValueCache.h"
 
 #include "KactusAPI/KactusAPIGlobal.h"
 
+#include <QSet>
 #include <QSharedPointer>
 #include <QString>
+#include <QStringList>
 #include <QVector>
 
 class ParameterFinder;
 
 //-----------------------------------------------------------------------------
 // Parser for SystemVerilog expressions with parameter references.
+//
+// The resolved parameter values are cached with the parameters they reference. A cached value is used again,
+// if the value expression of the parameter and the values of the referenced parameters have not changed since.
+// A changed parameter invalidates only the values depending on it. Each cached value is checked at most once
+// while evaluating an expression given to the parser.
 //-----------------------------------------------------------------------------
 class KACTUS2_API IPXactSystemVerilogParser : public SystemVerilogExpressionParser
 {
@@ -43,6 +51,34 @@ public:
     IPXactSystemVerilogParser(IPXactSystemVerilogParser const& rhs) = delete;
     IPXactSystemVerilogParser& operator=(IPXactSystemVerilogParser const& rhs) = delete;
 
+    /*!
+     *  Parses an expression to decimal number.
+     *
+     *    @param [in] expression          The expression to parse.
+     *    @param [out] validExpression    Set to true, if the parsing was successful, otherwise false.
+     *
+     *    @return The decimal value of the evaluated expression.
+     */
+    QString parseExpression(QStringView expression, bool* validExpression = nullptr) const override;
+
+    /*!
+     *  Parses an expression to decimal number and finds its common base.
+     *
+     *    @param [in] expression          The expression to parse.
+     *    @param [out] validExpression    Set to true, if the parsing was successful, otherwise false.
+     *    @param [out] base               The common base in the expression.
+     *
+     *    @return The decimal value of the evaluated expression.
+     */
+    QString parseExpressionWithBase(QStringView expression, bool* validExpression, int* base) const override;
+
+    /*!
+     *  Gets the number of resolved parameter values in the cache.
+     *
+     *    @return The number of cached values.
+     */
+    int cachedValueCount() const;
+
     /*!
      *  Checks if the given expression is a symbol e.g. reference.
      *
@@ -72,6 +108,45 @@ public:
 
 private:
 
+    //! A parameter whose value is being resolved.
+    struct ResolutionFrame
+    {
+        QStringView id;                 //!< The id of the parameter.
+        bool recordReferences = true;   //!< Flag for recording the references found in the value expression.
+        QStringList dependencies;       //!< The ids of the parameters referenced in the value expression.
+        QStringList unknownSymbols;     //!< The names in the value expression that are not parameter ids.
+    };
+
+    /*!
+     *  Finds the cached value of a parameter, if it is still valid.
+     *
+     *    @param [in] symbol  The id of the parameter.
+     *    @param [in] key     The id of the parameter in the cache.
+     *
+     *    @return The cached value, or null if the value must be resolved again.
+     */
+    ResolvedValueCache::Entry const* findValidValue(QStringView symbol, QString const& key) const;
+
+    /*!
+     *  Starts the evaluation of an expression. The outermost evaluation starts a new resolution pass.
+     */
+    void beginEvaluation() const;
+
+    //! Ends the evaluation of an expression.
+    void endEvaluation() const;
+
+    //! Removes the cached values of the parameters that are no longer found, once the cache has grown enough.
+    void pruneResolvedValues() const;
+
+    /*!
+     *  Checks if the given name may be a reference to a parameter.
+     *
+     *    @param [in] name    The name to check.
+     *
+     *    @return True, if the name is an identifier, otherwise false.
+     */
+    static bool isIdentifier(QStringView name) noexcept;
+
     //-----------------------------------------------------------------------------
     // Data.
     //-----------------------------------------------------------------------------
@@ -79,8 +154,26 @@ private:
     //! The finder for parameters available in the SystemVerilog expressions.
     QSharedPointer<ParameterFinder> finder_;
 
-    //! Stack for tracking already evaluated symbols to check for loops in references.
-    mutable QVector<QStringView> symbolStack_;
+    //! The resolved parameter values.
+    mutable ResolvedValueCache resolvedValues_;
+
+    //! The parameters being resolved, innermost last.
+    mutable QVector<ResolutionFrame> resolving_;
+
+    //! The ids of the parameters being resolved for checking for loops in references.
+    mutable QSet<QStringView> resolvingIds_;
+
+    //! The number of the current resolution pass. Cached values are checked once in each pass.
+    mutable quint64 resolutionPass_ = 0;
+
+    //! The number of expressions being evaluated, including the value expressions of the parameters.
+    mutable int evaluationDepth_ = 0;
+
+    //! The number of cached values at which the values of removed parameters are pruned next.
+    mutable int pruneLimit_;
+
+    //! Flag for a loop in the references found in the current resolution pass.
+    mutable bool loopFound_ = false;
 };
 
 #endif // IPXACTSYSTEMVERILOGPARSER_H
@@ -0,0 +1,88 @@
+//-----------------------------------------------------------------------------
+// File: LibraryArchive.h
+//-----------------------------------------------------------------------------
+// Project: Kactus2
+// Author: Kactus2 team
+// Date: 16.10.2026
+//
+// Description:
+// Read-only access to library locations packed into a single zip archive.
+//-----------------------------------------------------------------------------
+
+#ifndef LIBRARYARCHIVE_H
+#define LIBRARYARCHIVE_H
+
+#include <KactusAPI/KactusAPIGlobal.h>
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+//-----------------------------------------------------------------------------
+//! Read-only access to library locations packed into a single zip archive.
+//!
+//! A library location may be a zip archive of the vendor/library/name/version tree instead of a directory.
+//! The files in an archive are addressed with the path of the archive followed by the path of the file in
+//! the archive, e.g. /libraries/vendor.zip/tut.fi/ip/uart/1.0/uart.1.0.xml. The central directory of an
+//! archive is read once and kept in memory. The archive file is open only while it is being read. Stored and
+//! deflated files of up to 256 MB are supported.
+//-----------------------------------------------------------------------------
+namespace LibraryArchive
+{
+    //! A file found in an archive.
+    struct Entry
+    {
+        QString path;               //!< The path to the file, starting with the path of the archive.
+        qint64 size = -1;           //!< The uncompressed size of the file.
+        qint64 lastModified = 0;    //!< The modification time of the file in ms since epoch.
+    };
+
+    /*!
+     *  Checks if the given library location is an archive.
+     *
+     *    @param [in] location    The library location.
+     *
+     *    @return True, if the location is a zip archive, otherwise false.
+     */
+    KACTUS2_API bool isArchive(QString const& location);
+
+    /*!
+     *  Checks if the given path refers to a file or directory inside an archive.
+     *
+     *    @param [in] path    The path to check.
+     *
+     *    @return True, if the path is inside an archive, otherwise false.
+     */
+    KACTUS2_API bool isArchiveEntry(QString const& path);
+
+    /*!
+     *  Finds the XML files in an archive. The archive is read again, if it has changed since it was opened.
+     *
+     *    @param [in] archivePath     The path to the archive.
+     *    @param [out] documents      The found files.
+     *
+     *    @return True, if the archive could be read, otherwise false.
+     */
+    KACTUS2_API bool findDocuments(QString const& archivePath, QVector<Entry>& documents);
+
+    /*!
+     *  Checks if a file or directory exists inside an archive.
+     *
+     *    @param [in] path    The path to the file or directory.
+     *
+     *    @return True, if the path is inside an archive and found in it, otherwise false.
+     */
+    KACTUS2_API bool contains(QString const& path);
+
+    /*!
+     *  Reads the content of a file in an archive.
+     *
+     *    @param [in] path        The path to the file.
+     *    @param [out] content    The uncompressed content of the file.
+     *
+     *    @return True, if the file was found and its content is intact, otherwise false.
+     */
+    KACTUS2_API bool readEntry(QString const& path, QByteArray& content);
+}
+
+#endif // LIBRARYARCHIVE_H
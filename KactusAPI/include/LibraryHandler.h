@@ -22,6 +22,8 @@
 
 #include "DocumentFileAccess.h"
 #include "DocumentValidator.h"
+#include "DocumentWriteQueue.h"
+#include "VLNVTable.h"
 
 #include <IPXACTmodels/common/Document.h>
 #include <IPXACTmodels/common/TagData.h>
@@ -33,8 +35,15 @@
 #include <QString>
 #include <QStringList>
 #include <QList>
+#include <QHash>
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QMutex>
 #include <QSharedPointer>
+#include <QFileSystemWatcher>
 #include <QObject>
+#include <QSet>
+#include <QTimer>
 
 class LibraryItem;
 class MessageMediator;
@@ -58,17 +67,97 @@ public:
     LibraryHandler& operator=(const LibraryHandler& other) = delete;
 
     //! The destructor
-    ~LibraryHandler() final = default;
+    ~LibraryHandler() final;
 
     void setOutputChannel(MessageMediator* messageChannel);
 
-    /*! Get a model that matches given VLNV.
+    /*! Sets the library integrity check to run in the background after a library search.
+     *
+     * When enabled, the library views are updated right after the file scan and the documents are
+     * validated in small batches between events. Items are considered valid until they have been checked.
+     *
+     *    @param [in] enabled     If true, the integrity check is run in the background.
+     */
+    void setBackgroundValidation(bool enabled);
+
+    /*! Checks if the background integrity check is still running.
+     *
+     *    @return True, if some items are still waiting for validation, otherwise false.
+     */
+    bool isIntegrityCheckRunning() const;
+
+    /*! Sets the library to follow the changes made to the library locations on disk.
+     *
+     * When enabled, the directories found by the library search are followed and created, modified and
+     * removed files update only the affected items and their dependents. The directories are watched a batch
+     * at a time between events. Locations on network file systems and directories that cannot be watched are
+     * polled instead.
+     *
+     *    @param [in] enabled     If true, the library locations are watched.
+     */
+    void setFileSystemWatching(bool enabled);
+
+    /*! Starts a library search that shows the found items while the library locations are still being read.
+     *
+     * The locations are read in a worker thread and the function returns right away. The found items are
+     * added to the library in batches and can be opened while the search continues. The previous items stay in
+     * the library until the search is completed, e.g. the library is validated, once all the locations have been
+     * read or the search is cancelled. Only a completed search removes the items whose files were not found.
+     */
+    void startLibrarySearch();
+
+    /*! Checks if a progressive library search is still running.
+     *
+     *    @return True, if the library locations are being read, otherwise false.
+     */
+    bool isLibraryScanRunning() const;
+
+    //! Blocks until a running progressive library search has read all the locations and completes it.
+    void waitForLibraryScan();
+
+    //! Statistics on the use of the document cache.
+    struct CacheStatistics
+    {
+        qint64 hits = 0;            //<! Requests served without reading the document file.
+        qint64 misses = 0;          //<! Requests that read the document file.
+        qint64 reads = 0;           //<! Document files read, including the reads of the integrity checks.
+        qint64 evictions = 0;       //<! Documents dropped from the cache to stay within the budget.
+        qint64 cachedBytes = 0;     //<! The estimated memory used by the cached documents.
+        int cachedDocuments = 0;    //<! The number of cached documents.
+        qint64 retainedBytes = 0;   //<! The estimated memory of the dropped documents still used elsewhere.
+    };
+
+    /*! Sets the memory budget for the parsed documents kept in the cache.
+     *
+     * When the estimated memory use exceeds the budget, the least recently used documents are dropped from
+     * the cache. The path, VLNV and validity of the dropped documents are kept and the documents are read
+     * again when requested.
+     *
+     *    @param [in] budgetBytes     The memory budget in bytes.
+     */
+    void setCacheBudget(qint64 budgetBytes);
+
+    /*! Gets the statistics on the use of the document cache.
+     *
+     *    @return The statistics since the library handler was created.
+     */
+    CacheStatistics getCacheStatistics() const;
+
+    /*! Blocks until all the saved documents have been written to their files.
+     *
+     * The documents are written in the background after they have been saved to the library. Call this
+     * before using the files outside the library, e.g. before the application exits. The documents of a save
+     * still in progress are written once it ends with endSave().
+     */
+    void waitForPendingWrites();
+
+    /*! Get a model that matches given VLNV for editing.
      *
      * This function can be called to get a model that matches an IP-Xact document.
      * 
      *    @param [in] vlnv Identifies the desired document.
      *
-     *    @return The model that matches the document.
+     *    @return A private, editable copy of the model that matches the document.
     */
     QSharedPointer<Document> getModel(VLNV const& vlnv) final;
 
@@ -185,11 +274,11 @@ public:
     */
     VLNV::IPXactType getDocumentType(VLNV const& vlnv) final;
 
-    /*! Count how many times the given component is instantiated in the library.
+    /*! Count how many documents in the library reference the given item.
      *
-     *    @param [in] vlnv Identifies the component that's instances are searched.
+     *    @param [in] vlnv Identifies the item that's references are searched.
      *
-     *    @return Number of found instances.
+     *    @return Number of found references.
      */
     int referenceCount(VLNV const& vlnv) const final;
 
@@ -249,6 +338,17 @@ public:
     */
     bool isValid(VLNV const& vlnv) final;
 
+    /*! Get the summary of the identified object for filtering the library.
+     *
+     *    The summary is kept in the persistent library index, so the model is read only if the object has not
+     *    been read before. A model read only for the summary is not kept in the cache.
+     *
+     *    @param [in] vlnv    Identifies the object.
+     *
+     *    @return The summary of the object. Not known, if the object was not found in library.
+    */
+    DocumentMetadata getMetadata(VLNV const& vlnv) final;
+
     HierarchyModel* getHierarchyModel();
 
     LibraryTreeModel* getTreeModel();
@@ -272,6 +372,9 @@ public slots:
     */
     void onCheckLibraryIntegrity() final;
 
+    //! Stops a running progressive library search. The items found so far are kept in the library.
+    void cancelLibraryScan();
+
     /*! Edit an item in the library
      *
      *    @param [in] vlnv Reference to the vlnv that identifies the object to edit.
@@ -334,7 +437,8 @@ public slots:
     *
     * When calling this before saving and then using writeModelToFile() the 
     * library is not update between each save operation thus making the program
-    * faster.
+    * faster. The files saved between beginSave() and endSave() are committed together
+    * and the library views are updated once for all of them.
     * 
     * Be sure to call endSave() after all items are saved.
     */
@@ -351,6 +455,22 @@ signals:
 
     void progressStatus();
 
+    //! Informs about the progress of the background integrity check.
+    void integrityCheckProgress(int checkedCount, int totalCount);
+
+    //! Informs that the background integrity check has completed.
+    void integrityCheckFinished();
+
+    /*! Informs about the progress of a progressive library search.
+     *
+     *    @param [in] scannedCount    The number of files read so far.
+     *    @param [in] foundCount      The number of files found in the library locations so far.
+     */
+    void libraryScanProgress(int scannedCount, int foundCount);
+
+    //! Informs that a progressive library search has ended.
+    void libraryScanFinished();
+
     //! Signal that user wants to open the specified component for editing.
     void openDesign(VLNV const& vlnv, const QString& viewName);
 
@@ -399,6 +519,13 @@ signals:
     //! Inform both models that the content must be reset.
     void resetModel();
 
+    /*! Informs that the validity of an item changed when it or an item it references was saved.
+     *
+     *    @param [in] vlnv    Identifies the item.
+     *    @param [in] valid   The new validity of the item.
+     */
+    void validityChanged(VLNV const& vlnv, bool valid);
+
 private slots:
     
     /*! This function should be called every time an object is written to disk.
@@ -412,6 +539,34 @@ private slots:
     */
     void onItemSaved(VLNV const& vlnv);
 
+    /*! Updates the library after a batch of saved documents has been written to the disk.
+     *
+     *    @param [in] writtenPaths    The files that were written.
+     *    @param [in] failedPaths     The files that could not be written.
+     */
+    void onWritesFinished(QStringList const& writtenPaths, QStringList const& failedPaths);
+
+    //! Validates the next batch of items in the background integrity check.
+    void onCheckNextItems();
+
+    /*! Marks a directory to be refreshed in the next incremental refresh.
+     *
+     *    @param [in] path    The path to the changed directory.
+     */
+    void onDirectoryChanged(QString const& path);
+
+    //! Updates the library items in the changed directories.
+    void onRefreshChangedDirectories();
+
+    //! Starts watching the next batch of the library directories.
+    void onWatchNextDirectories();
+
+    //! Checks the next batch of the polled library directories for changes.
+    void onPollNextDirectories();
+
+    //! Adds the items found by the progressive library search since the previous batch to the library.
+    void onScanResultsReady();
+
 private:
 
     //! All relevant data about an IP-XACT document is stored in DocumentInfo.
@@ -420,11 +575,30 @@ private:
         QSharedPointer<Document> document;  //<! The model for the document.
         QString path;                       //<! The path to the file containing the document.
         bool isValid;                       //<! Flag for well-formed content.
+        bool isChecked;                     //<! Flag for content that has been validated.
+        qint64 fileSize = -1;               //<! The size of the file when it was last read or written.
+        qint64 lastModified = 0;            //<! The modification time of the file in ms since epoch.
+        QWeakPointer<Document> evictedDocument; //<! The model dropped from the cache, if still used elsewhere.
+        DocumentMetadata metadata;          //<! The summary of the document for filtering.
+        QByteArray contentHash;             //<! The hash of the file content when it was last read, if known.
+        int fileCount = 0;                  //<! The number of valid file references found in the validation.
 
         //! Constructor.
         explicit DocumentInfo(QString const& filePath = QString(), 
             QSharedPointer<Document> doc = QSharedPointer<Document>(),
-            bool valid = false): document(doc), path(filePath), isValid(valid) {}
+            bool valid = false, bool checked = false): document(doc), path(filePath), isValid(valid),
+            isChecked(checked) {}
+    };
+
+    //! The library cache indexed by the handles of the document VLNVs.
+    using DocumentCache = QHash<VLNVTable::Handle, DocumentInfo>;
+
+    //! Bookkeeping for a parsed document kept in the cache.
+    struct CachedDocument
+    {
+        qint64 size = 0;            //<! The estimated memory used by the document.
+        quint64 lastAccess = 0;     //<! The access counter value on the latest use of the document.
+        bool isRetained = false;    //<! Flag for a document dropped from the cache but still used elsewhere.
     };
 
     //! Struct for collecting document statistics e.g. in export.
@@ -434,6 +608,17 @@ private:
         int documentCount = 0;
     };
 
+    //! A document passing through the parallel integrity check.
+    struct CheckedDocument
+    {
+        VLNV vlnv;                          //<! The VLNV of the document.
+        QString path;                       //<! The path to the document file.
+        QSharedPointer<Document> model;     //<! The model of the document.
+        bool isValid = false;               //<! The validation result.
+        int fileCount = 0;                  //<! The number of valid file references in the document.
+        QByteArray contentHash;             //<! The hash of the file content, if the document was read.
+    };
+
     //-----------------------------------------------------------------------------
     // The private functions used by public class methods
     //-----------------------------------------------------------------------------
@@ -452,21 +637,178 @@ private:
     //! Show error message for VLNV not found in the library.
     void showNotFoundError(VLNV const& vlnv) const;
 
-    //! Adds a IP-XACT document into the library cache.
+    /*! Adds a IP-XACT document into the library cache and queues it to be written to its file.
+     *
+     *  The file is written in the background. If the write fails, the error is shown and the item is validated
+     *  again against the file.
+     *
+     *    @param [in] model       The document to add.
+     *    @param [in] filePath    The path to the document file.
+     *
+     *    @return True, if the document was added and its write was queued, otherwise false.
+     */
     bool addObject(QSharedPointer<Document> model, QString const& filePath);
 
-    //! Clears the library cache of documents.
-    void clearCache();
+    /*! Takes the models and validity of the documents whose files have not changed since the previous search.
+     *
+     *  A file is unchanged, if its size and modification time or the hash of its content are the same. The
+     *  unchanged documents referencing any changed, added or removed document are validated again.
+     *
+     *    @param [in] previousDocuments   The library cache before the search.
+     */
+    void keepUnchangedDocuments(DocumentCache const& previousDocuments);
+
+    //! Validates the items not validated since they were last read and collects the results for all items.
+    void checkLibraryIntegrity();
 
     //! Loads all available VLNVs into the library cache.
     void loadAvailableVLNVs();
 
+    /*! Finds the cache entry of a document.
+     *
+     *    @param [in] vlnv    Identifies the document.
+     *
+     *    @return The cache entry, or the end of the cache if the document is not in the library.
+     */
+    DocumentCache::iterator findDocument(VLNV const& vlnv);
+    DocumentCache::const_iterator findDocument(VLNV const& vlnv) const;
+
+    /*! Checks the validity of a document. The cache lock must be held by the caller.
+     *
+     *    @param [in] info    The cache entry of the document.
+     *
+     *    @return True, if the document is valid or not yet checked and not known to be invalid.
+     */
+    bool isDocumentValid(DocumentInfo const& info) const;
+
+    /*! Adds a target found by a library search into a library cache.
+     *
+     *    @param [in] target  The found target.
+     *    @param [in] cache   The cache to add the target to.
+     *
+     *    @return True, if the target was added, false if its VLNV was already in the cache.
+     */
+    bool addLoadTarget(LibraryLoader::LoadTarget const& target, DocumentCache& cache);
+
+    /*! Completes a library search once the found items are in the library cache.
+     *
+     *    @param [in] previousDocuments   The library cache before the search.
+     */
+    void finishLibrarySearch(DocumentCache const& previousDocuments);
+
     //! Resets the tree and hierarchy model.
     void resetModels();
 
+    //! Starts validating the items not validated since they were last read in the background.
+    void startBackgroundIntegrityCheck();
+
+    //! Stops the background integrity check, if running.
+    void stopBackgroundIntegrityCheck();
+
+    //! Completes the background integrity check.
+    void finishBackgroundIntegrityCheck();
+
+    //! Starts following the directories found by the last library search.
+    void watchLibraryDirectories();
+
+    //! Stops following the library directories.
+    void stopWatchingLibrary();
+
+    /*! Starts following a library directory, either by watching or by polling it.
+     *
+     *    @param [in] path    The absolute path to the directory.
+     */
+    void followDirectory(QString const& path);
+
+    /*! Stops following a library directory that has been removed.
+     *
+     *    @param [in] path    The absolute path to the directory.
+     */
+    void unfollowDirectory(QString const& path);
+
+    /*! Starts polling a library directory.
+     *
+     *    @param [in] path    The absolute path to the directory.
+     */
+    void pollDirectory(QString const& path);
+
+    /*! Gets the model of a document, reading it from the disk if it is not in the cache.
+     *
+     *    @param [in] vlnv        Identifies the document.
+     *    @param [in/out] info    The cache entry of the document.
+     *    @param [in] readModel   The model already read from the disk, if any.
+     *
+     *    @return The model of the document.
+     */
+    QSharedPointer<Document> loadDocument(VLNV const& vlnv, DocumentInfo& info,
+        QSharedPointer<Document> readModel = QSharedPointer<Document>());
+
+    /*! Marks the cached document as the most recently used one and keeps the cache within its budget.
+     *
+     *    @param [in] vlnv    Identifies the document.
+     *    @param [in] info    The cache entry of the document.
+     */
+    void touchDocument(VLNV const& vlnv, DocumentInfo const& info);
+
+    /*! Drops the least recently used documents from the cache until it is within its budget.
+     *
+     * A dropped document still used elsewhere is not freed, so its memory is counted until the last user has
+     * released it.
+     */
+    void evictDocuments();
+
+    /*! Removes the bookkeeping of a cached document.
+     *
+     *    @param [in] vlnv    Identifies the document.
+     */
+    void dropCachedDocument(VLNV const& vlnv);
+
+    /*! Stores the current size and modification time of the document file.
+     *
+     *    @param [in/out] info    The document whose file to check.
+     */
+    void updateFileStamp(DocumentInfo& info) const;
+
+    /*! Finds the documents that reference the given document.
+     *
+     *    @param [in] vlnv    Identifies the referenced document.
+     *
+     *    @return The documents referencing the given document.
+     */
+    QVector<VLNV> findDependents(VLNV const& vlnv) const;
+
+    /*! Updates the dependency index with the references of the given document.
+     *
+     *    @param [in] vlnv            Identifies the document.
+     *    @param [in] dependencies    The VLNVs referenced by the document, or none if the document was removed.
+     */
+    void updateDependencies(VLNV const& vlnv, QVector<VLNV> const& dependencies);
+
+    /*! Validates the given items again.
+     *
+     *    @param [in] items   The items to validate.
+     */
+    void revalidateItems(QVector<VLNV> const& items);
+
+    /*! Validates again the items referencing the saved items, directly or through other items.
+     *
+     *    @param [in] savedItems  The saved items.
+     */
+    void revalidateDependents(QVector<VLNV> const& savedItems);
+
+    /*! Updates the views of an item whose validity has changed.
+     *
+     *    @param [in] vlnv    Identifies the item.
+     *    @param [in] valid   The new validity of the item.
+     */
+    void notifyValidityChanged(VLNV const& vlnv, bool valid);
+
     //! Shows the results of the library integrity check.
     void showIntegrityResults() const;
 
+    //! Stores the summaries of the read documents in the persistent library index.
+    void saveMetadata() const;
+
     /*!
      * Removes the given file from the file system.
      *
@@ -486,6 +828,35 @@ private:
      */
     bool validateDocument(QSharedPointer<Document> document, QString const& documentPath);
 
+    /*!
+     *  Check if the given document is valid IP-XACT using the given validator.
+     *
+     *    @param [in] document           The document to check.
+     *    @param [in] documentPath       The path to the document file on disk.
+     *    @param [in] validator          The validator to use.
+     *    @param [in/out] fileCount      The number of valid file references found.
+     *
+     *    @return True, if the document is valid, otherwise false.
+     */
+    bool validateDocument(QSharedPointer<Document> document, QString const& documentPath,
+        DocumentValidator& validator, int& fileCount);
+
+    /*!
+     *  Checks if the file of a document exists or is waiting to be written.
+     *
+     *    @param [in] documentPath    The path to the document file.
+     *
+     *    @return True, if the file exists, is queued to be written or is in a library archive, otherwise false.
+     */
+    bool documentFileExists(QString const& documentPath) const;
+
+    /*!
+     *  Validates the given documents in parallel. Each worker uses a validator of its own.
+     *
+     *    @param [in/out] documents   The documents to validate. The results are stored in the documents.
+     */
+    void validateDocumentsConcurrently(QVector<CheckedDocument>& documents);
+
 
     /*! Check the validity of VLNV references within a document.
      *
@@ -525,11 +896,13 @@ private:
 
     /*! Check the validity of file references within a document.
      *
-     *    @param [in] document    The document to check.
+     *    @param [in] document        The document to check.
+     *    @param [in] documentPath    The path to the document XML file.
+     *    @param [in/out] fileCount   The number of valid file references found.
      *
      *    @return True if the file references are valid, otherwise false.
      */
-    bool validateDependentFiles(QSharedPointer<Document> document, QString const& documentPath);
+    bool validateDependentFiles(QSharedPointer<Document> document, QString const& documentPath, int& fileCount);
 
     /*!
      *  Finds any errors within a given document file references.
@@ -555,12 +928,15 @@ private:
     //! Loads the library content.
     LibraryLoader loader_{ };
 
+    //! The VLNVs of the library items. Keeps the handles of the removed items, so they are never reused.
+    VLNVTable vlnvTable_;
+
     /*! Cache of documents in the library.
      *
-     * Key = VLNV that identifies the library object.
+     * Key = Handle of the VLNV that identifies the library object in vlnvTable_.
      * Value = Information on the document.
      */
-    QMap<VLNV, DocumentInfo> documentCache_;
+    DocumentCache documentCache_;
 
     //! Checks if the given string is a URL (invalids are allowed) or not.
     QRegularExpressionValidator urlTester_{ Utils::URL_VALIDITY_REG_EXP, this };
@@ -577,9 +953,121 @@ private:
     //! If true then items are being saved and library is not refreshed
     bool saveInProgress_{ false };
 
+    //! Writes the saved documents to the disk in the background.
+    DocumentWriteQueue writeQueue_;
+
+    //! The saved documents waiting to be written. Key = path to the file.
+    QMap<QString, VLNV> pendingSaves_;
+
+    //! The items added to the library during the current save, to be shown once the save ends.
+    QVector<VLNV> savedItems_;
+
+    //! The items saved during the current save, whose dependents are validated once the save ends.
+    QVector<VLNV> revalidatedItems_;
+
     //! Statistics for library integrity check.
     DocumentStatistics checkResults_;
 
+    //! If true, the integrity check after a library search is run in the background.
+    bool backgroundValidation_{ false };
+
+    //! The items waiting for the background integrity check.
+    QVector<VLNV> pendingChecks_;
+
+    //! The number of items in the running background integrity check.
+    int checkTotal_{ 0 };
+
+    //! Timer for running the background integrity check between events.
+    QTimer checkTimer_;
+
+    //! If true, the library directories are watched for changes.
+    bool watchLibrary_{ false };
+
+    //! Watcher for the directories in the active library locations.
+    QFileSystemWatcher libraryWatcher_;
+
+    //! The directories changed since the last incremental refresh.
+    QSet<QString> changedDirectories_;
+
+    //! Timer for collecting the file system changes into a single refresh.
+    QTimer refreshTimer_;
+
+    //! The directories in the active library locations found by the last library search.
+    QStringList libraryDirectories_;
+
+    //! The followed library directories, either watched or polled.
+    QSet<QString> followedDirectories_;
+
+    //! The directories waiting to be watched.
+    QStringList pendingWatches_;
+
+    //! Timer for watching the library directories a batch at a time between events.
+    QTimer watchTimer_;
+
+    //! The library locations on network file systems, whose directories are polled instead of watched.
+    QStringList polledLocations_;
+
+    //! A library directory checked for changes by polling.
+    struct PolledDirectory
+    {
+        QString path;               //!< The absolute path to the directory.
+        qint64 lastModified = -1;   //!< The modification time of the directory in ms since epoch.
+    };
+
+    //! The polled library directories.
+    QVector<PolledDirectory> polledDirectories_;
+
+    //! The position of the next directory to poll.
+    int pollPosition_{ 0 };
+
+    //! Timer for polling the library directories a batch at a time.
+    QTimer pollTimer_;
+
+    //! The results of the running progressive library search, shared with the worker thread.
+    QSharedPointer<LibraryLoader::ScanProgress> scanProgress_;
+
+    //! The worker running the progressive library search.
+    QFuture<void> scanTask_;
+
+    //! The items found by the running progressive library search, taken into use when the search finishes.
+    DocumentCache scanDocuments_;
+
+    //! The items saved during the running progressive library search.
+    QVector<VLNV> scanSavedItems_;
+
+    //! The directories found by the running progressive library search.
+    QStringList scanDirectories_;
+
+    //! Timer for taking the results of the progressive library search between events.
+    QTimer scanTimer_;
+
+    //! Measures the duration of the progressive library search.
+    QElapsedTimer scanClock_;
+
+    //! The memory budget for the parsed documents in the cache.
+    qint64 cacheBudget_{ 1024LL * 1024 * 1024 };
+
+    //! The estimated memory used by the parsed documents in the cache.
+    qint64 cachedBytes_{ 0 };
+
+    //! Counter for ordering the uses of the cached documents.
+    quint64 accessCount_{ 0 };
+
+    //! The parsed documents in the cache.
+    QHash<VLNVTable::Handle, CachedDocument> cachedDocuments_;
+
+    //! Statistics on the use of the document cache.
+    CacheStatistics cacheStatistics_;
+
+    //! Guards the document cache while the integrity check reads documents from several threads.
+    mutable QMutex cacheMutex_;
+
+    //! The documents referenced by each read document.
+    QHash<VLNVTable::Handle, QVector<VLNVTable::Handle> > dependencies_;
+
+    //! The read documents referencing each document.
+    QHash<VLNVTable::Handle, QVector<VLNVTable::Handle> > dependents_;
+
 };
 
 #endif // LIBRARYHANDLER_H
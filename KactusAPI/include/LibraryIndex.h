@@ -0,0 +1,110 @@
+//-----------------------------------------------------------------------------
+// File: LibraryIndex.h
+//-----------------------------------------------------------------------------
+// Project: Kactus2
+// Author: Kactus2 team
+// Date: 16.10.2026
+//
+// Description:
+// Persistent index of the IP-XACT files found in a single library location.
+//-----------------------------------------------------------------------------
+
+#ifndef LIBRARYINDEX_H
+#define LIBRARYINDEX_H
+
+#include "DocumentMetadata.h"
+
+#include <IPXACTmodels/common/VLNV.h>
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+
+//-----------------------------------------------------------------------------
+//! Persistent index of the IP-XACT files found in a single library location.
+//-----------------------------------------------------------------------------
+class LibraryIndex
+{
+public:
+
+    //! Indexed information of a single file.
+    struct Entry
+    {
+        QString path;               //!< The path to the file.
+        qint64 size = -1;           //!< The size of the file when it was indexed.
+        qint64 lastModified = 0;    //!< The modification time of the file in ms since epoch.
+        VLNV vlnv;                  //!< The VLNV in the file, invalid if the file is not an IP-XACT document.
+        DocumentMetadata metadata;  //!< The summary of the document, if it has been read.
+        QByteArray contentHash;     //!< The hash of the file content, if the whole file has been read.
+    };
+
+    /*! The constructor.
+     *
+     *    @param [in] location    The library location the index is for.
+     */
+    explicit LibraryIndex(QString const& location);
+
+    //! The destructor.
+    ~LibraryIndex() = default;
+
+    /*! Reads the index of the location from the disk.
+     *
+     *    @return True, if a valid index was found, otherwise false.
+     */
+    bool load();
+
+    /*! Writes the index of the location to the disk.
+     *
+     *    @return True, if the index was written, otherwise false.
+     */
+    bool save() const;
+
+    /*! Finds the indexed information for the given file.
+     *
+     *    @param [in] path    The path to the file.
+     *
+     *    @return The indexed information. If the file is not indexed, the size of the entry is negative.
+     */
+    Entry find(QString const& path) const;
+
+    /*! Checks if the indexed information of a file is still up to date.
+     *
+     *    @param [in] entry           The indexed information.
+     *    @param [in] size            The current size of the file.
+     *    @param [in] lastModified    The current modification time of the file in ms since epoch.
+     *
+     *    @return True, if the file has not changed after indexing, otherwise false.
+     */
+    static bool isCurrent(Entry const& entry, qint64 size, qint64 lastModified);
+
+    /*! Adds or replaces the information of a file in the index.
+     *
+     *    @param [in] entry   The information to add.
+     */
+    void insert(Entry const& entry);
+
+    /*! Removes a file from the index.
+     *
+     *    @param [in] path    The path to the file to remove.
+     */
+    void remove(QString const& path);
+
+    //! Removes all files from the index.
+    void clear();
+
+private:
+
+    /*! Gets the path to the index file of the location.
+     *
+     *    @return The path to the index file.
+     */
+    QString indexFilePath() const;
+
+    //! The library location.
+    QString location_;
+
+    //! The indexed files by their path.
+    QHash<QString, Entry> entries_;
+};
+
+#endif // LIBRARYINDEX_H
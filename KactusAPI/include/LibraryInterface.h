@@ -14,6 +14,9 @@
 
 #include <IPXACTmodels/common/VLNV.h>
 
+#include <KactusAPI/include/DocumentMetadata.h>
+#include <KactusAPI/include/SharedDocument.h>
+
 #include <QObject>
 #include <QSharedPointer>
 
@@ -31,6 +34,7 @@ public:
 
     /*! Get a model that matches given VLNV. Must be used when changes are made to the document.
      *  The provided document is a copy, meaning that it must be explicitly saved after the changes.
+     *  Use getModelReadOnly() or getSharedModel() when the document is only read.
      * 
      *    @param [in] vlnv    Identifies the desired document.
      *
@@ -71,6 +75,19 @@ public:
         return getModelReadOnly(vlnv).dynamicCast<T const>();
     }
 
+    /*! Get a handle to the model that matches given VLNV. The handle shares the library document until
+     *  it is explicitly edited, after which it refers to a private copy that must be saved after the changes.
+    *
+    *    @param [in] vlnv    Identifies the desired document.
+    *
+    *    @return The handle to the model that matches the document.
+    */
+    template <class T>
+    SharedDocument<T> getSharedModel(VLNV const& vlnv)
+    {
+        return SharedDocument<T>(getModelReadOnly<T>(vlnv));
+    }
+
     /*! Checks if the library already contains the specified VLNV.
      *
      *    @param [in] vlnv    The VLNV that is searched within the library.
@@ -230,6 +247,19 @@ public:
     */
     virtual bool isValid(VLNV const& vlnv) = 0;
 
+    /*! Get the summary of the identified object for filtering the library.
+     *
+     *    @param [in] vlnv    Identifies the object.
+     *
+     *    @return The summary of the object. Not known, if the object was not found in library.
+    */
+    virtual DocumentMetadata getMetadata(VLNV const& vlnv)
+    {
+        DocumentMetadata metadata = DocumentMetadata::fromDocument(getModelReadOnly(vlnv));
+        metadata.isValid = isValid(vlnv);
+        return metadata;
+    }
+
 public slots:
 
     /*! Check the library items for validity
@@ -12,6 +12,7 @@
 #ifndef LIBRARYITEM_H
 #define LIBRARYITEM_H
 
+#include <QHash>
 #include <QVector>
 #include <QString>
 #include <QObject>
@@ -248,6 +249,9 @@ private:
 	//! The child items of current item in the hierarchy.
 	QVector<LibraryItem*> childItems_;
 
+    //! The child items by their names for finding the child for a VLNV without going through all of them.
+    QHash<QString, LibraryItem*> childIndex_;
+
 	//! The parent of the item.
 	LibraryItem *parentItem_;
 
@@ -13,31 +13,119 @@
 #define LIBRARYLOADER_H
 
 #include "DocumentFileAccess.h"
+#include "LibraryIndex.h"
 
 #include <KactusAPI/include/MessageMediator.h>
 
 #include <IPXACTmodels/common/VLNV.h>
 
+#include <QMutex>
 #include <QObject>
+#include <QStringList>
+#include <QXmlStreamReader>
+
+#include <atomic>
 
 //-----------------------------------------------------------------------------
 //! Class for IP-XACT file search and type parsing.
 //-----------------------------------------------------------------------------
-class LibraryLoader 
+class KACTUS2_API LibraryLoader 
 {
 public:
 
 	//! Struct for load targets.
     struct LoadTarget
     {
-        QString path; //!< The path to IP-XACT file.
-        VLNV vlnv;    //!< The VLNV defined in the file.
+        QString path;               //!< The path to IP-XACT file.
+        VLNV vlnv;                  //!< The VLNV defined in the file.
+        qint64 size = -1;           //!< The size of the file when it was read.
+        qint64 lastModified = 0;    //!< The modification time of the file in ms since epoch.
+        DocumentMetadata metadata;  //!< The summary of the document, if known from the index.
+        QByteArray contentHash;     //!< The hash of the file content, if known from the index.
 
 		//! Constructor.
         LoadTarget(VLNV const& targetVLNV = VLNV(), QString targetPath = QString()): 
             path(targetPath), vlnv(targetVLNV) {}
     };
 
+    //-----------------------------------------------------------------------------
+    //! Passes the results of a library search running in a worker thread to the thread showing them.
+    //-----------------------------------------------------------------------------
+    class KACTUS2_API ScanProgress
+    {
+    public:
+
+        //! The results found since they were last taken.
+        struct Results
+        {
+            QVector<LoadTarget> targets;    //!< The found targets in the directory traversal order.
+            QStringList errors;             //!< The errors found in the files.
+            QStringList notices;            //!< The notices found in the files.
+            QStringList directories;        //!< The directories found in the library locations.
+        };
+
+        //! Asks the search to stop at the next file. The results found so far are kept.
+        void cancel();
+
+        /*! Checks if the search has been asked to stop.
+        *
+        *    @return True, if the search has been cancelled, otherwise false.
+        */
+        bool isCancelled() const;
+
+        /*! Checks if the search has ended. The last results may still be waiting to be taken.
+        *
+        *    @return True, if the search has ended, otherwise false.
+        */
+        bool isFinished() const;
+
+        /*! Gets the number of XML files found in the library locations so far.
+        *
+        *    @return The number of found files.
+        */
+        int foundFileCount() const;
+
+        /*! Gets the number of found files whose identifier has been read or taken from the index.
+        *
+        *    @return The number of scanned files.
+        */
+        int scannedFileCount() const;
+
+        /*! Takes the results found since the previous call.
+        *
+        *    @return The new results.
+        */
+        Results takeResults();
+
+    private:
+
+        friend class LibraryLoader;
+
+        /*! Adds a batch of results to be taken.
+        *
+        *    @param [in] results     The results to add.
+        */
+        void addResults(Results const& results);
+
+        //! Flag for stopping the search.
+        std::atomic<bool> cancelled_{ false };
+
+        //! Flag for the ended search.
+        std::atomic<bool> finished_{ false };
+
+        //! The number of XML files found so far.
+        std::atomic<int> foundFiles_{ 0 };
+
+        //! The number of files scanned so far.
+        std::atomic<int> scannedFiles_{ 0 };
+
+        //! Guards the results.
+        QMutex mutex_;
+
+        //! The results not yet taken.
+        Results results_;
+    };
+
 	/*! Cleans the directory structure.
 	*
 	*    @param [in] changedDirectories	Changed directories (e.g. after a remove).
@@ -46,19 +134,83 @@ public:
 
 	/*! Searches for IP-XACT files and returns any found targets.
 	*
+	*    The files of each library location are read concurrently. Files that have not changed since the
+	*    previous search are taken from the persistent index of the location without reading them.
+	*    The returned targets are always in the directory traversal order and all messages are reported
+	*    from the calling thread.
+	*
+	*    @param [in]  messageChannel The channel for reporting errors found in the files.
+	*    @param [out] directories    If given, receives the directories found in the library locations.
+	*
 	*    @return The found IP-XACT targets.
 	*/
-    QVector<LoadTarget> parseLibrary(MessageMediator const* messageChannel) const;
+    QVector<LoadTarget> parseLibrary(MessageMediator const* messageChannel,
+        QStringList* directories = nullptr) const;
+
+    /*! Searches for IP-XACT files, passing the found targets on in batches as the search proceeds.
+    *
+    *    The search is the same as in parseLibrary(), but the results are collected in the given progress
+    *    instead of returning them at the end. Can be run in a worker thread, while another thread takes the
+    *    results. The index of a location is not updated, if the search is cancelled before the location is
+    *    complete.
+    *
+    *    @param [in/out] progress    The progress to pass the results through.
+    */
+    void scanLibrary(ScanProgress& progress) const;
+
+    /*! Reads the IP-XACT identifier of a single file.
+    *
+    *    @param [in] path            The path to the file.
+    *    @param [in] messageChannel  The channel for reporting errors found in the file.
+    *
+    *    @return The target found in the file. If the file is not an IP-XACT document, the VLNV is invalid.
+    */
+    LoadTarget readFile(QString const& path, MessageMediator const* messageChannel) const;
+
+    /*! Stores the given targets in the persistent indices of their library locations.
+    *
+    *    Used for keeping the summaries of the documents read after the search for the next search.
+    *
+    *    @param [in] targets     The targets to store.
+    */
+    void updateIndex(QVector<LoadTarget> const& targets) const;
 
 private:
 
+    //! Result of reading the document identifier from a single file.
+    struct HeaderResult
+    {
+        QString path;               //!< The path to the read file.
+        qint64 size = -1;           //!< The size of the file.
+        qint64 lastModified = 0;    //!< The modification time of the file in ms since epoch.
+        bool changed = true;        //!< Flag for files that must be read instead of using the index.
+        VLNV vlnv;                  //!< The VLNV found in the file, invalid if none.
+        DocumentMetadata metadata;  //!< The summary of the document from the index, if any.
+        QByteArray contentHash;     //!< The hash of the file content from the index, if any.
+        QString error;              //!< Error found while reading the file.
+        QString notice;             //!< Notice found while reading the file.
+    };
+
     /*! Finds the VLNV in the given file.
     *
-    *    @param [in]		path	The file path to search.
+    *    Only the start of the file is read, unless the identifier does not fit in it. If the file has a content
+    *    hash from the index, the indexed information is kept when the content has not changed.
+    *    This function is run in worker threads and must not access any shared state.
+    *
+    *    @param [in]		file	The file to search.
+    *
+    *    @return The file with the found VLNV and any messages to report.
+    */
+    static HeaderResult getDocumentVLNV(HeaderResult const& file);
+
+    /*! Reads the document type and VLNV from the start of a document.
+    *
+    *    @param [in]     documentReader  The reader positioned at the start of the document.
+    *    @param [in/out] result          The file to store the found VLNV and any messages into.
     *
-    *    @return The VLNV found in the given file.
+    *    @return True, if the document was identified, false if the content ended before the identifier.
     */
-    VLNV getDocumentVLNV(QString const& path, MessageMediator const* messageChannel) const;
+    static bool readHeader(QXmlStreamReader& documentReader, HeaderResult& result);
 
     /*! Clear the empty directories from the disk within given path.
      *
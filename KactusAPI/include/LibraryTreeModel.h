@@ -220,6 +220,12 @@ public slots:
 	//! Add the specified vlnv branch to the tree.
 	void onAddVLNV(VLNV const& vlnv);
 
+    /*! Adds the branches of a batch of items found by a library search to the tree.
+     *
+     *    @param [in] vlnvs   Identifies the found items.
+     */
+    void onAddVLNVs(QVector<VLNV> const& vlnvs);
+
 	//! Reset the model.
 	void onResetModel();
 
@@ -0,0 +1,113 @@
+//-----------------------------------------------------------------------------
+// File: ResolvedValueCache.h
+//-----------------------------------------------------------------------------
+// Project: Kactus2
+// Author: Kactus2 team
+// Date: 16.10.2026
+//
+// Description:
+// Cache of resolved parameter values and the dependencies between the parameters.
+//-----------------------------------------------------------------------------
+
+#ifndef RESOLVEDVALUECACHE_H
+#define RESOLVEDVALUECACHE_H
+
+#include <KactusAPI/KactusAPIGlobal.h>
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+//-----------------------------------------------------------------------------
+//! Cache of resolved parameter values and the dependencies between the parameters.
+//!
+//! Each value is stored with the ids of the parameters referenced in its expression. Invalidating a value
+//! invalidates the values depending on it, directly or through other parameters, and keeps the rest.
+//-----------------------------------------------------------------------------
+class KACTUS2_API ResolvedValueCache
+{
+public:
+
+    //! A resolved parameter value.
+    struct Entry
+    {
+        QString expression;             //!< The value expression of the parameter when it was resolved.
+        QString value;                  //!< The resolved value.
+        QStringList dependencies;       //!< The ids of the parameters referenced in the expression.
+        QStringList unknownSymbols;     //!< The names in the expression that were not parameter ids.
+        quint64 verifiedPass = 0;       //!< The resolution pass in which the value was last found valid.
+    };
+
+    //! The constructor.
+    ResolvedValueCache() = default;
+
+    //! The destructor.
+    ~ResolvedValueCache() = default;
+
+    // Disable copying.
+    ResolvedValueCache(ResolvedValueCache const& rhs) = delete;
+    ResolvedValueCache& operator=(ResolvedValueCache const& rhs) = delete;
+
+    /*!
+     *  Finds the resolved value of a parameter.
+     *
+     *    @param [in] id  The id of the parameter.
+     *
+     *    @return The resolved value, or null if the value is not in the cache. Valid until the cache is changed.
+     */
+    Entry* find(QString const& id);
+
+    /*!
+     *  Stores the resolved value of a parameter, replacing any previous value.
+     *
+     *    @param [in] id      The id of the parameter.
+     *    @param [in] entry   The resolved value.
+     */
+    void insert(QString const& id, Entry const& entry);
+
+    /*!
+     *  Removes the value of a parameter and all the values depending on it.
+     *
+     *    @param [in] id  The id of the parameter.
+     */
+    void invalidate(QString const& id);
+
+    //! Removes all the values.
+    void clear();
+
+    /*!
+     *  Gets the ids of the parameters with a value in the cache.
+     *
+     *    @return The ids of the cached values.
+     */
+    QStringList ids() const;
+
+    /*!
+     *  Gets the number of values in the cache.
+     *
+     *    @return The number of resolved values.
+     */
+    int count() const;
+
+private:
+
+    /*!
+     *  Removes the value of a parameter and its references to the parameters it depends on.
+     *
+     *    @param [in] id  The id of the parameter.
+     */
+    void remove(QString const& id);
+
+    //-----------------------------------------------------------------------------
+    // Data.
+    //-----------------------------------------------------------------------------
+
+    //! The resolved values by the parameter ids.
+    QHash<QString, Entry> entries_;
+
+    //! The ids of the parameters referencing each parameter in their resolved values.
+    QHash<QString, QSet<QString> > dependents_;
+};
+
+#endif // RESOLVEDVALUECACHE_H
@@ -0,0 +1,99 @@
+//-----------------------------------------------------------------------------
+// File: SharedDocument.h
+//-----------------------------------------------------------------------------
+// Project: Kactus2
+// Author: Kactus2 team
+// Date: 16.10.2026
+//
+// Description:
+// Handle to a library document shared between readers and copied only when edited.
+//-----------------------------------------------------------------------------
+
+#ifndef SHAREDDOCUMENT_H
+#define SHAREDDOCUMENT_H
+
+#include <QSharedPointer>
+
+//-----------------------------------------------------------------------------
+//! Handle to a library document shared between readers and copied only when edited.
+//!
+//! The handle initially refers to the document snapshot held by the library. All readers of the same document
+//! share the snapshot. The first call to edit() promotes the handle to a private copy of the document, which
+//! must be saved to the library for the changes to become visible to others.
+//-----------------------------------------------------------------------------
+template <class T>
+class SharedDocument
+{
+public:
+
+    //! The constructor for an empty handle.
+    SharedDocument() = default;
+
+    /*!
+     *  The constructor.
+     *
+     *    @param [in] snapshot    The shared document snapshot.
+     */
+    explicit SharedDocument(QSharedPointer<T const> snapshot): snapshot_(snapshot) {}
+
+    //! The destructor.
+    ~SharedDocument() = default;
+
+    //! Copies share the snapshot. Copies of an edited handle also share its private copy.
+    SharedDocument(SharedDocument const& other) = default;
+    SharedDocument& operator=(SharedDocument const& other) = default;
+
+    /*!
+     *  Checks if the handle refers to a document.
+     *
+     *    @return True, if there is no document, otherwise false.
+     */
+    bool isNull() const { return snapshot_.isNull(); }
+
+    //! Checks if the handle refers to a document.
+    explicit operator bool() const { return snapshot_.isNull() == false; }
+
+    //! Read access to the document.
+    T const* operator->() const { return snapshot_.data(); }
+    T const& operator*() const { return *snapshot_; }
+
+    /*!
+     *  Gets the document for reading.
+     *
+     *    @return The shared snapshot, or the private copy after the handle has been edited.
+     */
+    QSharedPointer<T const> get() const { return snapshot_; }
+
+    /*!
+     *  Checks if the handle has been promoted to a private copy.
+     *
+     *    @return True, if edit() has been called for the handle, otherwise false.
+     */
+    bool isDetached() const { return writable_.isNull() == false; }
+
+    /*!
+     *  Gets the document for writing. The snapshot is copied on the first call.
+     *
+     *    @return The private, editable copy of the document.
+     */
+    QSharedPointer<T> edit()
+    {
+        if (writable_.isNull() && snapshot_.isNull() == false)
+        {
+            writable_ = snapshot_->clone().template staticCast<T>();
+            snapshot_ = writable_;
+        }
+
+        return writable_;
+    }
+
+private:
+
+    //! The document for read access.
+    QSharedPointer<T const> snapshot_;
+
+    //! The private copy of the document, once promoted for writing.
+    QSharedPointer<T> writable_;
+};
+
+#endif // SHAREDDOCUMENT_H
@@ -18,14 +18,28 @@
 
 #include <QString>
 #include <QMap>
+#include <QSharedPointer>
 
 //-----------------------------------------------------------------------------
 //! Parser for SystemVerilog expressions.
+//!
+//! Expressions are compiled into programs of classified tokens in Reverse Polish Notation, which are kept in
+//! a cache shared by all parsers. Evaluating an expression already in the cache only resolves the symbols and
+//! calculates the operations. The operators recognized by a parser class must therefore not depend on the
+//! state of the parser. The symbols are resolved every time the expression is evaluated.
 //-----------------------------------------------------------------------------
 class KACTUS2_API SystemVerilogExpressionParser : public ExpressionParser
 {
 public:
 
+    //! Statistics of the cache of compiled expressions.
+    struct CacheStatistics
+    {
+        qint64 hits = 0;        //!< The number of evaluations that found the expression compiled.
+        qint64 misses = 0;      //!< The number of evaluations that had to compile the expression.
+        int size = 0;           //!< The number of compiled expressions in the cache.
+    };
+
 	//! The constructor.
 	SystemVerilogExpressionParser() = default;
 
@@ -73,6 +87,27 @@ public:
      */
     int baseForExpression(QStringView expression) const override;
 
+    /*!
+     *  Parses an expression to decimal number and finds the common base in the expression.
+     *
+     *    @param [in]  expression         The expression to parse.
+     *    @param [out] validExpression    Set to true, if the parsing was successful, otherwise false.
+     *    @param [out] base               Set to the common base for the expression.
+     *
+     *    @return The decimal value of the evaluated expression.
+     */
+    QString parseExpressionWithBase(QStringView expression, bool* validExpression, int* base) const override;
+
+    /*!
+     *  Gets the statistics of the cache of compiled expressions shared by all parsers.
+     *
+     *    @return The cache statistics.
+     */
+    static CacheStatistics cacheStatistics();
+
+    //! Empties the cache of compiled expressions and resets its statistics.
+    static void clearCache();
+
 protected:
      
     /*!
@@ -130,7 +165,8 @@ protected:
     virtual bool isUnaryOperator(QStringView token) const;
 
     /*!
-     *  Solves a binary operation.
+     *  Solves a unary operation. Negation, bitwise inversion and $clog2 of integers are solved without
+     *  calling this.
      *
      *    @param [in] operation    The operation to solve.
      *    @param [in] term         The term for the operation.
@@ -141,6 +177,37 @@ protected:
 
 private:
 
+    //! An expression compiled for evaluation.
+    struct CompiledExpression;
+
+    //! The cache of compiled expressions.
+    struct ExpressionCache;
+
+    /*!
+     *  Gets the cache of compiled expressions.
+     *
+     *    @return The cache shared by all parsers.
+     */
+    static ExpressionCache& expressionCache();
+
+    /*!
+     *  Gets the compiled form of the given expression, compiling it if it is not yet in the cache.
+     *
+     *    @param [in] expression   The expression to compile.
+     *
+     *    @return The compiled expression.
+     */
+    QSharedPointer<CompiledExpression const> compiledExpression(QStringView expression) const;
+
+    /*!
+     *  Compiles the given expression by converting it to RPN and classifying the tokens.
+     *
+     *    @param [in] expression   The expression to compile.
+     *
+     *    @return The compiled expression.
+     */
+    QSharedPointer<CompiledExpression const> compile(QStringView expression) const;
+
     /*!
      *  Converts the given expression to Reverse Polish Notation (RPN) format.
      *  RPN is used to ensure the operations are calculated in the correct precedence order.
@@ -152,14 +219,23 @@ private:
     static QVector<QStringView> convertToRPN(QString& expression);
 
     /*!
-     *  Solves the given RPN expression.
+     *  Solves the given compiled expression.
      *
-     *    @param [in]     rpn                The expression to solve.
+     *    @param [in]     program            The expression to solve.
      *    @param [out]    validExpression    Set to true, if the parsing was successful, otherwise false.
      *
      *    @return The solved result.
      */
-    QString solveRPN(QVector<QStringView> rpn, bool* validExpression) const;
+    QString solveRPN(CompiledExpression const& program, bool* validExpression) const;
+
+    /*!
+     *  Finds the common base in the given compiled expression.
+     *
+     *    @param [in] program   The expression to search in.
+     *
+     *    @return The greatest base of the literals and symbols in the expression.
+     */
+    int commonBase(CompiledExpression const& program) const;
 
     /*!
      *  Checks if the given expression is a string.
@@ -198,19 +274,8 @@ private:
     bool isTernaryOperator(QStringView token) const;
 
     /*!
-     *  Solves a Ternary operation.
-     *
-     *    @param [in] condition   The selecting condition of the ternary operation.
-     *    @param [in] trueCase    The value for true condition.
-     *    @param [in] falseCase   The value for false condition.
-     *
-     *    @return The result of the operation.
-     */
-    QString solveTernary(QStringView condition, QString const& trueCase, QString const& falseCase) const;
-
-
-    /*!
-     *  Solves a binary operation.
+     *  Solves a binary operation on terms in their textual form. Operations on integers fitting in 64 bits
+     *  are solved without calling this.
      *
      *    @param [in] operation   The operation to solve.
      *    @param [in] leftTerm    The first term of the operation.
@@ -0,0 +1,175 @@
+//-----------------------------------------------------------------------------
+// File: Tracing.h
+//-----------------------------------------------------------------------------
+// Project: Kactus2
+// Author: Kactus2 team
+// Date: 16.10.2026
+//
+// Description:
+// Lightweight recording of timed spans for finding out where the time goes in a run.
+//-----------------------------------------------------------------------------
+
+#ifndef TRACING_H
+#define TRACING_H
+
+#include <KactusAPI/KactusAPIGlobal.h>
+
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+#include <functional>
+
+//-----------------------------------------------------------------------------
+//! Lightweight recording of timed spans for finding out where the time goes in a run.
+//!
+//! Spans are marked in the code with KACTUS2_TRACE_SCOPE, which times the enclosing scope. The spans are
+//! recorded only while tracing is enabled, into a ring buffer keeping the latest events. The buffer can be
+//! written in the Chrome trace event format at any time, and is written at exit when an output file has
+//! been set, e.g. with the environment variable KACTUS2_TRACE_FILE. Defining KACTUS2_NO_TRACING removes
+//! the spans from the code altogether.
+//!
+//! Each recorded span takes a lock and a slot in the buffer, so spans are meant for coarse operations, e.g.
+//! loading or scanning the library, validating a document or opening a diagram. Frequent operations, such as
+//! evaluating a single expression, are better followed with counters.
+//!
+//! Statistics kept elsewhere, e.g. the hits of a cache, can be added to the trace as counters. The counters are
+//! read when the trace is written.
+//-----------------------------------------------------------------------------
+namespace Tracing
+{
+    //! Named counter values.
+    using Counters = QVector<QPair<QString, qint64> >;
+
+    //! Function reading the current values of a group of counters.
+    using CounterSource = std::function<Counters()>;
+
+    /*!
+     *  Checks if the spans are being recorded.
+     *
+     *    @return True, if tracing is enabled, otherwise false.
+     */
+    KACTUS2_API bool isEnabled();
+
+    /*!
+     *  Starts or stops recording the spans.
+     *
+     *    @param [in] enabled     The new state of tracing.
+     */
+    KACTUS2_API void setEnabled(bool enabled);
+
+    /*!
+     *  Sets the number of events kept in the ring buffer. Clears the recorded events.
+     *
+     *    @param [in] eventCount  The maximum number of events to keep.
+     */
+    KACTUS2_API void setCapacity(int eventCount);
+
+    //! Clears the recorded events.
+    KACTUS2_API void clear();
+
+    /*!
+     *  Enables tracing and sets the file to write the trace into when the application exits.
+     *
+     *    @param [in] path    The path to the trace file.
+     */
+    KACTUS2_API void setOutputFile(QString const& path);
+
+    //! Enables tracing, if the environment variable KACTUS2_TRACE_FILE names an output file.
+    KACTUS2_API void enableFromEnvironment();
+
+    /*!
+     *  Writes the recorded events in the Chrome trace event format.
+     *
+     *    @param [in] path    The path to the trace file.
+     *
+     *    @return True, if the file was written, otherwise false.
+     */
+    KACTUS2_API bool writeChromeTrace(QString const& path);
+
+    /*!
+     *  Adds a group of counters to be written with the trace.
+     *
+     *    @param [in] name    The name of the counter group. Must be a string literal.
+     *    @param [in] source  The function reading the counter values. Must be safe to call from any thread.
+     */
+    KACTUS2_API void addCounters(char const* name, CounterSource const& source);
+
+    //-----------------------------------------------------------------------------
+    //! Times the scope it is created in and records it when destroyed. Use with KACTUS2_TRACE_SCOPE.
+    //-----------------------------------------------------------------------------
+    class KACTUS2_API Span
+    {
+    public:
+
+        /*!
+         *  The constructor.
+         *
+         *    @param [in] category    The category of the span. Must be a string literal.
+         *    @param [in] name        The name of the span. Must be a string literal.
+         */
+        Span(char const* category, char const* name);
+
+        //! The destructor. Records the span.
+        ~Span();
+
+        //! No copying.
+        Span(Span const& other) = delete;
+        Span& operator=(Span const& other) = delete;
+
+        /*!
+         *  Checks if the span is recorded.
+         *
+         *    @return True, if tracing was enabled when the span started, otherwise false.
+         */
+        bool isRecording() const { return recording_; }
+
+        /*!
+         *  Sets additional information on the span, e.g. the name of the processed item.
+         *
+         *    @param [in] detail  The information to show with the span.
+         */
+        void setDetail(QString const& detail) { detail_ = detail; }
+
+    private:
+
+        //! The category of the span.
+        char const* category_;
+
+        //! The name of the span.
+        char const* name_;
+
+        //! Additional information on the span.
+        QString detail_;
+
+        //! The start time of the span in nanoseconds.
+        qint64 start_{ 0 };
+
+        //! True, if the span is recorded.
+        bool recording_{ false };
+    };
+}
+
+#define KACTUS2_TRACE_CONCAT_IMPL(first, second) first##second
+#define KACTUS2_TRACE_CONCAT(first, second) KACTUS2_TRACE_CONCAT_IMPL(first, second)
+
+#ifndef KACTUS2_NO_TRACING
+
+//! Records the time spent in the enclosing scope.
+#define KACTUS2_TRACE_SCOPE(category, name) \
+    Tracing::Span KACTUS2_TRACE_CONCAT(traceSpan_, __LINE__)(category, name)
+
+//! Records the time spent in the enclosing scope with additional information evaluated only when recording.
+#define KACTUS2_TRACE_SCOPE_DETAIL(category, name, detail) \
+    KACTUS2_TRACE_SCOPE(category, name); \
+    if (KACTUS2_TRACE_CONCAT(traceSpan_, __LINE__).isRecording()) \
+        KACTUS2_TRACE_CONCAT(traceSpan_, __LINE__).setDetail(detail)
+
+#else
+
+#define KACTUS2_TRACE_SCOPE(category, name) do {} while (false)
+#define KACTUS2_TRACE_SCOPE_DETAIL(category, name, detail) do {} while (false)
+
+#endif // KACTUS2_NO_TRACING
+
+#endif // TRACING_H
@@ -0,0 +1,126 @@
+//-----------------------------------------------------------------------------
+// File: VLNVTable.h
+//-----------------------------------------------------------------------------
+// Project: Kactus2
+// Author: Kactus2 team
+// Date: 16.10.2026
+//
+// Description:
+// Table of interned VLNVs identified by compact integer handles.
+//-----------------------------------------------------------------------------
+
+#ifndef VLNVTABLE_H
+#define VLNVTABLE_H
+
+#include <KactusAPI/KactusAPIGlobal.h>
+
+#include <IPXACTmodels/common/VLNV.h>
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+//-----------------------------------------------------------------------------
+//! Table of interned VLNVs identified by compact integer handles.
+//!
+//! Each distinct VLNV is stored once and given a handle that stays the same for the lifetime of the table, so
+//! the handle can be used as a key instead of the VLNV. VLNVs get the same handle, if their vendor, library,
+//! name and version are identical, like the keys of an ordered map of VLNVs. The type of the VLNV is not part
+//! of the identity. The fields of the stored VLNVs share their string data, so e.g. the vendor and library
+//! names are stored only once however many VLNVs refer to them.
+//-----------------------------------------------------------------------------
+class KACTUS2_API VLNVTable
+{
+public:
+
+    //! Handle of an interned VLNV.
+    using Handle = int;
+
+    //! The handle for VLNVs not in the table.
+    static constexpr Handle INVALID_HANDLE = -1;
+
+    //! The constructor.
+    VLNVTable() = default;
+
+    //! The destructor.
+    ~VLNVTable() = default;
+
+    // Disable copying.
+    VLNVTable(VLNVTable const& rhs) = delete;
+    VLNVTable& operator=(VLNVTable const& rhs) = delete;
+
+    /*! Adds a VLNV to the table, unless it is already there.
+     *
+     *    The type of a VLNV already in the table is replaced with the type of the given VLNV.
+     *
+     *    @param [in] vlnv    The VLNV to add.
+     *
+     *    @return The handle of the VLNV.
+     */
+    Handle insert(VLNV const& vlnv);
+
+    /*! Finds the handle of a VLNV.
+     *
+     *    @param [in] vlnv    The VLNV to find.
+     *
+     *    @return The handle of the VLNV, or INVALID_HANDLE if the VLNV is not in the table.
+     */
+    Handle find(VLNV const& vlnv) const;
+
+    /*! Gets the VLNV of a handle.
+     *
+     *    @param [in] handle  The handle of the VLNV.
+     *
+     *    @return The interned VLNV, or an invalid VLNV if the handle is not in the table.
+     */
+    VLNV vlnv(Handle handle) const;
+
+    /*! Gets the number of VLNVs in the table.
+     *
+     *    @return The number of interned VLNVs.
+     */
+    int count() const;
+
+    /*! Gets the number of distinct strings shared by the interned VLNVs.
+     *
+     *    @return The number of stored strings.
+     */
+    int stringCount() const;
+
+private:
+
+    //! Key for finding the handle of a VLNV by its exact fields.
+    struct Key
+    {
+        VLNV vlnv;      //!< The VLNV to identify.
+
+        //! Compares the fields case-sensitively, unlike the comparison of VLNVs.
+        bool operator==(Key const& other) const;
+    };
+
+    friend size_t qHash(Key const& key, size_t seed) noexcept;
+
+    /*! Gets the stored copy of a string, adding it to the storage if it is not there yet.
+     *
+     *    @param [in] text    The string to store.
+     *
+     *    @return The stored string sharing its data with the other copies.
+     */
+    QString internString(QString const& text);
+
+    //-----------------------------------------------------------------------------
+    // Data.
+    //-----------------------------------------------------------------------------
+
+    //! The handles of the VLNVs.
+    QHash<Key, Handle> handles_;
+
+    //! The interned VLNVs indexed by their handles.
+    QVector<VLNV> vlnvs_;
+
+    //! The shared strings of the VLNV fields.
+    QSet<QString> strings_;
+};
+
+#endif // VLNVTABLE_H
@@ -0,0 +1,192 @@
+//-----------------------------------------------------------------------------
+// File: WideInteger.h
+//-----------------------------------------------------------------------------
+// Project: Kactus2
+// Author: Kactus2 team
+// Date: 16.10.2026
+//
+// Description:
+// Signed 128-bit integer for expression results that do not fit in 64 bits.
+//-----------------------------------------------------------------------------
+
+#ifndef WIDEINTEGER_H
+#define WIDEINTEGER_H
+
+#include <KactusAPI/KactusAPIGlobal.h>
+
+#include <QString>
+#include <QStringView>
+
+//-----------------------------------------------------------------------------
+//! Signed 128-bit integer for expression results that do not fit in 64 bits.
+//!
+//! Covers e.g. the unsigned 64-bit values of address ranges, such as 2**64 - 1. The value is kept in two's
+//! complement in two 64-bit halves, so it does not depend on compiler support for 128-bit types. Operations that
+//! would overflow 128 bits report it instead of wrapping around.
+//-----------------------------------------------------------------------------
+class KACTUS2_API WideInteger
+{
+public:
+
+    //! The constructor. Creates a zero value.
+    WideInteger() = default;
+
+    /*!
+     *  Creates a value from a 64-bit integer.
+     *
+     *    @param [in] value   The integer.
+     */
+    explicit WideInteger(qint64 value) noexcept;
+
+    /*!
+     *  Reads a value from its decimal form.
+     *
+     *    @param [in]  text       The decimal digits with an optional minus sign.
+     *    @param [out] result     The read value.
+     *
+     *    @return True, if the text is a decimal integer that fits in 128 bits, otherwise false.
+     */
+    static bool fromDecimal(QStringView text, WideInteger& result) noexcept;
+
+    /*!
+     *  Checks if the value fits in a 64-bit integer.
+     *
+     *    @return True, if the value is within the 64-bit range, otherwise false.
+     */
+    bool fitsInteger() const noexcept;
+
+    /*!
+     *  Gets the low 64 bits of the value as an integer.
+     *
+     *    @return The value, if it fits in 64 bits.
+     */
+    qint64 toInteger() const noexcept { return static_cast<qint64>(low_); }
+
+    //! Checks if the value is negative.
+    bool isNegative() const noexcept { return static_cast<qint64>(high_) < 0; }
+
+    //! Checks if the value is zero.
+    bool isZero() const noexcept { return high_ == 0 && low_ == 0; }
+
+    /*!
+     *  Gets the value as a real number.
+     *
+     *    @return The nearest real number.
+     */
+    double toDouble() const noexcept;
+
+    /*!
+     *  Gets the decimal form of the value.
+     *
+     *    @return The value as text.
+     */
+    QString toString() const;
+
+    /*!
+     *  Compares two values.
+     *
+     *    @param [in] left    The left value.
+     *    @param [in] right   The right value.
+     *
+     *    @return Negative, zero or positive, if the left value is less than, equal to or greater than the right.
+     */
+    static int compare(WideInteger const& left, WideInteger const& right) noexcept;
+
+    /*!
+     *  The arithmetic operations. Each returns false without changing the result, if the result would not fit
+     *  in 128 bits or the operation is undefined, e.g. a division by zero.
+     *
+     *    @param [in]  left       The left operand.
+     *    @param [in]  right      The right operand.
+     *    @param [out] result     The result of the operation.
+     *
+     *    @return True, if the result was calculated, otherwise false.
+     */
+    static bool add(WideInteger const& left, WideInteger const& right, WideInteger& result) noexcept;
+    static bool subtract(WideInteger const& left, WideInteger const& right, WideInteger& result) noexcept;
+    static bool multiply(WideInteger const& left, WideInteger const& right, WideInteger& result) noexcept;
+    static bool divide(WideInteger const& left, WideInteger const& right, WideInteger& result) noexcept;
+    static bool modulo(WideInteger const& left, WideInteger const& right, WideInteger& result) noexcept;
+    static bool power(WideInteger const& base, qint64 exponent, WideInteger& result) noexcept;
+    static bool negate(WideInteger const& value, WideInteger& result) noexcept;
+
+    /*!
+     *  Shifts the value left, discarding the bits above 128 bits.
+     *
+     *    @param [in] count   The number of bits to shift, from 0 to 127.
+     *
+     *    @return The shifted value.
+     */
+    WideInteger shiftedLeft(int count) const noexcept;
+
+    /*!
+     *  Shifts the value right, keeping the sign.
+     *
+     *    @param [in] count   The number of bits to shift, from 0 to 127.
+     *
+     *    @return The shifted value.
+     */
+    WideInteger shiftedRight(int count) const noexcept;
+
+    /*!
+     *  Gets the number of bits needed to represent a non-negative value.
+     *
+     *    @return The position of the highest set bit plus one, or 0 for zero.
+     */
+    int bitLength() const noexcept;
+
+    //! The bitwise operations.
+    WideInteger operator~() const noexcept;
+    WideInteger operator&(WideInteger const& other) const noexcept;
+    WideInteger operator|(WideInteger const& other) const noexcept;
+    WideInteger operator^(WideInteger const& other) const noexcept;
+
+private:
+
+    /*!
+     *  Creates a value from its halves.
+     *
+     *    @param [in] high    The high 64 bits.
+     *    @param [in] low     The low 64 bits.
+     */
+    WideInteger(quint64 high, quint64 low) noexcept : high_(high), low_(low) {}
+
+    /*!
+     *  Gets the magnitude of the value as an unsigned 128-bit value.
+     *
+     *    @return The absolute value. The magnitude of the smallest value is 2^127.
+     */
+    WideInteger magnitude() const noexcept;
+
+    /*!
+     *  Divides two unsigned 128-bit values.
+     *
+     *    @param [in]  dividend   The dividend.
+     *    @param [in]  divisor    The divisor, not zero.
+     *    @param [out] quotient   The quotient.
+     *    @param [out] remainder  The remainder.
+     */
+    static void divideUnsigned(WideInteger const& dividend, WideInteger const& divisor, WideInteger& quotient,
+        WideInteger& remainder) noexcept;
+
+    /*!
+     *  Applies a sign to an unsigned 128-bit magnitude.
+     *
+     *    @param [in]  magnitude  The magnitude.
+     *    @param [in]  negative   Flag for a negative result.
+     *    @param [out] result     The signed result.
+     *
+     *    @return True, if the signed value fits in 128 bits, otherwise false.
+     */
+    static bool withSign(WideInteger const& magnitude, bool negative, WideInteger& result) noexcept;
+
+    //! The high 64 bits.
+    quint64 high_ = 0;
+
+    //! The low 64 bits.
+    quint64 low_ = 0;
+};
+
+Q_DECLARE_TYPEINFO(WideInteger, Q_PRIMITIVE_TYPE);
+
+#endif // WIDEINTEGER_H
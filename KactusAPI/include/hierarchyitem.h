@@ -24,9 +24,11 @@
 #include <IPXACTmodels/kactusExtensions/KactusAttribute.h>
 
 #include <KactusAPI/KactusAPIGlobal.h>
+#include <KactusAPI/include/DocumentMetadata.h>
 
 #include <QObject>
 #include <QSharedPointer>
+#include <QHash>
 #include <QList>
 #include <QMap>
 
@@ -78,7 +80,7 @@ public:
 	HierarchyItem(LibraryInterface* handler, QObject* parent);
 
     //! The destructor
-    virtual ~HierarchyItem() = default;
+    virtual ~HierarchyItem();
 
 	/*! Create a child for the HierarchyItem that represents the given VLNV.
 	 * 
@@ -88,6 +90,23 @@ public:
 	 */
 	void createChild(const VLNV& vlnv);
 
+	/*! Create a child for the given VLNV at the given position.
+	 *
+	 *    @param [in] index           The position of the new child.
+	 *    @param [in] vlnv            Identifies the item to represent.
+	 *    @param [in] implementation  The implementation attribute needed by designs.
+	 *    @param [in] viewName        The name of the view the design belongs to.
+	 */
+	void insertChild(int index, VLNV const& vlnv,
+		KactusAttribute::Implementation implementation = KactusAttribute::KTS_IMPLEMENTATION_COUNT,
+		QString const& viewName = QString());
+
+	/*! Remove the child at the given position.
+	 *
+	 *    @param [in] index   The position of the child to remove.
+	 */
+	void removeChild(int index);
+
 
 	/*! Get the parent of this item.
 	 *
@@ -166,12 +185,6 @@ public:
 	*/
 	void cleanUp();
 	
-	/*! Get pointer to the component that this item represents
-	 *
-	 *    @return QSharedPointer<Component> The component model.
-	*/
-	QSharedPointer<Component const> component() const;
-
 	/*! Count how many instances of given vlnv is found under this item.
 	 *
 	 * This function does not check if the same owner is counted multiple times
@@ -204,6 +217,8 @@ public:
 	int removeItems(const VLNV& vlnv);
 
 	/*! Find the hierarchyItems that represent the given vlnv.
+	 *
+	 * The root item finds the items from its index without searching the hierarchy.
 	 *
 	 *    @param [in] vlnv Identifies the items.
 	 *
@@ -364,11 +379,11 @@ private:
     /*!
      *  Finds the referenced design in a component view.
      *
-     *    @param [in] view   The view whose reference to find.
+     *    @param [in] viewReference   The design or design configuration referenced in the view.
      *
      *    @return The design referenced in the view.
      */
-    VLNV findDesignReference(QSharedPointer<View> view);
+    VLNV findDesignReference(VLNV const& viewReference);
 
     /*!
      *  Creates a child item for the given design.
@@ -417,9 +432,11 @@ private:
     /*!
      *  Finds the valid component references in a design item.
      *
+     *    @param [in] design  The summary of the design.
+     *
      *    @return The valid VLVN references.
      */
-    QVector<VLNV> getValidComponentsInDesign(QSharedPointer<Design const> design);
+    QVector<VLNV> getValidComponentsInDesign(DocumentMetadata const& design);
 
     /*!
      *  Checks if the given VLNV reference to a component is valid.
@@ -437,8 +454,11 @@ private:
     //! The VLNV this item represents.
     VLNV vlnv_;
 
-	//! The component that this hierarhcyItem represents.
-	QSharedPointer<Component const> component_;
+	//! The implementation of the component that this item represents.
+	KactusAttribute::Implementation implementation_;
+
+	//! Flag for a hierarchical component.
+	bool isHierarchical_;
 
 	//! The object that manages the library.
 	LibraryInterface* library_;
@@ -463,6 +483,12 @@ private:
 
 	//! The name of the view a design belongs to.
 	QString viewName_;
+
+    //! The root item of the hierarchy this item belongs to.
+    HierarchyItem* rootItem_;
+
+    //! The items in the hierarchy indexed by the VLNV they represent. Only used in the root item.
+    QHash<VLNV, QVector<HierarchyItem*> > itemIndex_;
 };
 
 #endif // HIERARCHYITEM_H
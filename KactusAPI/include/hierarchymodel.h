@@ -204,6 +204,20 @@ public slots:
 
     //! Remove the specified vlnv from the tree.
     void onRemoveVLNV(VLNV const& vlnv);
+
+    /*! Add the specified vlnv to the tree.
+     *
+     *    @param [in] vlnv Identifies the document that was added to the library.
+    */
+    void onAddVLNV(VLNV const& vlnv);
+
+    /*! Rebuild the items of a document whose content has changed.
+     *
+     * Unlike onDocumentUpdated(), the sub-items of the document are also recreated.
+     *
+     *    @param [in] vlnv Identifies the document that changed.
+    */
+    void onReloadVLNV(VLNV const& vlnv);
     
     /*! This function should be called when an IP-XACT document has changed.
      * 
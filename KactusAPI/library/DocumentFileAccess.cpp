@@ -43,70 +43,179 @@
 #include <IPXACTmodels/kactusExtensions/ComDefinitionWriter.h>
 #include <IPXACTmodels/kactusExtensions/ApiDefinitionWriter.h>
 
+#include <KactusAPI/include/LibraryArchive.h>
 #include <KactusAPI/include/MessageMediator.h>
+#include <KactusAPI/include/Tracing.h>
 
+#include <QBuffer>
+#include <QCryptographicHash>
 #include <QObject>
 #include <QDomElement>
+#include <QSaveFile>
+#include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 
-//-----------------------------------------------------------------------------
-// Function: DocumentFileAccess::readDocument()
-//-----------------------------------------------------------------------------
-QSharedPointer<Document> DocumentFileAccess::readDocument(QString const& path)
+namespace
 {
-    // Create file handle and use it to read the IP-XACT document into memory.
-    QFile file(path);
-    file.open(QIODevice::ReadOnly);
-
-    QDomDocument doc;
-    if (!doc.setContent(&file))
+    //! Opens a file either from the file system or from a library archive for reading.
+    QIODevice* openContent(QString const& path, QFile& file, QBuffer& archivedFile)
     {
-        file.close();        
-        return QSharedPointer<Document>();
-    }
-    file.close();
+        if (LibraryArchive::isArchiveEntry(path))
+        {
+            QByteArray content;
+            if (!LibraryArchive::readEntry(path, content))
+            {
+                return nullptr;
+            }
 
-    VLNV::IPXactType toCreate = VLNV::string2Type(doc.documentElement().nodeName());
+            archivedFile.setData(content);
+            archivedFile.open(QIODevice::ReadOnly);
+            return &archivedFile;
+        }
 
-    // Create correct type of object.
-    if (toCreate == VLNV::ABSTRACTIONDEFINITION)
-    {
-        return AbstractionDefinitionReader::createAbstractionDefinitionFrom(doc);
-    }
-    else if (toCreate == VLNV::BUSDEFINITION)
-    {
-        return BusDefinitionReader::createBusDefinitionFrom(doc);
-    }
-    else if (toCreate == VLNV::CATALOG)
-    {   
-        return CatalogReader::createCatalogFrom(doc);
-    }
-    else if (toCreate == VLNV::COMPONENT)
-    {
-        ComponentReader reader;
-        return reader.createComponentFrom(doc);
-    }
-    else if (toCreate == VLNV::DESIGN)
-    {
-        return DesignReader::createDesignFrom(doc);
+        file.setFileName(path);
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            return nullptr;
+        }
+
+        return &file;
     }
-    else if (toCreate == VLNV::DESIGNCONFIGURATION)
+
+    //! Calculates the hash of the content of the given device and rewinds it for reading the content again.
+    QByteArray hashContent(QIODevice& device)
     {
-        return DesignConfigurationReader::createDesignConfigurationFrom(doc);
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        hash.addData(&device);
+        device.seek(0);
+
+        return hash.result();
     }
 
-    else if (toCreate == VLNV::APIDEFINITION)
+    //! Creates the model of the given document tree.
+    QSharedPointer<Document> createDocumentFrom(QDomDocument const& doc)
     {
-        return ApiDefinitionReader::createApiDefinitionFrom(doc);
+        VLNV::IPXactType toCreate = VLNV::string2Type(doc.documentElement().nodeName());
+
+        // Create correct type of object.
+        if (toCreate == VLNV::ABSTRACTIONDEFINITION)
+        {
+            return AbstractionDefinitionReader::createAbstractionDefinitionFrom(doc);
+        }
+        else if (toCreate == VLNV::BUSDEFINITION)
+        {
+            return BusDefinitionReader::createBusDefinitionFrom(doc);
+        }
+        else if (toCreate == VLNV::CATALOG)
+        {   
+            return CatalogReader::createCatalogFrom(doc);
+        }
+        else if (toCreate == VLNV::COMPONENT)
+        {
+            ComponentReader reader;
+            return reader.createComponentFrom(doc);
+        }
+        else if (toCreate == VLNV::DESIGN)
+        {
+            return DesignReader::createDesignFrom(doc);
+        }
+        else if (toCreate == VLNV::DESIGNCONFIGURATION)
+        {
+            return DesignConfigurationReader::createDesignConfigurationFrom(doc);
+        }
+
+        else if (toCreate == VLNV::APIDEFINITION)
+        {
+            return ApiDefinitionReader::createApiDefinitionFrom(doc);
+        }
+        else if (toCreate == VLNV::COMDEFINITION)
+        {
+            return ComDefinitionReader::createComDefinitionFrom(doc);
+        }
+        else
+        {
+            return QSharedPointer<Document>();
+        }
     }
-    else if (toCreate == VLNV::COMDEFINITION)
+
+    //! Reads the document from given path. The hash of the file content is calculated, if requested.
+    QSharedPointer<Document> readModel(QString const& path, QByteArray* contentHash)
     {
-        return ComDefinitionReader::createComDefinitionFrom(doc);
+        KACTUS2_TRACE_SCOPE_DETAIL("library", "DocumentFileAccess::readDocument", path);
+
+        QFile file;
+        QBuffer archivedFile;
+        QIODevice* content = openContent(path, file, archivedFile);
+        if (content == nullptr)
+        {
+            return QSharedPointer<Document>();
+        }
+
+        if (contentHash)
+        {
+            *contentHash = hashContent(*content);
+        }
+
+        // Components are streamed to avoid holding the whole document tree of large components in memory.
+        // Other documents, and components that fail to stream, are read with the DOM parser.
+        QXmlStreamReader rootReader(content);
+        rootReader.setNamespaceProcessing(false);
+        if (rootReader.readNextStartElement() &&
+            VLNV::string2Type(rootReader.qualifiedName().toString()) == VLNV::COMPONENT)
+        {
+            content->seek(0);
+
+            QXmlStreamReader componentStream(content);
+            ComponentReader reader;
+            QSharedPointer<Component> component = reader.createComponentFrom(componentStream);
+            if (component)
+            {
+                return component;
+            }
+        }
+
+        content->seek(0);
+
+        QDomDocument doc;
+        if (!doc.setContent(content))
+        {
+            return QSharedPointer<Document>();
+        }
+
+        return createDocumentFrom(doc);
     }
-    else
+}
+
+//-----------------------------------------------------------------------------
+// Function: DocumentFileAccess::readDocument()
+//-----------------------------------------------------------------------------
+QSharedPointer<Document> DocumentFileAccess::readDocument(QString const& path)
+{
+    return readModel(path, nullptr);
+}
+
+//-----------------------------------------------------------------------------
+// Function: DocumentFileAccess::readDocument()
+//-----------------------------------------------------------------------------
+QSharedPointer<Document> DocumentFileAccess::readDocument(QString const& path, QByteArray& contentHash)
+{
+    return readModel(path, &contentHash);
+}
+
+//-----------------------------------------------------------------------------
+// Function: DocumentFileAccess::hashFile()
+//-----------------------------------------------------------------------------
+QByteArray DocumentFileAccess::hashFile(QString const& path)
+{
+    QFile file;
+    QBuffer archivedFile;
+    QIODevice* content = openContent(path, file, archivedFile);
+    if (content == nullptr)
     {
-        return QSharedPointer<Document>();
+        return QByteArray();
     }
+
+    return hashContent(*content);
 }
 
 //-----------------------------------------------------------------------------
@@ -114,14 +223,29 @@ QSharedPointer<Document> DocumentFileAccess::readDocument(QString const& path)
 //-----------------------------------------------------------------------------
 bool DocumentFileAccess::writeDocument(QSharedPointer<Document> model, QString const& path)
 {
-    QFile targetFile(path);
-    if (!targetFile.open(QFile::WriteOnly | QFile::Truncate))
+    // The previous file is kept intact until the new content has been completely written.
+    QSaveFile targetFile(path);
+    if (!targetFile.open(QFile::WriteOnly))
     {      
         return false;
     }
 
+    if (writeDocument(model, targetFile) == false)
+    {
+        targetFile.cancelWriting();
+        return false;
+    }
+
+    return targetFile.commit();
+}
+
+//-----------------------------------------------------------------------------
+// Function: DocumentFileAccess::writeDocument()
+//-----------------------------------------------------------------------------
+bool DocumentFileAccess::writeDocument(QSharedPointer<Document> model, QIODevice& device)
+{
     // write the parsed model
-    QXmlStreamWriter xmlWriter(&targetFile);
+    QXmlStreamWriter xmlWriter(&device);
     xmlWriter.setAutoFormatting(true);
     xmlWriter.setAutoFormattingIndent(-1);
 
@@ -174,10 +298,8 @@ bool DocumentFileAccess::writeDocument(QSharedPointer<Document> model, QString c
     else
     {
         Q_ASSERT_X(false, "DocumentFileAccess::writeDocument().", "Trying to write unknown document type to file.");
-        targetFile.close();
         return false;
     }
 
-    targetFile.close();
-    return true;
+    return xmlWriter.hasError() == false;
 }
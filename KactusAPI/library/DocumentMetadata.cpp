@@ -0,0 +1,269 @@
+//-----------------------------------------------------------------------------
+// File: DocumentMetadata.cpp
+//-----------------------------------------------------------------------------
+// Project: Kactus2
+// Author: Kactus2 team
+// Date: 16.10.2026
+//
+// Description:
+// Summary of a library document for filtering the library without its model.
+//-----------------------------------------------------------------------------
+
+#include "DocumentMetadata.h"
+
+#include <IPXACTmodels/AbstractionDefinition/AbstractionDefinition.h>
+#include <IPXACTmodels/Catalog/Catalog.h>
+#include <IPXACTmodels/Catalog/IpxactFile.h>
+#include <IPXACTmodels/Component/Component.h>
+#include <IPXACTmodels/Component/DesignConfigurationInstantiation.h>
+#include <IPXACTmodels/Component/DesignInstantiation.h>
+#include <IPXACTmodels/Component/View.h>
+#include <IPXACTmodels/Design/Design.h>
+#include <IPXACTmodels/DesignConfiguration/DesignConfiguration.h>
+
+namespace
+{
+    //! The longest short description kept in the summary.
+    constexpr int MAX_DESCRIPTION_LENGTH = 256;
+
+    //-----------------------------------------------------------------------------
+    // Function: findComponentHierarchy()
+    //-----------------------------------------------------------------------------
+    void findComponentHierarchy(QSharedPointer<Component const> component, DocumentMetadata& metadata)
+    {
+        for (QSharedPointer<View> const& view : *component->getViews())
+        {
+            if (view->isHierarchical() == false)
+            {
+                continue;
+            }
+
+            VLNV reference;
+            if (view->getDesignInstantiationRef().isEmpty() == false)
+            {
+                for (QSharedPointer<DesignInstantiation> const& instantiation : *component->getDesignInstantiations())
+                {
+                    if (instantiation->name() == view->getDesignInstantiationRef() &&
+                        instantiation->getDesignReference())
+                    {
+                        reference = *instantiation->getDesignReference();
+                        reference.setType(VLNV::DESIGN);
+                    }
+                }
+            }
+            else
+            {
+                for (QSharedPointer<DesignConfigurationInstantiation> const& instantiation :
+                    *component->getDesignConfigurationInstantiations())
+                {
+                    if (instantiation->name() == view->getDesignConfigurationInstantiationRef() &&
+                        instantiation->getDesignConfigurationReference())
+                    {
+                        reference = *instantiation->getDesignConfigurationReference();
+                        reference.setType(VLNV::DESIGNCONFIGURATION);
+                    }
+                }
+            }
+
+            if (reference.isEmpty() == false)
+            {
+                metadata.hierarchyReferences.append(HierarchyReference{ reference, view->name() });
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    // Function: findCatalogHierarchy()
+    //-----------------------------------------------------------------------------
+    void findCatalogHierarchy(QSharedPointer<Catalog const> catalog, DocumentMetadata& metadata)
+    {
+        for (auto const& files : { catalog->getCatalogs(), catalog->getBusDefinitions(),
+            catalog->getAbstractionDefinitions(), catalog->getComponents() })
+        {
+            for (QSharedPointer<IpxactFile> const& file : *files)
+            {
+                metadata.hierarchyReferences.append(HierarchyReference{ file->getVlnv(), QString() });
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    // Function: writeVLNV()
+    //-----------------------------------------------------------------------------
+    void writeVLNV(QDataStream& stream, VLNV const& vlnv)
+    {
+        stream << static_cast<qint32>(vlnv.getType()) << vlnv.getVendor() << vlnv.getLibrary() << vlnv.getName() <<
+            vlnv.getVersion();
+    }
+
+    //-----------------------------------------------------------------------------
+    // Function: readVLNV()
+    //-----------------------------------------------------------------------------
+    VLNV readVLNV(QDataStream& stream)
+    {
+        qint32 type = VLNV::INVALID;
+        QString vendor;
+        QString library;
+        QString name;
+        QString version;
+        stream >> type >> vendor >> library >> name >> version;
+
+        return VLNV(static_cast<VLNV::IPXactType>(type), vendor, library, name, version);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: DocumentMetadata::fromDocument()
+//-----------------------------------------------------------------------------
+DocumentMetadata DocumentMetadata::fromDocument(QSharedPointer<Document const> document)
+{
+    DocumentMetadata metadata;
+    if (document.isNull())
+    {
+        return metadata;
+    }
+
+    metadata.type = document->getVlnv().getType();
+    metadata.implementation = document->getImplementation();
+    metadata.firmness = document->getFirmness();
+    metadata.productHierarchy = document->getHierarchy();
+    metadata.revision = document->getRevision();
+    metadata.tags = document->getTags();
+    metadata.shortDescription = document->getShortDescription().left(MAX_DESCRIPTION_LENGTH);
+
+    VLNV const documentVLNV = document->getVlnv();
+    for (VLNV const& dependency : document->getDependentVLNVs())
+    {
+        if (dependency.isValid() && dependency != documentVLNV && metadata.dependencies.contains(dependency) == false)
+        {
+            metadata.dependencies.append(dependency);
+        }
+    }
+
+    if (metadata.type == VLNV::COMPONENT)
+    {
+        QSharedPointer<Component const> component = document.staticCast<Component const>();
+        metadata.isHierarchical = component->isHierarchical();
+        metadata.hasSystemViews = component->hasSystemViews();
+        metadata.hasViews = component->hasViews();
+
+        findComponentHierarchy(component, metadata);
+    }
+    else if (metadata.type == VLNV::DESIGN)
+    {
+        for (QSharedPointer<ComponentInstance> const& instance :
+            *document.staticCast<Design const>()->getComponentInstances())
+        {
+            // Each instance is listed to count the instances of a component.
+            if (instance->isDraft() == false && instance->getComponentRef())
+            {
+                metadata.hierarchyReferences.append(HierarchyReference{ *instance->getComponentRef(), QString() });
+            }
+        }
+    }
+    else if (metadata.type == VLNV::DESIGNCONFIGURATION)
+    {
+        metadata.hierarchyReferences.append(
+            HierarchyReference{ document.staticCast<DesignConfiguration const>()->getDesignRef(), QString() });
+    }
+    else if (metadata.type == VLNV::ABSTRACTIONDEFINITION)
+    {
+        metadata.hierarchyReferences.append(
+            HierarchyReference{ document.staticCast<AbstractionDefinition const>()->getBusType(), QString() });
+    }
+    else if (metadata.type == VLNV::CATALOG)
+    {
+        findCatalogHierarchy(document.staticCast<Catalog const>(), metadata);
+    }
+
+    return metadata;
+}
+
+//-----------------------------------------------------------------------------
+// Function: DocumentMetadata::operator<<()
+//-----------------------------------------------------------------------------
+QDataStream& operator<<(QDataStream& stream, DocumentMetadata const& metadata)
+{
+    stream << static_cast<qint32>(metadata.type) << static_cast<qint32>(metadata.implementation) <<
+        static_cast<qint32>(metadata.firmness) << static_cast<qint32>(metadata.productHierarchy) <<
+        static_cast<qint32>(metadata.revision) << static_cast<qint32>(metadata.tags.size());
+
+    for (TagData const& tag : metadata.tags)
+    {
+        stream << tag.name_ << tag.color_;
+    }
+
+    stream << metadata.isHierarchical << metadata.hasSystemViews << metadata.hasViews << metadata.isValid <<
+        metadata.shortDescription;
+
+    stream << static_cast<qint32>(metadata.dependencies.size());
+    for (VLNV const& dependency : metadata.dependencies)
+    {
+        writeVLNV(stream, dependency);
+    }
+
+    stream << static_cast<qint32>(metadata.hierarchyReferences.size());
+    for (HierarchyReference const& reference : metadata.hierarchyReferences)
+    {
+        writeVLNV(stream, reference.vlnv);
+        stream << reference.viewName;
+    }
+
+    return stream;
+}
+
+//-----------------------------------------------------------------------------
+// Function: DocumentMetadata::operator>>()
+//-----------------------------------------------------------------------------
+QDataStream& operator>>(QDataStream& stream, DocumentMetadata& metadata)
+{
+    qint32 type = VLNV::INVALID;
+    qint32 implementation = KactusAttribute::HW;
+    qint32 firmness = KactusAttribute::MUTABLE;
+    qint32 productHierarchy = KactusAttribute::FLAT;
+    qint32 revision = static_cast<qint32>(Document::Revision::Unknown);
+    qint32 tagCount = 0;
+
+    stream >> type >> implementation >> firmness >> productHierarchy >> revision >> tagCount;
+
+    metadata.type = static_cast<VLNV::IPXactType>(type);
+    metadata.implementation = static_cast<KactusAttribute::Implementation>(implementation);
+    metadata.firmness = static_cast<KactusAttribute::Firmness>(firmness);
+    metadata.productHierarchy = static_cast<KactusAttribute::ProductHierarchy>(productHierarchy);
+    metadata.revision = static_cast<Document::Revision>(revision);
+
+    metadata.tags.clear();
+    for (qint32 i = 0; i < tagCount && stream.status() == QDataStream::Ok; ++i)
+    {
+        TagData tag;
+        stream >> tag.name_ >> tag.color_;
+        metadata.tags.append(tag);
+    }
+
+    stream >> metadata.isHierarchical >> metadata.hasSystemViews >> metadata.hasViews >> metadata.isValid >>
+        metadata.shortDescription;
+
+    qint32 dependencyCount = 0;
+    stream >> dependencyCount;
+
+    metadata.dependencies.clear();
+    for (qint32 i = 0; i < dependencyCount && stream.status() == QDataStream::Ok; ++i)
+    {
+        metadata.dependencies.append(readVLNV(stream));
+    }
+
+    qint32 referenceCount = 0;
+    stream >> referenceCount;
+
+    metadata.hierarchyReferences.clear();
+    for (qint32 i = 0; i < referenceCount && stream.status() == QDataStream::Ok; ++i)
+    {
+        HierarchyReference reference;
+        reference.vlnv = readVLNV(stream);
+        stream >> reference.viewName;
+
+        metadata.hierarchyReferences.append(reference);
+    }
+
+    return stream;
+}
@@ -0,0 +1,221 @@
+//-----------------------------------------------------------------------------
+// File: DocumentWriteQueue.cpp
+//-----------------------------------------------------------------------------
+// Project: Kactus2
+// Author: Kactus2 team
+// Date: 16.10.2026
+//
+// Description:
+// Queue for writing IP-XACT documents to files in a background thread.
+//-----------------------------------------------------------------------------
+
+#include "DocumentWriteQueue.h"
+
+#include "DocumentFileAccess.h"
+
+#include <QMutexLocker>
+#include <QSaveFile>
+
+#include <memory>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Function: DocumentWriteQueue::DocumentWriteQueue()
+//-----------------------------------------------------------------------------
+DocumentWriteQueue::DocumentWriteQueue(QObject* parent):
+QObject(parent)
+{
+    worker_.setMaxThreadCount(1);
+}
+
+//-----------------------------------------------------------------------------
+// Function: DocumentWriteQueue::~DocumentWriteQueue()
+//-----------------------------------------------------------------------------
+DocumentWriteQueue::~DocumentWriteQueue()
+{
+    // A group left open is written anyway rather than losing the documents in it.
+    if (group_.isEmpty() == false)
+    {
+        submit(group_);
+        group_.clear();
+    }
+
+    waitForDone();
+}
+
+//-----------------------------------------------------------------------------
+// Function: DocumentWriteQueue::beginGroup()
+//-----------------------------------------------------------------------------
+void DocumentWriteQueue::beginGroup()
+{
+    groupDepth_++;
+}
+
+//-----------------------------------------------------------------------------
+// Function: DocumentWriteQueue::endGroup()
+//-----------------------------------------------------------------------------
+void DocumentWriteQueue::endGroup()
+{
+    if (groupDepth_ == 0)
+    {
+        return;
+    }
+
+    groupDepth_--;
+    if (groupDepth_ == 0 && group_.isEmpty() == false)
+    {
+        submit(group_);
+        group_.clear();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: DocumentWriteQueue::enqueue()
+//-----------------------------------------------------------------------------
+void DocumentWriteQueue::enqueue(QSharedPointer<Document> document, QString const& path)
+{
+    {
+        QMutexLocker locker(&pendingMutex_);
+        pendingPaths_[path]++;
+        queuedDocuments_.insert(path, document);
+    }
+
+    PendingWrite write{ document, path };
+    if (groupDepth_ > 0)
+    {
+        group_.append(write);
+    }
+    else
+    {
+        submit({ write });
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: DocumentWriteQueue::isPending()
+//-----------------------------------------------------------------------------
+bool DocumentWriteQueue::isPending(QString const& path) const
+{
+    QMutexLocker locker(&pendingMutex_);
+    return pendingPaths_.contains(path);
+}
+
+//-----------------------------------------------------------------------------
+// Function: DocumentWriteQueue::queuedDocument()
+//-----------------------------------------------------------------------------
+QSharedPointer<Document> DocumentWriteQueue::queuedDocument(QString const& path) const
+{
+    QMutexLocker locker(&pendingMutex_);
+    return queuedDocuments_.value(path);
+}
+
+//-----------------------------------------------------------------------------
+// Function: DocumentWriteQueue::cancelGroupedWrites()
+//-----------------------------------------------------------------------------
+void DocumentWriteQueue::cancelGroupedWrites(QString const& path)
+{
+    int const removedCount = static_cast<int>(
+        group_.removeIf([&path](PendingWrite const& write) { return write.path == path; }));
+    if (removedCount == 0)
+    {
+        return;
+    }
+
+    QMutexLocker locker(&pendingMutex_);
+    auto pending = pendingPaths_.find(path);
+    if (pending != pendingPaths_.end())
+    {
+        pending.value() -= removedCount;
+        if (pending.value() <= 0)
+        {
+            pendingPaths_.erase(pending);
+            queuedDocuments_.remove(path);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: DocumentWriteQueue::hasPendingWrites()
+//-----------------------------------------------------------------------------
+bool DocumentWriteQueue::hasPendingWrites() const
+{
+    QMutexLocker locker(&pendingMutex_);
+    return pendingPaths_.isEmpty() == false;
+}
+
+//-----------------------------------------------------------------------------
+// Function: DocumentWriteQueue::waitForDone()
+//-----------------------------------------------------------------------------
+void DocumentWriteQueue::waitForDone()
+{
+    worker_.waitForDone();
+}
+
+//-----------------------------------------------------------------------------
+// Function: DocumentWriteQueue::submit()
+//-----------------------------------------------------------------------------
+void DocumentWriteQueue::submit(QVector<PendingWrite> const& batch)
+{
+    worker_.start([this, batch]() { commitBatch(batch); });
+}
+
+//-----------------------------------------------------------------------------
+// Function: DocumentWriteQueue::commitBatch()
+//-----------------------------------------------------------------------------
+void DocumentWriteQueue::commitBatch(QVector<PendingWrite> const& batch)
+{
+    QStringList writtenPaths;
+    QStringList failedPaths;
+
+    // Write all the documents to their temporary files before replacing any of the targets.
+    std::vector<std::unique_ptr<QSaveFile> > files;
+    bool allWritten = true;
+    for (auto const& write : batch)
+    {
+        auto file = std::make_unique<QSaveFile>(write.path);
+        if (file->open(QIODevice::WriteOnly) == false ||
+            DocumentFileAccess::writeDocument(write.document, *file) == false)
+        {
+            allWritten = false;
+            break;
+        }
+
+        files.push_back(std::move(file));
+    }
+
+    // Commit flushes each temporary file to the disk and renames it over its target. The renames cannot be
+    // undone, so the targets after a failed rename are left as they were and reported as failed.
+    bool allCommitted = allWritten;
+    for (int i = 0; i < batch.size(); ++i)
+    {
+        if (allCommitted && files.at(i)->commit())
+        {
+            writtenPaths.append(batch.at(i).path);
+        }
+        else
+        {
+            allCommitted = false;
+            if (i < static_cast<int>(files.size()))
+            {
+                files.at(i)->cancelWriting();
+            }
+
+            failedPaths.append(batch.at(i).path);
+        }
+    }
+
+    {
+        QMutexLocker locker(&pendingMutex_);
+        for (auto const& write : batch)
+        {
+            auto pending = pendingPaths_.find(write.path);
+            if (pending != pendingPaths_.end() && --pending.value() == 0)
+            {
+                pendingPaths_.erase(pending);
+                queuedDocuments_.remove(write.path);
+            }
+        }
+    }
+
+    emit writesFinished(writtenPaths, failedPaths);
+}
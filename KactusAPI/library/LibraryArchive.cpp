@@ -0,0 +1,547 @@
+//-----------------------------------------------------------------------------
+// File: LibraryArchive.cpp
+//-----------------------------------------------------------------------------
+// Project: Kactus2
+// Author: Kactus2 team
+// Date: 16.10.2026
+//
+// Description:
+// Read-only access to library locations packed into a single zip archive.
+//-----------------------------------------------------------------------------
+
+#include <KactusAPI/include/LibraryArchive.h>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+#include <QSharedPointer>
+#include <QtEndian>
+
+#include <zlib.h>
+
+namespace
+{
+    //! Signatures of the zip records.
+    constexpr quint32 LOCAL_HEADER_SIGNATURE = 0x04034B50;
+    constexpr quint32 CENTRAL_HEADER_SIGNATURE = 0x02014B50;
+    constexpr quint32 END_OF_DIRECTORY_SIGNATURE = 0x06054B50;
+    constexpr quint32 ZIP64_END_OF_DIRECTORY_SIGNATURE = 0x06064B50;
+    constexpr quint32 ZIP64_LOCATOR_SIGNATURE = 0x07064B50;
+
+    //! Sizes of the fixed parts of the zip records.
+    constexpr int LOCAL_HEADER_SIZE = 30;
+    constexpr int CENTRAL_HEADER_SIZE = 46;
+    constexpr int END_OF_DIRECTORY_SIZE = 22;
+    constexpr int ZIP64_END_OF_DIRECTORY_SIZE = 56;
+    constexpr int ZIP64_LOCATOR_SIZE = 20;
+
+    //! Identifier of the extra field holding the 64-bit sizes and offsets.
+    constexpr quint16 ZIP64_EXTRA_FIELD = 0x0001;
+
+    //! Flags of the files.
+    constexpr quint16 ENCRYPTED_FLAG = 0x0001;
+    constexpr quint16 UTF8_NAME_FLAG = 0x0800;
+
+    //! Compression methods of the files.
+    constexpr quint16 STORED_METHOD = 0;
+    constexpr quint16 DEFLATED_METHOD = 8;
+
+    //! The largest file read from an archive. The sizes in an archive are not trusted beyond this.
+    constexpr qint64 MAX_ENTRY_SIZE = 256 * 1024 * 1024;
+
+    //! The suffix identifying archives in the paths.
+    const QString ARCHIVE_SUFFIX = QStringLiteral(".zip");
+
+    //-----------------------------------------------------------------------------
+    // Function: read16()
+    //-----------------------------------------------------------------------------
+    quint16 read16(char const* data)
+    {
+        return qFromLittleEndian<quint16>(data);
+    }
+
+    //-----------------------------------------------------------------------------
+    // Function: read32()
+    //-----------------------------------------------------------------------------
+    quint32 read32(char const* data)
+    {
+        return qFromLittleEndian<quint32>(data);
+    }
+
+    //-----------------------------------------------------------------------------
+    // Function: read64()
+    //-----------------------------------------------------------------------------
+    quint64 read64(char const* data)
+    {
+        return qFromLittleEndian<quint64>(data);
+    }
+
+    //! A file in an archive.
+    struct ArchiveFile
+    {
+        qint64 headerOffset = 0;        //<! The offset of the local header of the file.
+        qint64 compressedSize = 0;      //<! The size of the stored data.
+        qint64 size = 0;                //<! The uncompressed size.
+        quint32 crc = 0;                //<! The checksum of the uncompressed content.
+        quint16 method = 0;             //<! The compression method.
+        qint64 lastModified = 0;        //<! The modification time in ms since epoch.
+    };
+
+    //! An archive whose central directory has been read.
+    struct OpenArchive
+    {
+        QString path;                           //<! The path to the archive file.
+        qint64 size = -1;                       //<! The size of the archive file when it was opened.
+        qint64 lastModified = 0;                //<! The modification time of the archive file when it was opened.
+        QHash<QString, ArchiveFile> files;      //<! The files in the archive by their path.
+        QVector<QString> fileOrder;             //<! The paths of the files in the order of the central directory.
+        QSet<QString> directories;              //<! The paths of the directories in the archive.
+    };
+
+    //! The archives opened so far.
+    struct ArchiveRegistry
+    {
+        QMutex mutex;                                           //<! Guards the archives.
+        QHash<QString, QSharedPointer<OpenArchive> > archives;  //<! The opened archives by their path.
+    };
+
+    //-----------------------------------------------------------------------------
+    // Function: registry()
+    //-----------------------------------------------------------------------------
+    ArchiveRegistry& registry()
+    {
+        static ArchiveRegistry instance;
+        return instance;
+    }
+
+    //-----------------------------------------------------------------------------
+    // Function: dosTimeToMSecs()
+    //-----------------------------------------------------------------------------
+    qint64 dosTimeToMSecs(quint16 time, quint16 date)
+    {
+        QDateTime const dateTime(QDate(1980 + (date >> 9), (date >> 5) & 0x0F, date & 0x1F),
+            QTime(time >> 11, (time >> 5) & 0x3F, (time & 0x1F) * 2));
+
+        return dateTime.isValid() ? dateTime.toMSecsSinceEpoch() : 0;
+    }
+
+    //-----------------------------------------------------------------------------
+    // Function: readCentralDirectory()
+    //-----------------------------------------------------------------------------
+    bool readCentralDirectory(OpenArchive& archive, QFile& file)
+    {
+        qint64 const fileSize = file.size();
+
+        // The end of central directory record is the last record, followed only by a comment of at most 64 kB.
+        qint64 const tailSize = qMin<qint64>(fileSize, END_OF_DIRECTORY_SIZE + 0xFFFF);
+        if (tailSize < END_OF_DIRECTORY_SIZE || file.seek(fileSize - tailSize) == false)
+        {
+            return false;
+        }
+
+        QByteArray const tail = file.read(tailSize);
+        if (tail.size() != tailSize)
+        {
+            return false;
+        }
+
+        int recordPosition = tail.size() - END_OF_DIRECTORY_SIZE;
+        while (recordPosition >= 0 && read32(tail.constData() + recordPosition) != END_OF_DIRECTORY_SIGNATURE)
+        {
+            --recordPosition;
+        }
+
+        if (recordPosition < 0)
+        {
+            return false;
+        }
+
+        char const* record = tail.constData() + recordPosition;
+        quint64 fileCount = read16(record + 10);
+        quint64 directorySize = read32(record + 12);
+        quint64 directoryOffset = read32(record + 16);
+
+        // Archives with many or large files have the values in the zip64 record instead.
+        if (recordPosition >= ZIP64_LOCATOR_SIZE && read32(record - ZIP64_LOCATOR_SIZE) == ZIP64_LOCATOR_SIGNATURE)
+        {
+            quint64 const zip64RecordOffset = read64(record - ZIP64_LOCATOR_SIZE + 8);
+            if (zip64RecordOffset > quint64(fileSize) || file.seek(zip64RecordOffset) == false)
+            {
+                return false;
+            }
+
+            QByteArray const zip64Record = file.read(ZIP64_END_OF_DIRECTORY_SIZE);
+            if (zip64Record.size() != ZIP64_END_OF_DIRECTORY_SIZE ||
+                read32(zip64Record.constData()) != ZIP64_END_OF_DIRECTORY_SIGNATURE)
+            {
+                return false;
+            }
+
+            fileCount = read64(zip64Record.constData() + 32);
+            directorySize = read64(zip64Record.constData() + 40);
+            directoryOffset = read64(zip64Record.constData() + 48);
+        }
+
+        // Compared by subtraction, since the untrusted values may overflow when added.
+        if (directoryOffset > quint64(fileSize) || directorySize > quint64(fileSize) - directoryOffset ||
+            file.seek(directoryOffset) == false)
+        {
+            return false;
+        }
+
+        // The whole central directory is read at once.
+        QByteArray const directory = file.read(directorySize);
+        if (quint64(directory.size()) != directorySize)
+        {
+            return false;
+        }
+
+        qint64 position = 0;
+        for (quint64 i = 0; i < fileCount; ++i)
+        {
+            char const* header = directory.constData() + position;
+            if (position + CENTRAL_HEADER_SIZE > directory.size() || read32(header) != CENTRAL_HEADER_SIGNATURE)
+            {
+                return false;
+            }
+
+            quint16 const flags = read16(header + 8);
+            int const nameLength = read16(header + 28);
+            int const extraLength = read16(header + 30);
+            int const commentLength = read16(header + 32);
+
+            if (position + CENTRAL_HEADER_SIZE + nameLength + extraLength + commentLength > directory.size())
+            {
+                return false;
+            }
+
+            ArchiveFile archiveFile;
+            archiveFile.method = read16(header + 10);
+            archiveFile.lastModified = dosTimeToMSecs(read16(header + 12), read16(header + 14));
+            archiveFile.crc = read32(header + 16);
+
+            quint64 compressedSize = read32(header + 20);
+            quint64 size = read32(header + 24);
+            quint64 headerOffset = read32(header + 42);
+
+            QByteArray const rawName(header + CENTRAL_HEADER_SIZE, nameLength);
+            QString const name = (flags & UTF8_NAME_FLAG) ? QString::fromUtf8(rawName) : QString::fromLatin1(rawName);
+
+            // The values not fitting in 32 bits are in the zip64 extra field, in this order.
+            char const* extra = header + CENTRAL_HEADER_SIZE + nameLength;
+            int extraPosition = 0;
+            while (extraPosition + 4 <= extraLength)
+            {
+                quint16 const fieldId = read16(extra + extraPosition);
+                int const fieldSize = read16(extra + extraPosition + 2);
+                if (extraPosition + 4 + fieldSize > extraLength)
+                {
+                    break;
+                }
+
+                if (fieldId == ZIP64_EXTRA_FIELD)
+                {
+                    char const* value = extra + extraPosition + 4;
+                    char const* const fieldEnd = value + fieldSize;
+                    for (quint64* field : { &size, &compressedSize, &headerOffset })
+                    {
+                        if (*field == 0xFFFFFFFFu && value + 8 <= fieldEnd)
+                        {
+                            *field = read64(value);
+                            value += 8;
+                        }
+                    }
+                }
+
+                extraPosition += 4 + fieldSize;
+            }
+
+            position += CENTRAL_HEADER_SIZE + nameLength + extraLength + commentLength;
+
+            if (name.endsWith(QLatin1Char('/')))
+            {
+                archive.directories.insert(name.chopped(1));
+                continue;
+            }
+
+            if (flags & ENCRYPTED_FLAG)
+            {
+                continue;
+            }
+
+            archiveFile.compressedSize = compressedSize;
+            archiveFile.size = size;
+            archiveFile.headerOffset = headerOffset;
+
+            archive.files.insert(name, archiveFile);
+            archive.fileOrder.append(name);
+
+            // The directories are not necessarily stored in the archive.
+            for (int separator = name.lastIndexOf(QLatin1Char('/')); separator > 0;
+                separator = name.lastIndexOf(QLatin1Char('/'), separator - 1))
+            {
+                QString const directoryName = name.left(separator);
+                if (archive.directories.contains(directoryName))
+                {
+                    break;
+                }
+
+                archive.directories.insert(directoryName);
+            }
+        }
+
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------
+    // Function: openArchive()
+    //-----------------------------------------------------------------------------
+    QSharedPointer<OpenArchive> openArchive(QString const& archivePath, bool checkForChanges)
+    {
+        ArchiveRegistry& archives = registry();
+        QMutexLocker locker(&archives.mutex);
+
+        QSharedPointer<OpenArchive> archive = archives.archives.value(archivePath);
+        if (archive.isNull() == false && checkForChanges == false)
+        {
+            return archive;
+        }
+
+        QFileInfo const archiveInfo(archivePath);
+        if (archive.isNull() == false && archive->size == archiveInfo.size() &&
+            archive->lastModified == archiveInfo.lastModified().toMSecsSinceEpoch())
+        {
+            return archive;
+        }
+
+        // Readers of the previous content keep it until they are done. The archive file is only kept open
+        // while the central directory is read.
+        archive = QSharedPointer<OpenArchive>(new OpenArchive());
+        archive->path = archivePath;
+        archive->size = archiveInfo.size();
+        archive->lastModified = archiveInfo.lastModified().toMSecsSinceEpoch();
+
+        QFile archiveFile(archivePath);
+        if (archiveFile.open(QIODevice::ReadOnly) == false || readCentralDirectory(*archive, archiveFile) == false)
+        {
+            archives.archives.remove(archivePath);
+            return QSharedPointer<OpenArchive>();
+        }
+
+        archives.archives.insert(archivePath, archive);
+        return archive;
+    }
+
+    //-----------------------------------------------------------------------------
+    // Function: splitPath()
+    //-----------------------------------------------------------------------------
+    bool splitPath(QString const& path, QString& archivePath, QString& filePath)
+    {
+        QString const cleanPath = QDir::cleanPath(path);
+
+        for (int suffix = cleanPath.indexOf(ARCHIVE_SUFFIX + QLatin1Char('/'), 0, Qt::CaseInsensitive); suffix >= 0;
+            suffix = cleanPath.indexOf(ARCHIVE_SUFFIX + QLatin1Char('/'), suffix + 1, Qt::CaseInsensitive))
+        {
+            QString const candidate = cleanPath.left(suffix + ARCHIVE_SUFFIX.size());
+
+            bool isOpen = false;
+            {
+                ArchiveRegistry& archives = registry();
+                QMutexLocker locker(&archives.mutex);
+                isOpen = archives.archives.contains(candidate);
+            }
+
+            if (isOpen || QFileInfo(candidate).isFile())
+            {
+                archivePath = candidate;
+                filePath = cleanPath.mid(suffix + ARCHIVE_SUFFIX.size() + 1);
+                return true;
+            }
+        }
+
+        return false;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryArchive::isArchive()
+//-----------------------------------------------------------------------------
+bool LibraryArchive::isArchive(QString const& location)
+{
+    return location.endsWith(ARCHIVE_SUFFIX, Qt::CaseInsensitive) && QFileInfo(location).isFile();
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryArchive::isArchiveEntry()
+//-----------------------------------------------------------------------------
+bool LibraryArchive::isArchiveEntry(QString const& path)
+{
+    // Most paths are ordinary files, so look for the suffix before checking the file system.
+    if (path.contains(ARCHIVE_SUFFIX, Qt::CaseInsensitive) == false)
+    {
+        return false;
+    }
+
+    QString archivePath;
+    QString filePath;
+    return splitPath(path, archivePath, filePath);
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryArchive::findDocuments()
+//-----------------------------------------------------------------------------
+bool LibraryArchive::findDocuments(QString const& archivePath, QVector<Entry>& documents)
+{
+    QString const cleanArchivePath = QDir::cleanPath(archivePath);
+
+    QSharedPointer<OpenArchive> archive = openArchive(cleanArchivePath, true);
+    if (archive.isNull())
+    {
+        return false;
+    }
+
+    for (QString const& name : archive->fileOrder)
+    {
+        if (name.endsWith(QStringLiteral(".xml"), Qt::CaseInsensitive))
+        {
+            ArchiveFile const archiveFile = archive->files.value(name);
+            documents.append({ cleanArchivePath + QLatin1Char('/') + name, archiveFile.size,
+                archiveFile.lastModified });
+        }
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryArchive::contains()
+//-----------------------------------------------------------------------------
+bool LibraryArchive::contains(QString const& path)
+{
+    if (path.contains(ARCHIVE_SUFFIX, Qt::CaseInsensitive) == false)
+    {
+        return false;
+    }
+
+    QString archivePath;
+    QString filePath;
+    if (splitPath(path, archivePath, filePath) == false)
+    {
+        return false;
+    }
+
+    QSharedPointer<OpenArchive> archive = openArchive(archivePath, false);
+    return archive.isNull() == false &&
+        (filePath.isEmpty() || archive->files.contains(filePath) || archive->directories.contains(filePath));
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryArchive::readEntry()
+//-----------------------------------------------------------------------------
+bool LibraryArchive::readEntry(QString const& path, QByteArray& content)
+{
+    content.clear();
+
+    QString archivePath;
+    QString filePath;
+    if (splitPath(path, archivePath, filePath) == false)
+    {
+        return false;
+    }
+
+    QSharedPointer<OpenArchive> archive = openArchive(archivePath, false);
+    if (archive.isNull() || archive->files.contains(filePath) == false)
+    {
+        return false;
+    }
+
+    // The sizes are checked before allocating anything for the content.
+    ArchiveFile const archiveFile = archive->files.value(filePath);
+    if ((archiveFile.method != STORED_METHOD && archiveFile.method != DEFLATED_METHOD) ||
+        archiveFile.size < 0 || archiveFile.size > MAX_ENTRY_SIZE ||
+        archiveFile.compressedSize < 0 || archiveFile.compressedSize > archive->size ||
+        (archiveFile.method == STORED_METHOD && archiveFile.compressedSize != archiveFile.size))
+    {
+        return false;
+    }
+
+    QByteArray storedData;
+    {
+        QFile file(archive->path);
+        if (file.open(QIODevice::ReadOnly) == false || file.size() != archive->size ||
+            file.seek(archiveFile.headerOffset) == false)
+        {
+            return false;
+        }
+
+        QByteArray const localHeader = file.read(LOCAL_HEADER_SIZE);
+        if (localHeader.size() != LOCAL_HEADER_SIZE || read32(localHeader.constData()) != LOCAL_HEADER_SIGNATURE)
+        {
+            return false;
+        }
+
+        qint64 const dataOffset = archiveFile.headerOffset + LOCAL_HEADER_SIZE +
+            read16(localHeader.constData() + 26) + read16(localHeader.constData() + 28);
+
+        if (dataOffset > archive->size || archiveFile.compressedSize > archive->size - dataOffset ||
+            file.seek(dataOffset) == false)
+        {
+            return false;
+        }
+
+        storedData = file.read(archiveFile.compressedSize);
+    }
+
+    if (storedData.size() != archiveFile.compressedSize)
+    {
+        return false;
+    }
+
+    if (archiveFile.method == STORED_METHOD)
+    {
+        content = storedData;
+    }
+    else
+    {
+        // The output is limited to the size given in the central directory, so that a file cannot inflate
+        // beyond it.
+        content.resize(archiveFile.size);
+
+        z_stream stream{};
+        stream.next_in = reinterpret_cast<Bytef*>(storedData.data());
+        stream.avail_in = uInt(storedData.size());
+        stream.next_out = reinterpret_cast<Bytef*>(content.data());
+        stream.avail_out = uInt(content.size());
+
+        // Zip archives hold raw deflate data without the zlib header.
+        if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+        {
+            content.clear();
+            return false;
+        }
+
+        int const result = inflate(&stream, Z_FINISH);
+        qint64 const inflatedSize = qint64(stream.total_out);
+        inflateEnd(&stream);
+
+        if (result != Z_STREAM_END || inflatedSize != archiveFile.size)
+        {
+            content.clear();
+            return false;
+        }
+    }
+
+    if (content.size() != archiveFile.size ||
+        crc32(0L, reinterpret_cast<Bytef const*>(content.constData()), uInt(content.size())) != archiveFile.crc)
+    {
+        content.clear();
+        return false;
+    }
+
+    return true;
+}
@@ -17,7 +17,10 @@
 
 #include "ConsoleMediator.h"
 
+#include "LibraryArchive.h"
+
 #include "TagManager.h"
+#include "Tracing.h"
 
 #include <IPXACTmodels/common/Document.h>
 
@@ -34,14 +37,53 @@
 
 #include <IPXACTmodels/common/VLNV.h>
 
+#include <QCoreApplication>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFileInfo>
 #include <QSharedPointer>
 #include <QList>
 #include <QMap>
+#include <QMultiHash>
+#include <QMutexLocker>
+#include <QSettings>
+#include <QStorageInfo>
 #include <QString>
 #include <QStringList>
+#include <QThread>
+
+#include <QtConcurrent>
+
+#include <algorithm>
+
+namespace
+{
+    //! The number of directories added to the file system watcher at a time.
+    constexpr int WATCH_BATCH_SIZE = 200;
+
+    //! The number of polled directories checked at a time.
+    constexpr int POLL_BATCH_SIZE = 100;
+
+    //-----------------------------------------------------------------------------
+    // Function: isNetworkFileSystem()
+    //-----------------------------------------------------------------------------
+    bool isNetworkFileSystem(QString const& path)
+    {
+        // Changes made by other hosts are not reported by the file system notifications on network shares.
+        if (path.startsWith(QLatin1String("//")) || path.startsWith(QLatin1String("\\\\")))
+        {
+            return true;
+        }
+
+        static QStringList const networkTypes{ QStringLiteral("nfs"), QStringLiteral("nfs4"),
+            QStringLiteral("cifs"), QStringLiteral("smbfs"), QStringLiteral("smb2"), QStringLiteral("smb3"),
+            QStringLiteral("9p"), QStringLiteral("afs"), QStringLiteral("davfs"), QStringLiteral("fuse.sshfs") };
+
+        QString const type = QString::fromLatin1(QStorageInfo(path).fileSystemType()).toLower();
+        return networkTypes.contains(type);
+    }
+}
 
 //-----------------------------------------------------------------------------
 // Function: LibraryHandler::getInstance()
@@ -62,6 +104,46 @@ LibraryInterface()
 {
     // create the connections between models and library handler
     syncronizeModels();
+
+    checkTimer_.setSingleShot(true);
+    checkTimer_.setInterval(0);
+    connect(&checkTimer_, SIGNAL(timeout()), this, SLOT(onCheckNextItems()), Qt::UniqueConnection);
+
+    // Collect the changes made e.g. by version control or generators into a single refresh.
+    refreshTimer_.setSingleShot(true);
+    refreshTimer_.setInterval(500);
+    connect(&refreshTimer_, SIGNAL(timeout()), this, SLOT(onRefreshChangedDirectories()), Qt::UniqueConnection);
+
+    connect(&libraryWatcher_, SIGNAL(directoryChanged(QString const&)),
+        this, SLOT(onDirectoryChanged(QString const&)), Qt::UniqueConnection);
+
+    // Large libraries are watched a batch at a time to keep the user interface responsive.
+    watchTimer_.setSingleShot(true);
+    watchTimer_.setInterval(0);
+    connect(&watchTimer_, SIGNAL(timeout()), this, SLOT(onWatchNextDirectories()), Qt::UniqueConnection);
+
+    pollTimer_.setInterval(1000);
+    connect(&pollTimer_, SIGNAL(timeout()), this, SLOT(onPollNextDirectories()), Qt::UniqueConnection);
+
+    connect(&writeQueue_, SIGNAL(writesFinished(QStringList const&, QStringList const&)),
+        this, SLOT(onWritesFinished(QStringList const&, QStringList const&)), Qt::QueuedConnection);
+
+    scanTimer_.setSingleShot(true);
+    scanTimer_.setInterval(100);
+    connect(&scanTimer_, SIGNAL(timeout()), this, SLOT(onScanResultsReady()), Qt::UniqueConnection);
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::~LibraryHandler()
+//-----------------------------------------------------------------------------
+LibraryHandler::~LibraryHandler()
+{
+    // The worker uses the loader, so it must end first.
+    if (scanProgress_.isNull() == false)
+    {
+        scanProgress_->cancel();
+        scanTask_.waitForFinished();
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -73,30 +155,107 @@ void LibraryHandler::setOutputChannel(MessageMediator* messageChannel)
 }
 
 //-----------------------------------------------------------------------------
-// Function: LibraryHandler::getModel()
+// Function: LibraryHandler::setBackgroundValidation()
 //-----------------------------------------------------------------------------
-QSharedPointer<Document> LibraryHandler::getModel(VLNV const& vlnv)
+void LibraryHandler::setBackgroundValidation(bool enabled)
 {
-    auto info = documentCache_.find(vlnv);
-    if (info == documentCache_.end())
+    backgroundValidation_ = enabled;
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::isIntegrityCheckRunning()
+//-----------------------------------------------------------------------------
+bool LibraryHandler::isIntegrityCheckRunning() const
+{
+    return pendingChecks_.isEmpty() == false;
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::setFileSystemWatching()
+//-----------------------------------------------------------------------------
+void LibraryHandler::setFileSystemWatching(bool enabled)
+{
+    watchLibrary_ = enabled;
+
+    if (watchLibrary_ && documentCache_.isEmpty() == false)
     {
-        showNotFoundError(vlnv);
-        return QSharedPointer<Document>();
+        watchLibraryDirectories();
+    }
+    else if (watchLibrary_ == false)
+    {
+        stopWatchingLibrary();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::isLibraryScanRunning()
+//-----------------------------------------------------------------------------
+bool LibraryHandler::isLibraryScanRunning() const
+{
+    return scanProgress_.isNull() == false;
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::setCacheBudget()
+//-----------------------------------------------------------------------------
+void LibraryHandler::setCacheBudget(qint64 budgetBytes)
+{
+    cacheBudget_ = budgetBytes;
+
+    if (cachedBytes_ > cacheBudget_)
+    {
+        evictDocuments();
     }
+}
 
-    // If object has not already been parsed, read it from the disk.
-    if (info->document.isNull())
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::getCacheStatistics()
+//-----------------------------------------------------------------------------
+LibraryHandler::CacheStatistics LibraryHandler::getCacheStatistics() const
+{
+    CacheStatistics statistics = cacheStatistics_;
+    for (CachedDocument const& cached : cachedDocuments_)
     {
-        info->document = DocumentFileAccess::readDocument(info->path);
+        if (cached.isRetained)
+        {
+            statistics.retainedBytes += cached.size;
+        }
+        else
+        {
+            statistics.cachedBytes += cached.size;
+            statistics.cachedDocuments++;
+        }
     }
 
-    QSharedPointer<Document> copy;
-    if (info->document.isNull() == false)
+    return statistics;
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::waitForPendingWrites()
+//-----------------------------------------------------------------------------
+void LibraryHandler::waitForPendingWrites()
+{
+    writeQueue_.waitForDone();
+
+    // Deliver the results of the finished writes right away to update the file stamps.
+    QCoreApplication::sendPostedEvents(this, QEvent::MetaCall);
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::getModel()
+//-----------------------------------------------------------------------------
+QSharedPointer<Document> LibraryHandler::getModel(VLNV const& vlnv)
+{
+    if (contains(vlnv) == false)
     {
-        copy = info->document->clone();
+        showNotFoundError(vlnv);
+        return QSharedPointer<Document>();
     }
 
-    return copy;
+    // The caller intends to modify the document, so the shared snapshot is promoted to a private copy.
+    // Readers should use getModelReadOnly() or getSharedModel() to share the snapshot instead.
+    SharedDocument<Document> document(getModelReadOnly(vlnv));
+    return document.edit();
 }
 
 //-----------------------------------------------------------------------------
@@ -104,18 +263,58 @@ QSharedPointer<Document> LibraryHandler::getModel(VLNV const& vlnv)
 //-----------------------------------------------------------------------------
 QSharedPointer<Document const> LibraryHandler::getModelReadOnly(VLNV const& vlnv)
 {
-    auto info = documentCache_.find(vlnv);
-    if (info == documentCache_.end())
+    // The validators of the integrity check read the referenced documents from several threads, so the cache is
+    // only accessed under the lock. The file is read without it to let the other threads continue meanwhile.
+    QString path;
+    {
+        QMutexLocker cacheLock(&cacheMutex_);
+
+        auto info = findDocument(vlnv);
+        if (info == documentCache_.end())
+        {
+            return QSharedPointer<Document const>();
+        }
+
+        if (info->document.isNull() == false || info->evictedDocument.isNull() == false)
+        {
+            QSharedPointer<Document> document = loadDocument(vlnv, info.value());
+            if (document.isNull() == false)
+            {
+                return document;
+            }
+        }
+
+        path = info->path;
+    }
+
+    // A document waiting to be written, e.g. in an open save group, is more recent than its file.
+    QByteArray contentHash;
+    QSharedPointer<Document> readModel = writeQueue_.queuedDocument(path);
+    bool const isRead = readModel.isNull();
+    if (isRead)
+    {
+        readModel = DocumentFileAccess::readDocument(path, contentHash);
+    }
+
+    QMutexLocker cacheLock(&cacheMutex_);
+    if (isRead)
+    {
+        cacheStatistics_.reads++;
+    }
+
+    // The item may have been removed or moved, or another thread may have read it first.
+    auto info = findDocument(vlnv);
+    if (info == documentCache_.end() || info->path != path)
     {
         return QSharedPointer<Document const>();
     }
 
-    if (info->document.isNull())
+    if (info->document.isNull() && readModel.isNull() == false)
     {
-        info->document = DocumentFileAccess::readDocument(info->path);
+        info->contentHash = contentHash;
     }
 
-    return info->document;
+    return loadDocument(vlnv, info.value(), readModel);
 }
 
 //-----------------------------------------------------------------------------
@@ -123,7 +322,18 @@ QSharedPointer<Document const> LibraryHandler::getModelReadOnly(VLNV const& vlnv
 //-----------------------------------------------------------------------------
 QList<VLNV> LibraryHandler::getAllVLNVs() const
 {
-    return documentCache_.keys();
+    QMutexLocker cacheLock(&cacheMutex_);
+
+    QList<VLNV> vlnvs;
+    vlnvs.reserve(documentCache_.size());
+    for (auto it = documentCache_.cbegin(); it != documentCache_.cend(); ++it)
+    {
+        vlnvs.append(vlnvTable_.vlnv(it.key()));
+    }
+
+    // The items are listed in the VLNV order regardless of the order they were found in.
+    std::sort(vlnvs.begin(), vlnvs.end());
+    return vlnvs;
 }
 
 //-----------------------------------------------------------------------------
@@ -131,7 +341,8 @@ QList<VLNV> LibraryHandler::getAllVLNVs() const
 //-----------------------------------------------------------------------------
 bool LibraryHandler::contains(const VLNV& vlnv) const
 {
-    return documentCache_.contains(vlnv);
+    QMutexLocker cacheLock(&cacheMutex_);
+    return findDocument(vlnv) != documentCache_.cend();
 }
 
 //-----------------------------------------------------------------------------
@@ -139,7 +350,8 @@ bool LibraryHandler::contains(const VLNV& vlnv) const
 //-----------------------------------------------------------------------------
 const QString LibraryHandler::getPath(VLNV const& vlnv) const
 {
-    return documentCache_.value(vlnv).path;
+    QMutexLocker cacheLock(&cacheMutex_);
+    return documentCache_.value(vlnvTable_.find(vlnv)).path;
 }
 
 //-----------------------------------------------------------------------------
@@ -172,6 +384,13 @@ bool LibraryHandler::writeModelToFile(QString const& path, QSharedPointer<Docume
         return false;
     }
 
+    if (saveInProgress_)
+    {
+        // The views are updated once the whole save has ended.
+        savedItems_.append(vlnv);
+        return true;
+    }
+
     // the hierarchy model must be re-built
     hierarchyModel_.onResetModel();
     treeModel_.onAddVLNV(vlnv);
@@ -192,13 +411,48 @@ bool LibraryHandler::writeModelToFile(QSharedPointer<Document> model)
 //-----------------------------------------------------------------------------
 void LibraryHandler::searchForIPXactFiles()
 {
-    clearCache();
+    KACTUS2_TRACE_SCOPE("library", "LibraryHandler::searchForIPXactFiles");
+
+    cancelLibraryScan();
+
+    stopBackgroundIntegrityCheck();
+
+    // The saved documents must be on the disk before the library is read again.
+    waitForPendingWrites();
+
+    DocumentCache previousDocuments;
+    previousDocuments.swap(documentCache_);
 
     loadAvailableVLNVs();
 
-    onCheckLibraryIntegrity();
-    
-    resetModels();
+    finishLibrarySearch(previousDocuments);
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::finishLibrarySearch()
+//-----------------------------------------------------------------------------
+void LibraryHandler::finishLibrarySearch(DocumentCache const& previousDocuments)
+{
+    keepUnchangedDocuments(previousDocuments);
+
+    if (watchLibrary_)
+    {
+        watchLibraryDirectories();
+    }
+
+    if (backgroundValidation_)
+    {
+        // Show the library right away and report the validity of each item as it is checked.
+        resetModels();
+
+        startBackgroundIntegrityCheck();
+    }
+    else
+    {
+        checkLibraryIntegrity();
+
+        resetModels();
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -265,13 +519,15 @@ LibraryItem const* LibraryHandler::getTreeRoot() const
 //-----------------------------------------------------------------------------
 VLNV::IPXactType LibraryHandler::getDocumentType(VLNV const& vlnv)
 {
-    auto it = documentCache_.constFind(vlnv);
-    if (it == documentCache_.constEnd())
+    QMutexLocker cacheLock(&cacheMutex_);
+
+    auto it = findDocument(vlnv);
+    if (it == documentCache_.end())
     {
         return VLNV::INVALID;
     }
 
-    return it.key().getType();
+    return vlnvTable_.vlnv(it.key()).getType();
 }
 
 //-----------------------------------------------------------------------------
@@ -279,8 +535,8 @@ VLNV::IPXactType LibraryHandler::getDocumentType(VLNV const& vlnv)
 //-----------------------------------------------------------------------------
 int LibraryHandler::referenceCount(VLNV const& vlnv) const
 {
-    QList<VLNV> list;
-    return hierarchyModel_.getOwners(list, vlnv);
+    QMutexLocker cacheLock(&cacheMutex_);
+    return dependents_.value(vlnvTable_.find(vlnv)).size();
 }
 
 //-----------------------------------------------------------------------------
@@ -288,7 +544,17 @@ int LibraryHandler::referenceCount(VLNV const& vlnv) const
 //-----------------------------------------------------------------------------
 int LibraryHandler::getOwners(QList<VLNV>& list, VLNV const& vlnvToSearch) const
 {
-    return hierarchyModel_.getOwners(list, vlnvToSearch);
+    QMutexLocker cacheLock(&cacheMutex_);
+
+    for (VLNVTable::Handle const ownerHandle : dependents_.value(vlnvTable_.find(vlnvToSearch)))
+    {
+        if (VLNV const owner = vlnvTable_.vlnv(ownerHandle); list.contains(owner) == false)
+        {
+            list.append(owner);
+        }
+    }
+
+    return list.size();
 }
 
 //-----------------------------------------------------------------------------
@@ -361,15 +627,77 @@ QSharedPointer<Design> LibraryHandler::getDesign(VLNV const& hierarchyRef)
 //-----------------------------------------------------------------------------
 bool LibraryHandler::isValid(VLNV const& vlnv)
 {    
-    auto it = documentCache_.constFind(vlnv);
-    if (it != documentCache_.cend())
+    QMutexLocker cacheLock(&cacheMutex_);
+
+    auto it = findDocument(vlnv);
+    if (it != documentCache_.end())
     {
-        return documentCache_.value(vlnv).isValid;
+        return isDocumentValid(it.value());
     }
 
     return false;
 }
 
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::getMetadata()
+//-----------------------------------------------------------------------------
+DocumentMetadata LibraryHandler::getMetadata(VLNV const& vlnv)
+{
+    QString path;
+    {
+        QMutexLocker cacheLock(&cacheMutex_);
+
+        auto it = findDocument(vlnv);
+        if (it == documentCache_.end())
+        {
+            return DocumentMetadata();
+        }
+
+        if (it->metadata.isKnown())
+        {
+            DocumentMetadata metadata = it->metadata;
+            metadata.isValid = isDocumentValid(it.value());
+            return metadata;
+        }
+
+        path = it->path;
+    }
+
+    // Items not yet read are summarized once from a model that is not kept in the cache. A document waiting
+    // to be written is more recent than its file.
+    QByteArray contentHash;
+    QSharedPointer<Document> readModel = writeQueue_.queuedDocument(path);
+    bool const isRead = readModel.isNull();
+    if (isRead)
+    {
+        readModel = DocumentFileAccess::readDocument(path, contentHash);
+    }
+
+    QMutexLocker cacheLock(&cacheMutex_);
+    if (isRead)
+    {
+        cacheStatistics_.reads++;
+    }
+
+    // The item may have been removed or moved, or another thread may have read it first.
+    auto it = findDocument(vlnv);
+    if (it == documentCache_.end() || it->path != path)
+    {
+        return DocumentMetadata();
+    }
+
+    if (it->metadata.isKnown() == false && readModel.isNull() == false)
+    {
+        it->metadata = DocumentMetadata::fromDocument(readModel);
+        it->contentHash = contentHash;
+        updateDependencies(vlnv, it->metadata.dependencies);
+    }
+
+    DocumentMetadata metadata = it->metadata;
+    metadata.isValid = isDocumentValid(it.value());
+    return metadata;
+}
+
 //-----------------------------------------------------------------------------
 // Function: LibraryHandler::getHierarchyModel()
 //-----------------------------------------------------------------------------
@@ -391,33 +719,92 @@ LibraryTreeModel* LibraryHandler::getTreeModel()
 //-----------------------------------------------------------------------------
 void LibraryHandler::onCheckLibraryIntegrity()
 {
+    // All the items are validated on request.
+    for (DocumentInfo& info : documentCache_)
+    {
+        info.isChecked = false;
+    }
+
+    checkLibraryIntegrity();
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::checkLibraryIntegrity()
+//-----------------------------------------------------------------------------
+void LibraryHandler::checkLibraryIntegrity()
+{
+    KACTUS2_TRACE_SCOPE("validation", "LibraryHandler::checkLibraryIntegrity");
+
+    stopBackgroundIntegrityCheck();
+
     messageChannel_->showStatusMessage(tr("Validating items. Please wait..."));
 
     checkResults_.documentCount = 0;
     checkResults_.fileCount = 0;
 
-    QVector<TagData> documentTags;
-    for (auto it = documentCache_.begin(); it != documentCache_.end(); ++it)
+    // Only the items not checked since they were last changed are read and validated.
+    QVector<CheckedDocument> uncheckedDocuments;
+    for (auto it = documentCache_.cbegin(); it != documentCache_.cend(); ++it)
     {
-        // TODO: Add model to cache only, if it is already previously cached.
-        // Current hierarchy model forces all models to be loaded, but this should be changed.
-        QSharedPointer<Document> model = it->document;
-        if (model.isNull())
+        if (it->isChecked == false)
         {
-            model = DocumentFileAccess::readDocument(it->path);
-            it->document = model;
-        }           
+            QSharedPointer<Document> model = it->document.isNull() ?
+                it->evictedDocument.toStrongRef() : it->document;
+            uncheckedDocuments.append(CheckedDocument{ vlnvTable_.vlnv(it.key()), it->path, model });
+        }
+    }
 
-        if (model.isNull() == false)
+    // Read the documents on the worker threads. The models are added to the cache on this thread.
+    QtConcurrent::blockingMap(uncheckedDocuments, [](CheckedDocument& document)
+        {
+            if (document.model.isNull())
+            {
+                document.model = DocumentFileAccess::readDocument(document.path, document.contentHash);
+            }
+        });
+
+    for (CheckedDocument& document : uncheckedDocuments)
+    {
+        // Models read only for the check are not kept in the cache. Their summaries are enough for the views.
+        DocumentInfo& info = *findDocument(document.vlnv);
+        if (info.document.isNull() && info.evictedDocument.isNull())
         {
-            documentTags += (model->getTags());
+            cacheStatistics_.reads++;
+            info.metadata = DocumentMetadata::fromDocument(document.model);
+            updateDependencies(document.vlnv, info.metadata.dependencies);
+        }
+        else
+        {
+            document.model = loadDocument(document.vlnv, info, document.model);
         }
 
-        it->isValid = validateDocument(model, it->path);
-        if (it->isValid == false)
+        if (document.contentHash.isEmpty() == false)
+        {
+            info.contentHash = document.contentHash;
+        }
+    }
+
+    validateDocumentsConcurrently(uncheckedDocuments);
+
+    for (CheckedDocument const& document : uncheckedDocuments)
+    {
+        DocumentInfo& info = *findDocument(document.vlnv);
+        info.isValid = document.isValid;
+        info.isChecked = true;
+        info.fileCount = document.fileCount;
+    }
+
+    // The tags of the items kept from the earlier checks are taken from their summaries.
+    QVector<TagData> documentTags;
+    for (DocumentInfo const& info : documentCache_)
+    {
+        if (info.isValid == false)
         {
             checkResults_.documentCount++;
         }
+
+        checkResults_.fileCount += info.fileCount;
+        documentTags += info.document.isNull() ? info.metadata.tags : info.document->getTags();
     }
 
     TagManager& manager = TagManager::getInstance();
@@ -425,6 +812,8 @@ void LibraryHandler::onCheckLibraryIntegrity()
 
     showIntegrityResults();
 
+    saveMetadata();
+
     messageChannel_->showStatusMessage(tr("Ready."));
 }
 
@@ -564,13 +953,33 @@ void LibraryHandler::removeObject(VLNV const& vlnv)
         return;
     }
 
-    QString path = documentCache_.find(vlnv)->path;
+    QString path = findDocument(vlnv)->path;
+    if (LibraryArchive::isArchiveEntry(path))
+    {
+        messageChannel_->showError(tr("File %1 is in a read-only library archive.").arg(path));
+        return;
+    }
+
+    dropCachedDocument(vlnv);
+    updateDependencies(vlnv, QVector<VLNV>());
+    documentCache_.remove(vlnvTable_.find(vlnv));
 
-    documentCache_.remove(vlnv);
+    // A running search may have found the item already.
+    scanDocuments_.remove(vlnvTable_.find(vlnv));
+    scanSavedItems_.removeAll(vlnv);
 
     treeModel_.onRemoveVLNV(vlnv);
     hierarchyModel_.onRemoveVLNV(vlnv);
 
+    // A queued write would otherwise create the file again. The writes in an open save group are dropped, and
+    // the writes already submitted are finished before the file is removed.
+    writeQueue_.cancelGroupedWrites(path);
+    if (writeQueue_.isPending(path))
+    {
+        writeQueue_.waitForDone();
+    }
+
+    pendingSaves_.remove(path);
     removeFile(path);
 }
 
@@ -600,6 +1009,7 @@ void LibraryHandler::removeObjects(QList<VLNV> const& vlnvList)
 void LibraryHandler::beginSave()
 {
     saveInProgress_ = true;
+    writeQueue_.beginGroup();
 }
 
 //-----------------------------------------------------------------------------
@@ -608,6 +1018,23 @@ void LibraryHandler::beginSave()
 void LibraryHandler::endSave()
 {
     saveInProgress_ = false;
+    writeQueue_.endGroup();
+
+    // Items referenced by several saved items are validated only once.
+    revalidateDependents(revalidatedItems_);
+    revalidatedItems_.clear();
+
+    if (savedItems_.isEmpty() == false)
+    {
+        // the hierarchy model must be re-built
+        hierarchyModel_.onResetModel();
+        for (auto const& vlnv : savedItems_)
+        {
+            treeModel_.onAddVLNV(vlnv);
+        }
+
+        savedItems_.clear();
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -620,128 +1047,1197 @@ void LibraryHandler::onItemSaved(VLNV const& vlnv)
         return;
     }
 
-    VLNV savedItem = vlnv;
-    savedItem.setType(getDocumentType(vlnv));
+    auto it = findDocument(vlnv);
+    if (it == documentCache_.end())
+    {
+        return;
+    }
+
+    bool const wasValid = isValid(vlnv);
+
+    // The saved model is already in the cache, so it is validated as is instead of a copy.
+    QSharedPointer<Document> model = loadDocument(vlnv, *it);
+    it->isValid = validateDocument(model, it->path);
+    it->isChecked = true;
+    updateFileStamp(*it);
+
+    it->metadata = DocumentMetadata::fromDocument(model);
+    updateDependencies(vlnv, it->metadata.dependencies);
+
+    if (it->isValid != wasValid)
+    {
+        emit validityChanged(vlnv, it->isValid);
+    }
 
-    // Replace overwritten item with new and check validity.
-    QSharedPointer<Document> model = getModel(vlnv);
-    documentCache_.insert(vlnv, DocumentInfo(getPath(vlnv), model, validateDocument(model, getPath(vlnv))));
-    
     treeModel_.onDocumentUpdated(vlnv);
     hierarchyModel_.onDocumentUpdated(vlnv);
+
+    revalidateDependents(QVector<VLNV>({ vlnv }));
 }
 
 //-----------------------------------------------------------------------------
-// Function: LibraryHandler::syncronizeModels()
+// Function: LibraryHandler::onWritesFinished()
 //-----------------------------------------------------------------------------
-void LibraryHandler::syncronizeModels()
+void LibraryHandler::onWritesFinished(QStringList const& writtenPaths, QStringList const& failedPaths)
 {
-    // signals from tree model to library handler
- 
-    connect(&treeModel_, SIGNAL(openDesign(const VLNV&, QString const&)), this, SLOT(onOpenDesign(const VLNV&, QString const&)), Qt::UniqueConnection);
-    connect(&treeModel_, SIGNAL(openMemoryDesign(const VLNV&, QString const&)), this, SLOT(onOpenMemoryDesign(const VLNV&, QString const&)), Qt::UniqueConnection);
-    connect(&treeModel_, SIGNAL(openSWDesign(const VLNV&)), this, SLOT(onOpenSWDesign(const VLNV&)), Qt::UniqueConnection);
-    connect(&treeModel_, SIGNAL(openSystemDesign(const VLNV&, QString const&)), this, SLOT(onOpenSystemDesign(const VLNV&, QString const&)), Qt::UniqueConnection);
-    connect(&treeModel_, SIGNAL(editItem(const VLNV&)), this, SLOT(onEditItem(const VLNV&)), Qt::UniqueConnection);
+    for (auto const& path : writtenPaths)
+    {
+        // A later write to the same file updates the stamp when it finishes.
+        if (writeQueue_.isPending(path))
+        {
+            continue;
+        }
 
-    connect(this, SIGNAL(resetModel()),
-        &treeModel_, SLOT(onResetModel()), Qt::UniqueConnection);
+        auto it = findDocument(pendingSaves_.take(path));
+        if (it != documentCache_.end() && it->path == path)
+        {
+            // Own writes must not be taken as external changes to the library.
+            updateFileStamp(*it);
+        }
+    }
 
-    //-----------------------------------------------------------------------------
-    // connect the signals from the hierarchy model
-    //-----------------------------------------------------------------------------
+    for (auto const& path : failedPaths)
+    {
+        messageChannel_->showError(tr("Could not write file %1.").arg(path));
 
-    connect(&hierarchyModel_, SIGNAL(openDesign(const VLNV&, const QString&)),
-        this, SIGNAL(openDesign(const VLNV&, const QString&)), Qt::UniqueConnection);
+        if (writeQueue_.isPending(path))
+        {
+            continue;
+        }
 
-    connect(&hierarchyModel_, SIGNAL(openMemoryDesign(const VLNV&, const QString&)),
+        // The cached model no longer matches the file, so the item is validated against the file as it is and
+        // read again on the next refresh of the library.
+        VLNV const failedVLNV = pendingSaves_.take(path);
+        auto it = findDocument(failedVLNV);
+        if (it != documentCache_.end() && it->path == path)
+        {
+            bool const wasValid = it->isValid;
+
+            it->isValid = validateDocument(loadDocument(failedVLNV, *it), path);
+            it->fileSize = -1;
+            it->lastModified = 0;
+            it->contentHash.clear();
+
+            if (it->isValid != wasValid)
+            {
+                notifyValidityChanged(failedVLNV, it->isValid);
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::onCheckNextItems()
+//-----------------------------------------------------------------------------
+void LibraryHandler::onCheckNextItems()
+{
+    // Keep the batches short enough for the user interface to stay responsive.
+    constexpr qint64 BATCH_DURATION_MS = 25;
+
+    QElapsedTimer batchTimer;
+    batchTimer.start();
+
+    while (pendingChecks_.isEmpty() == false && batchTimer.elapsed() < BATCH_DURATION_MS)
+    {
+        VLNV const vlnv = pendingChecks_.takeLast();
+
+        auto it = findDocument(vlnv);
+        if (it == documentCache_.end() || it->isChecked)
+        {
+            continue;
+        }
+
+        // Models read only for the check are not kept in the cache.
+        QSharedPointer<Document> model = it->document;
+        if (model.isNull())
+        {
+            model = DocumentFileAccess::readDocument(it->path, it->contentHash);
+            cacheStatistics_.reads++;
+            it->metadata = DocumentMetadata::fromDocument(model);
+            updateDependencies(vlnv, it->metadata.dependencies);
+        }
+
+        if (model.isNull() == false)
+        {
+            TagManager::getInstance().addNewTags(model->getTags());
+        }
+
+        it->fileCount = 0;
+        it->isValid = validateDocument(model, it->path, validator_, it->fileCount);
+        it->isChecked = true;
+        checkResults_.fileCount += it->fileCount;
+        if (it->isValid == false)
+        {
+            checkResults_.documentCount++;
+
+            treeModel_.onDocumentUpdated(vlnv);
+            hierarchyModel_.onDocumentUpdated(vlnv);
+        }
+    }
+
+    int const checkedCount = checkTotal_ - pendingChecks_.size();
+    emit integrityCheckProgress(checkedCount, checkTotal_);
+
+    if (pendingChecks_.isEmpty())
+    {
+        finishBackgroundIntegrityCheck();
+    }
+    else
+    {
+        messageChannel_->showStatusMessage(tr("Validating items %1/%2...").arg(checkedCount).arg(checkTotal_));
+        checkTimer_.start();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::onDirectoryChanged()
+//-----------------------------------------------------------------------------
+void LibraryHandler::onDirectoryChanged(QString const& path)
+{
+    changedDirectories_.insert(path);
+    refreshTimer_.start();
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::onRefreshChangedDirectories()
+//-----------------------------------------------------------------------------
+void LibraryHandler::onRefreshChangedDirectories()
+{
+    // Own writes are recognized only after their file stamps have been updated, and the files being found
+    // by a library search are compared once the search has ended.
+    if (saveInProgress_ || pendingSaves_.isEmpty() == false || isLibraryScanRunning())
+    {
+        refreshTimer_.start();
+        return;
+    }
+
+    QStringList directories = changedDirectories_.values();
+    changedDirectories_.clear();
+
+    // Only the files in the changed directories are compared to the cached documents.
+    QMultiHash<QString, VLNV> itemsByDirectory;
+    for (auto it = documentCache_.cbegin(); it != documentCache_.cend(); ++it)
+    {
+        itemsByDirectory.insert(QFileInfo(it->path).absolutePath(), vlnvTable_.vlnv(it.key()));
+    }
+
+    QStringList const xmlFilter{ QStringLiteral("*.xml") };
+
+    // Find the files that have been created, modified or removed.
+    QVector<QPair<QString, VLNV> > changedFiles;
+    QVector<VLNV> removedItems;
+    while (directories.isEmpty() == false)
+    {
+        QDir directory(directories.takeFirst());
+
+        QHash<QString, VLNV> knownFiles;
+        for (VLNV const& vlnv : itemsByDirectory.values(directory.absolutePath()))
+        {
+            knownFiles.insert(QFileInfo(findDocument(vlnv)->path).absoluteFilePath(), vlnv);
+        }
+
+        QFileInfoList currentFiles;
+        if (directory.exists())
+        {
+            currentFiles = directory.entryInfoList(xmlFilter, QDir::Files);
+
+            // New directories are followed and refreshed as well.
+            for (QFileInfo const& subdirectory : directory.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot))
+            {
+                QString subdirectoryPath = subdirectory.absoluteFilePath();
+                if (followedDirectories_.contains(subdirectoryPath) == false)
+                {
+                    followDirectory(subdirectoryPath);
+                    libraryDirectories_.append(subdirectoryPath);
+                    directories.append(subdirectoryPath);
+                }
+            }
+        }
+        else
+        {
+            unfollowDirectory(directory.absolutePath());
+        }
+
+        for (QFileInfo const& fileInfo : currentFiles)
+        {
+            VLNV knownVLNV = knownFiles.take(fileInfo.absoluteFilePath());
+            if (knownVLNV.isValid())
+            {
+                DocumentInfo& knownInfo = findDocument(knownVLNV).value();
+                if (knownInfo.fileSize == fileInfo.size() &&
+                    knownInfo.lastModified == fileInfo.lastModified().toMSecsSinceEpoch())
+                {
+                    continue;
+                }
+
+                // Files only touched e.g. by a checkout keep their model and validity.
+                if (knownInfo.contentHash.isEmpty() == false &&
+                    knownInfo.contentHash == DocumentFileAccess::hashFile(fileInfo.absoluteFilePath()))
+                {
+                    updateFileStamp(knownInfo);
+                    continue;
+                }
+            }
+
+            changedFiles.append(qMakePair(fileInfo.absoluteFilePath(), knownVLNV));
+        }
+
+        removedItems.append(knownFiles.values());
+    }
+
+    QVector<VLNV> changedItems;
+    QVector<LibraryLoader::LoadTarget> newTargets;
+    for (auto const& [filePath, knownVLNV] : changedFiles)
+    {
+        LibraryLoader::LoadTarget target = loader_.readFile(filePath, messageChannel_);
+        if (knownVLNV.isValid() && knownVLNV == target.vlnv)
+        {
+            // The content has changed, so the model is read again when needed.
+            DocumentInfo& info = findDocument(knownVLNV).value();
+            info.document.clear();
+            info.evictedDocument.clear();
+            info.metadata = DocumentMetadata();
+            info.contentHash.clear();
+            dropCachedDocument(knownVLNV);
+            info.fileSize = target.size;
+            info.lastModified = target.lastModified;
+
+            changedItems.append(knownVLNV);
+            continue;
+        }
+
+        // The file now contains another document.
+        if (knownVLNV.isValid())
+        {
+            removedItems.append(knownVLNV);
+        }
+
+        if (target.vlnv.isValid())
+        {
+            newTargets.append(target);
+        }
+    }
+
+    // Items referencing the changed items must be revalidated.
+    QVector<VLNV> dependentItems;
+    auto addDependents = [this, &dependentItems](VLNV const& affectedVLNV)
+    {
+        for (VLNV const& dependentVLNV : findDependents(affectedVLNV))
+        {
+            if (dependentItems.contains(dependentVLNV) == false)
+            {
+                dependentItems.append(dependentVLNV);
+            }
+        }
+    };
+
+    // The owners of removed items can only be found before removal.
+    for (VLNV const& removedVLNV : removedItems)
+    {
+        addDependents(removedVLNV);
+    }
+
+    // Remove before adding, so that moved files are not reported as duplicates.
+    for (VLNV const& removedVLNV : removedItems)
+    {
+        dropCachedDocument(removedVLNV);
+        updateDependencies(removedVLNV, QVector<VLNV>());
+        documentCache_.remove(vlnvTable_.find(removedVLNV));
+
+        treeModel_.onRemoveVLNV(removedVLNV);
+        hierarchyModel_.onRemoveVLNV(removedVLNV);
+    }
+
+    QVector<VLNV> addedItems;
+    for (LibraryLoader::LoadTarget const& target : newTargets)
+    {
+        if (contains(target.vlnv))
+        {
+            messageChannel_->showMessage(tr("VLNV %1 was already found in the library").arg(
+                target.vlnv.toString()));
+            continue;
+        }
+
+        DocumentInfo info(target.path);
+        info.fileSize = target.size;
+        info.lastModified = target.lastModified;
+        info.metadata = target.metadata;
+
+        documentCache_.insert(vlnvTable_.insert(target.vlnv), info);
+        updateDependencies(target.vlnv, target.metadata.dependencies);
+        addedItems.append(target.vlnv);
+    }
+
+    if (addedItems.isEmpty() && changedItems.isEmpty() && removedItems.isEmpty())
+    {
+        return;
+    }
+
+    for (VLNV const& affectedVLNV : addedItems + changedItems)
+    {
+        addDependents(affectedVLNV);
+    }
+
+    dependentItems.removeIf([&addedItems, &changedItems, &removedItems](VLNV const& dependentVLNV)
+        {
+            return addedItems.contains(dependentVLNV) || changedItems.contains(dependentVLNV) ||
+                removedItems.contains(dependentVLNV);
+        });
+
+    revalidateItems(addedItems + changedItems + dependentItems);
+
+    for (VLNV const& addedVLNV : addedItems)
+    {
+        treeModel_.onAddVLNV(addedVLNV);
+        treeModel_.onDocumentUpdated(addedVLNV);
+        hierarchyModel_.onAddVLNV(addedVLNV);
+    }
+
+    for (VLNV const& changedVLNV : changedItems)
+    {
+        treeModel_.onDocumentUpdated(changedVLNV);
+        hierarchyModel_.onReloadVLNV(changedVLNV);
+
+        emit updatedVLNV(changedVLNV);
+    }
+
+    for (VLNV const& dependentVLNV : dependentItems)
+    {
+        treeModel_.onDocumentUpdated(dependentVLNV);
+        hierarchyModel_.onReloadVLNV(dependentVLNV);
+    }
+
+    messageChannel_->showStatusMessage(tr("Library updated: %1 added, %2 changed, %3 removed.").arg(
+        QString::number(addedItems.size()), QString::number(changedItems.size()),
+        QString::number(removedItems.size())));
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::syncronizeModels()
+//-----------------------------------------------------------------------------
+void LibraryHandler::syncronizeModels()
+{
+    // signals from tree model to library handler
+ 
+    connect(&treeModel_, SIGNAL(openDesign(const VLNV&, QString const&)), this, SLOT(onOpenDesign(const VLNV&, QString const&)), Qt::UniqueConnection);
+    connect(&treeModel_, SIGNAL(openMemoryDesign(const VLNV&, QString const&)), this, SLOT(onOpenMemoryDesign(const VLNV&, QString const&)), Qt::UniqueConnection);
+    connect(&treeModel_, SIGNAL(openSWDesign(const VLNV&)), this, SLOT(onOpenSWDesign(const VLNV&)), Qt::UniqueConnection);
+    connect(&treeModel_, SIGNAL(openSystemDesign(const VLNV&, QString const&)), this, SLOT(onOpenSystemDesign(const VLNV&, QString const&)), Qt::UniqueConnection);
+    connect(&treeModel_, SIGNAL(editItem(const VLNV&)), this, SLOT(onEditItem(const VLNV&)), Qt::UniqueConnection);
+
+    connect(this, SIGNAL(resetModel()),
+        &treeModel_, SLOT(onResetModel()), Qt::UniqueConnection);
+
+    //-----------------------------------------------------------------------------
+    // connect the signals from the hierarchy model
+    //-----------------------------------------------------------------------------
+
+    connect(&hierarchyModel_, SIGNAL(openDesign(const VLNV&, const QString&)),
+        this, SIGNAL(openDesign(const VLNV&, const QString&)), Qt::UniqueConnection);
+
+    connect(&hierarchyModel_, SIGNAL(openMemoryDesign(const VLNV&, const QString&)),
         this, SLOT(onOpenMemoryDesign(const VLNV&, const QString&)), Qt::UniqueConnection);
 
-    connect(&hierarchyModel_, SIGNAL(openSWDesign(const VLNV&, const QString&)),
-        this, SIGNAL(openSWDesign(const VLNV&, const QString&)), Qt::UniqueConnection);
-    connect(&hierarchyModel_, SIGNAL(openSystemDesign(const VLNV&, const QString&)),
-        this, SIGNAL(openSystemDesign(const VLNV&, const QString&)), Qt::UniqueConnection);
+    connect(&hierarchyModel_, SIGNAL(openSWDesign(const VLNV&, const QString&)),
+        this, SIGNAL(openSWDesign(const VLNV&, const QString&)), Qt::UniqueConnection);
+    connect(&hierarchyModel_, SIGNAL(openSystemDesign(const VLNV&, const QString&)),
+        this, SIGNAL(openSystemDesign(const VLNV&, const QString&)), Qt::UniqueConnection);
+
+    connect(&hierarchyModel_, SIGNAL(editItem(const VLNV&)),
+        this, SLOT(onEditItem(const VLNV&)), Qt::UniqueConnection);
+
+
+    connect(this, SIGNAL(resetModel()),
+        &hierarchyModel_, SLOT(onResetModel()), Qt::UniqueConnection);
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::showNotFoundError()
+//-----------------------------------------------------------------------------
+void LibraryHandler::showNotFoundError(VLNV const& vlnv) const
+{
+    // Missing references found by the validators of the integrity check are reported through the validity.
+    if (QThread::currentThread() != thread())
+    {
+        return;
+    }
+
+    messageChannel_->showError(tr("VLNV: %1 was not found in library.").arg(vlnv.toString()));
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::addObject()
+//-----------------------------------------------------------------------------
+bool LibraryHandler::addObject(QSharedPointer<Document> model, QString const& filePath)
+{
+    // Documents in library archives are read-only.
+    if (LibraryArchive::isArchiveEntry(filePath))
+    {
+        messageChannel_->showError(tr("File %1 is in a read-only library archive.").arg(filePath));
+        return false;
+    }
+
+    QString targetPath = filePath;
+
+    QFileInfo pathInfo(filePath);
+    if (pathInfo.isSymLink() && pathInfo.exists())
+    {
+        targetPath = pathInfo.symLinkTarget();
+    }
+
+    TagManager::getInstance().addNewTags(model->getTags());
+
+    bool const isOverwrite = contains(model->getVlnv());
+    bool const wasValid = isOverwrite && isValid(model->getVlnv());
+
+    // The cached copy is not edited, so it can be written while the caller continues to change the model.
+    // The file stamp is updated once the file has been written. The write is queued before the validation, so
+    // that the file of a new document is taken as existing.
+    QSharedPointer<Document> snapshot = model->clone();
+    VLNVTable::Handle const savedHandle = vlnvTable_.insert(model->getVlnv());
+    VLNV const savedVLNV = vlnvTable_.vlnv(savedHandle);
+
+    pendingSaves_.insert(targetPath, savedVLNV);
+    writeQueue_.enqueue(snapshot, targetPath);
+
+    auto it = documentCache_.insert(savedHandle,
+        DocumentInfo(targetPath, snapshot, validateDocument(model, targetPath), true));
+
+    if (scanProgress_.isNull() == false && scanSavedItems_.contains(savedVLNV) == false)
+    {
+        scanSavedItems_.append(savedVLNV);
+    }
+
+    dropCachedDocument(savedVLNV);
+    touchDocument(savedVLNV, *it);
+    it->metadata = DocumentMetadata::fromDocument(it->document);
+    updateDependencies(savedVLNV, it->metadata.dependencies);
+
+    if (isOverwrite && it->isValid != wasValid)
+    {
+        notifyValidityChanged(savedVLNV, it->isValid);
+    }
+
+    if (saveInProgress_)
+    {
+        if (revalidatedItems_.contains(savedVLNV) == false)
+        {
+            revalidatedItems_.append(savedVLNV);
+        }
+    }
+    else
+    {
+        revalidateDependents(QVector<VLNV>({ savedVLNV }));
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::keepUnchangedDocuments()
+//-----------------------------------------------------------------------------
+void LibraryHandler::keepUnchangedDocuments(DocumentCache const& previousDocuments)
+{
+    QVector<VLNV> changedItems;
+    for (auto previous = previousDocuments.cbegin(); previous != previousDocuments.cend(); ++previous)
+    {
+        auto current = documentCache_.find(previous.key());
+
+        bool const unchanged = current != documentCache_.end() && current->path == previous->path &&
+            ((current->fileSize == previous->fileSize && current->lastModified == previous->lastModified) ||
+            (previous->contentHash.isEmpty() == false && current->contentHash == previous->contentHash));
+
+        if (unchanged)
+        {
+            DocumentInfo kept = previous.value();
+            kept.fileSize = current->fileSize;
+            kept.lastModified = current->lastModified;
+            *current = kept;
+        }
+        else
+        {
+            VLNV const previousVLNV = vlnvTable_.vlnv(previous.key());
+            dropCachedDocument(previousVLNV);
+            updateDependencies(previousVLNV, current != documentCache_.end() ?
+                current->metadata.dependencies : QVector<VLNV>());
+            changedItems.append(previousVLNV);
+        }
+    }
+
+    for (auto current = documentCache_.cbegin(); current != documentCache_.cend(); ++current)
+    {
+        if (previousDocuments.contains(current.key()) == false)
+        {
+            changedItems.append(vlnvTable_.vlnv(current.key()));
+        }
+    }
+
+    // The references of the unchanged items may have been resolved or broken by the changes.
+    for (VLNV const& changedVLNV : changedItems)
+    {
+        for (VLNV const& dependentVLNV : findDependents(changedVLNV))
+        {
+            auto dependent = findDocument(dependentVLNV);
+            if (dependent != documentCache_.end())
+            {
+                dependent->isChecked = false;
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::loadAvailableVLNVs()
+//-----------------------------------------------------------------------------
+void LibraryHandler::loadAvailableVLNVs()
+{
+    messageChannel_->showStatusMessage(tr("Scanning library. Please wait..."));
+
+    // Read all items before validation.
+    // Validation will check for VLNVs in the library, so they must be available before validation.    
+    for (auto const& target: loader_.parseLibrary(messageChannel_, &libraryDirectories_))
+    {
+        addLoadTarget(target, documentCache_);
+    }
+    messageChannel_->showStatusMessage(tr("Ready."));
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::addLoadTarget()
+//-----------------------------------------------------------------------------
+bool LibraryHandler::addLoadTarget(LibraryLoader::LoadTarget const& target, DocumentCache& cache)
+{
+    auto existing = cache.find(vlnvTable_.find(target.vlnv));
+    if (existing != cache.end())
+    {
+        if (existing->path != target.path)
+        {
+            messageChannel_->showMessage(tr("VLNV %1 was already found in the library").arg(
+                target.vlnv.toString()));
+        }
+
+        return false;
+    }
+
+    DocumentInfo info(target.path);
+    info.fileSize = target.size;
+    info.lastModified = target.lastModified;
+    info.metadata = target.metadata;
+    info.contentHash = target.contentHash;
+
+    cache.insert(vlnvTable_.insert(target.vlnv), info);
+
+    // The references known from the library index find the owners of the item before the items are read.
+    if (target.metadata.isKnown())
+    {
+        updateDependencies(target.vlnv, target.metadata.dependencies);
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::findDocument()
+//-----------------------------------------------------------------------------
+LibraryHandler::DocumentCache::iterator LibraryHandler::findDocument(VLNV const& vlnv)
+{
+    return documentCache_.find(vlnvTable_.find(vlnv));
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::findDocument()
+//-----------------------------------------------------------------------------
+LibraryHandler::DocumentCache::const_iterator LibraryHandler::findDocument(VLNV const& vlnv) const
+{
+    return documentCache_.constFind(vlnvTable_.find(vlnv));
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::isDocumentValid()
+//-----------------------------------------------------------------------------
+bool LibraryHandler::isDocumentValid(DocumentInfo const& info) const
+{
+    // Items not yet checked are shown with their validity from the library index, or as valid if not known,
+    // until the integrity check reaches them.
+    if (info.isChecked == false)
+    {
+        return info.metadata.isKnown() == false || info.metadata.isValid;
+    }
+
+    return info.isValid;
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::startLibrarySearch()
+//-----------------------------------------------------------------------------
+void LibraryHandler::startLibrarySearch()
+{
+    cancelLibraryScan();
+
+    stopBackgroundIntegrityCheck();
+
+    // The saved documents must be on the disk before the library is read again.
+    waitForPendingWrites();
+
+    // The found items are collected separately, so that the previous items stay in the library until the search
+    // has finished and confirmed which of them have been removed.
+    scanDocuments_.clear();
+    scanSavedItems_.clear();
+    scanDirectories_.clear();
+
+    messageChannel_->showStatusMessage(tr("Scanning library..."));
+
+    QSharedPointer<LibraryLoader::ScanProgress> progress(new LibraryLoader::ScanProgress());
+    scanProgress_ = progress;
+    scanClock_.start();
+
+    LibraryLoader const* loader = &loader_;
+    scanTask_ = QtConcurrent::run([loader, progress]() { loader->scanLibrary(*progress); });
+
+    scanTimer_.start();
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::cancelLibraryScan()
+//-----------------------------------------------------------------------------
+void LibraryHandler::cancelLibraryScan()
+{
+    if (scanProgress_.isNull())
+    {
+        return;
+    }
+
+    // The worker stops at the next file, after which the search is completed with the items found so far.
+    scanProgress_->cancel();
+
+    waitForLibraryScan();
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::waitForLibraryScan()
+//-----------------------------------------------------------------------------
+void LibraryHandler::waitForLibraryScan()
+{
+    if (scanProgress_.isNull())
+    {
+        return;
+    }
+
+    scanTask_.waitForFinished();
+    onScanResultsReady();
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::onScanResultsReady()
+//-----------------------------------------------------------------------------
+void LibraryHandler::onScanResultsReady()
+{
+    if (scanProgress_.isNull())
+    {
+        return;
+    }
+
+    // Checked before taking the results, so that the last results are not left behind.
+    bool const scanFinished = scanProgress_->isFinished();
+
+    LibraryLoader::ScanProgress::Results const results = scanProgress_->takeResults();
+    for (QString const& error : results.errors)
+    {
+        messageChannel_->showError(error);
+    }
+
+    for (QString const& notice : results.notices)
+    {
+        messageChannel_->showMessage(notice);
+    }
+
+    scanDirectories_.append(results.directories);
+
+    QVector<VLNV> addedItems;
+    for (LibraryLoader::LoadTarget const& target : results.targets)
+    {
+        // New items are shown right away, the others once the search has finished.
+        if (addLoadTarget(target, scanDocuments_) && contains(target.vlnv) == false)
+        {
+            VLNVTable::Handle const handle = vlnvTable_.find(target.vlnv);
+            documentCache_.insert(handle, scanDocuments_.value(handle));
+            addedItems.append(target.vlnv);
+        }
+    }
+
+    treeModel_.onAddVLNVs(addedItems);
+
+    int const scannedCount = scanProgress_->scannedFileCount();
+    int const foundCount = scanProgress_->foundFileCount();
+    emit libraryScanProgress(scannedCount, foundCount);
+
+    if (scanFinished == false)
+    {
+        qint64 const elapsedMs = qMax(qint64(1), scanClock_.elapsed());
+        messageChannel_->showStatusMessage(tr("Scanning library: %1/%2 files, %3 items found (%4 files/s)...").arg(
+            scannedCount).arg(foundCount).arg(scanDocuments_.size()).arg(qint64(scannedCount) * 1000 / elapsedMs));
+
+        scanTimer_.start();
+        return;
+    }
+
+    scanTimer_.stop();
+
+    bool const cancelled = scanProgress_->isCancelled();
+    scanProgress_.clear();
+
+    if (cancelled)
+    {
+        messageChannel_->showMessage(tr("Library search was cancelled after %1 of %2 files. %3 items were "
+            "found.").arg(scannedCount).arg(foundCount).arg(scanDocuments_.size()));
+
+        // The items the search did not reach are kept, since they were not found to be removed.
+        for (auto it = documentCache_.cbegin(); it != documentCache_.cend(); ++it)
+        {
+            if (scanDocuments_.contains(it.key()) == false)
+            {
+                scanDocuments_.insert(it.key(), it.value());
+            }
+        }
+
+        // The directories the search did not reach are still followed.
+        scanDirectories_.append(libraryDirectories_);
+        scanDirectories_.removeDuplicates();
+    }
+
+    libraryDirectories_.swap(scanDirectories_);
+    scanDirectories_.clear();
+
+    // The items saved during the search are newer than the files the search may have read.
+    for (VLNV const& savedVLNV : scanSavedItems_)
+    {
+        auto saved = findDocument(savedVLNV);
+        if (saved != documentCache_.end())
+        {
+            scanDocuments_.insert(saved.key(), saved.value());
+        }
+    }
+    scanSavedItems_.clear();
+
+    DocumentCache previousDocuments;
+    previousDocuments.swap(documentCache_);
+    documentCache_.swap(scanDocuments_);
+
+    finishLibrarySearch(previousDocuments);
+
+    emit libraryScanFinished();
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::resetModels()
+//-----------------------------------------------------------------------------
+void LibraryHandler::resetModels()
+{
+    messageChannel_->showStatusMessage(tr("Updating library view. Please wait..."));
+
+    emit resetModel();
+
+    messageChannel_->showStatusMessage(tr("Ready."));
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::startBackgroundIntegrityCheck()
+//-----------------------------------------------------------------------------
+void LibraryHandler::startBackgroundIntegrityCheck()
+{
+    checkResults_.documentCount = 0;
+    checkResults_.fileCount = 0;
+
+    // The tags of the items kept from the previous check are taken from their summaries. The tags of the
+    // other items are added as they are checked.
+    QVector<TagData> documentTags;
+
+    pendingChecks_.clear();
+    for (auto it = documentCache_.cbegin(); it != documentCache_.cend(); ++it)
+    {
+        if (it->isChecked == false)
+        {
+            pendingChecks_.append(vlnvTable_.vlnv(it.key()));
+        }
+        else
+        {
+            if (it->isValid == false)
+            {
+                checkResults_.documentCount++;
+            }
+
+            checkResults_.fileCount += it->fileCount;
+            documentTags += it->document.isNull() ? it->metadata.tags : it->document->getTags();
+        }
+    }
+
+    // Items are taken from the end, so sort them in the reverse order to check the items alphabetically.
+    std::sort(pendingChecks_.begin(), pendingChecks_.end(),
+        [](VLNV const& first, VLNV const& second) { return second < first; });
+
+    TagManager::getInstance().setTags(documentTags);
+
+    checkTotal_ = pendingChecks_.size();
+
+    messageChannel_->showStatusMessage(tr("Validating items 0/%1...").arg(checkTotal_));
+
+    checkTimer_.start();
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::stopBackgroundIntegrityCheck()
+//-----------------------------------------------------------------------------
+void LibraryHandler::stopBackgroundIntegrityCheck()
+{
+    checkTimer_.stop();
+    pendingChecks_.clear();
+    checkTotal_ = 0;
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::finishBackgroundIntegrityCheck()
+//-----------------------------------------------------------------------------
+void LibraryHandler::finishBackgroundIntegrityCheck()
+{
+    stopBackgroundIntegrityCheck();
+
+    showIntegrityResults();
+
+    saveMetadata();
+
+    messageChannel_->showStatusMessage(tr("Ready."));
+
+    emit integrityCheckFinished();
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::watchLibraryDirectories()
+//-----------------------------------------------------------------------------
+void LibraryHandler::watchLibraryDirectories()
+{
+    stopWatchingLibrary();
+
+    // Notifications from network shares do not cover the changes made by other hosts.
+    for (QString const& location : QSettings().value(QStringLiteral("Library/ActiveLocations")).toStringList())
+    {
+        if (LibraryArchive::isArchive(location) == false && isNetworkFileSystem(location))
+        {
+            polledLocations_.append(QFileInfo(location).absoluteFilePath() + QLatin1Char('/'));
+        }
+    }
+
+    // The directories were found by the library search, so the locations are not traversed again here.
+    for (QString const& directory : libraryDirectories_)
+    {
+        followDirectory(directory);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::stopWatchingLibrary()
+//-----------------------------------------------------------------------------
+void LibraryHandler::stopWatchingLibrary()
+{
+    refreshTimer_.stop();
+    watchTimer_.stop();
+    pollTimer_.stop();
+
+    changedDirectories_.clear();
+    followedDirectories_.clear();
+    pendingWatches_.clear();
+    polledLocations_.clear();
+    polledDirectories_.clear();
+    pollPosition_ = 0;
+
+    if (libraryWatcher_.directories().isEmpty() == false)
+    {
+        libraryWatcher_.removePaths(libraryWatcher_.directories());
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::followDirectory()
+//-----------------------------------------------------------------------------
+void LibraryHandler::followDirectory(QString const& path)
+{
+    if (followedDirectories_.contains(path))
+    {
+        return;
+    }
+
+    followedDirectories_.insert(path);
 
-    connect(&hierarchyModel_, SIGNAL(editItem(const VLNV&)),
-        this, SLOT(onEditItem(const VLNV&)), Qt::UniqueConnection);
+    QString const directoryPath = path + QLatin1Char('/');
+    for (QString const& location : polledLocations_)
+    {
+        if (directoryPath.startsWith(location))
+        {
+            pollDirectory(path);
+            return;
+        }
+    }
+
+    pendingWatches_.append(path);
+    if (watchTimer_.isActive() == false)
+    {
+        watchTimer_.start();
+    }
+}
 
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::unfollowDirectory()
+//-----------------------------------------------------------------------------
+void LibraryHandler::unfollowDirectory(QString const& path)
+{
+    // The watcher stops watching a removed directory by itself.
+    followedDirectories_.remove(path);
+    libraryDirectories_.removeAll(path);
+    pendingWatches_.removeAll(path);
 
-    connect(this, SIGNAL(resetModel()),
-        &hierarchyModel_, SLOT(onResetModel()), Qt::UniqueConnection);
+    for (int i = 0; i < polledDirectories_.size(); ++i)
+    {
+        if (polledDirectories_.at(i).path == path)
+        {
+            polledDirectories_.remove(i);
+            if (pollPosition_ > i)
+            {
+                --pollPosition_;
+            }
+            break;
+        }
+    }
 }
 
 //-----------------------------------------------------------------------------
-// Function: LibraryHandler::showNotFoundError()
+// Function: LibraryHandler::pollDirectory()
 //-----------------------------------------------------------------------------
-void LibraryHandler::showNotFoundError(VLNV const& vlnv) const
+void LibraryHandler::pollDirectory(QString const& path)
 {
-    messageChannel_->showError(tr("VLNV: %1 was not found in library.").arg(vlnv.toString()));
+    PolledDirectory directory;
+    directory.path = path;
+    directory.lastModified = QFileInfo(path).lastModified().toMSecsSinceEpoch();
+    polledDirectories_.append(directory);
+
+    if (pollTimer_.isActive() == false)
+    {
+        pollTimer_.start();
+    }
 }
 
 //-----------------------------------------------------------------------------
-// Function: LibraryHandler::addObject()
+// Function: LibraryHandler::onWatchNextDirectories()
 //-----------------------------------------------------------------------------
-bool LibraryHandler::addObject(QSharedPointer<Document> model, QString const& filePath)
+void LibraryHandler::onWatchNextDirectories()
 {
-    QString targetPath = filePath;
+    QStringList const batch = pendingWatches_.mid(0, WATCH_BATCH_SIZE);
+    pendingWatches_.erase(pendingWatches_.begin(), pendingWatches_.begin() + batch.size());
 
-    QFileInfo pathInfo(filePath);
-    if (pathInfo.isSymLink() && pathInfo.exists())
+    // Directories beyond e.g. the limit of watches in the system are polled instead.
+    for (QString const& failedPath : libraryWatcher_.addPaths(batch))
     {
-        targetPath = pathInfo.symLinkTarget();
+        pollDirectory(failedPath);
     }
 
-    DocumentFileAccess::writeDocument(model, targetPath);
+    if (pendingWatches_.isEmpty() == false)
+    {
+        watchTimer_.start();
+    }
+}
 
-    TagManager::getInstance().addNewTags(model->getTags());
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::onPollNextDirectories()
+//-----------------------------------------------------------------------------
+void LibraryHandler::onPollNextDirectories()
+{
+    if (polledDirectories_.isEmpty())
+    {
+        pollTimer_.stop();
+        return;
+    }
+
+    // Adding, removing or replacing a file updates the modification time of its directory.
+    int const batchSize = qMin(POLL_BATCH_SIZE, polledDirectories_.size());
+    for (int i = 0; i < batchSize; ++i)
+    {
+        if (pollPosition_ >= polledDirectories_.size())
+        {
+            pollPosition_ = 0;
+        }
 
-    documentCache_.insert(model->getVlnv(), DocumentInfo(targetPath, model->clone(), validateDocument(model, targetPath)));
+        PolledDirectory& directory = polledDirectories_[pollPosition_++];
 
-    return true;
+        QFileInfo const directoryInfo(directory.path);
+        qint64 const lastModified = directoryInfo.exists() ? directoryInfo.lastModified().toMSecsSinceEpoch() : -1;
+        if (lastModified != directory.lastModified)
+        {
+            directory.lastModified = lastModified;
+            onDirectoryChanged(directory.path);
+        }
+    }
 }
 
 //-----------------------------------------------------------------------------
-// Function: LibraryHandler::clearCache()
+// Function: LibraryHandler::updateFileStamp()
 //-----------------------------------------------------------------------------
-void LibraryHandler::clearCache()
+void LibraryHandler::updateFileStamp(DocumentInfo& info) const
 {
-    documentCache_.clear();
+    QFileInfo fileInfo(info.path);
+    info.fileSize = fileInfo.size();
+    info.lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
 }
 
 //-----------------------------------------------------------------------------
-// Function: LibraryHandler::loadAvailableVLNVs()
+// Function: LibraryHandler::findDependents()
 //-----------------------------------------------------------------------------
-void LibraryHandler::loadAvailableVLNVs()
+QVector<VLNV> LibraryHandler::findDependents(VLNV const& vlnv) const
 {
-    messageChannel_->showStatusMessage(tr("Scanning library. Please wait..."));
+    QVector<VLNV> dependents;
+    for (VLNVTable::Handle const dependent : dependents_.value(vlnvTable_.find(vlnv)))
+    {
+        dependents.append(vlnvTable_.vlnv(dependent));
+    }
 
-    // Read all items before validation.
-    // Validation will check for VLNVs in the library, so they must be available before validation.    
-    for (auto const& target: loader_.parseLibrary(messageChannel_))
+    return dependents;
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::updateDependencies()
+//-----------------------------------------------------------------------------
+void LibraryHandler::updateDependencies(VLNV const& vlnv, QVector<VLNV> const& dependencies)
+{
+    VLNVTable::Handle handle = vlnvTable_.find(vlnv);
+    if (handle == VLNVTable::INVALID_HANDLE && dependencies.isEmpty())
     {
-        if (contains(target.vlnv))
+        return;
+    }
+
+    // The referenced documents need not be in the library, so they are added to the table only to get a handle.
+    // The type of a VLNV already in the table is kept, as the reference may not tell the type of the document.
+    auto handleFor = [this](VLNV const& reference)
+    {
+        VLNVTable::Handle const existing = vlnvTable_.find(reference);
+        return existing != VLNVTable::INVALID_HANDLE ? existing : vlnvTable_.insert(reference);
+    };
+
+    handle = handleFor(vlnv);
+
+    for (VLNVTable::Handle const previousDependency : dependencies_.take(handle))
+    {
+        auto dependents = dependents_.find(previousDependency);
+        if (dependents != dependents_.end())
         {
-            messageChannel_->showMessage(tr("VLNV %1 was already found in the library").arg(
-                target.vlnv.toString()));
+            dependents->removeAll(handle);
+            if (dependents->isEmpty())
+            {
+                dependents_.erase(dependents);
+            }
         }
-        else
+    }
+
+    QVector<VLNVTable::Handle> dependencyHandles;
+    dependencyHandles.reserve(dependencies.size());
+    for (VLNV const& dependency : dependencies)
+    {
+        VLNVTable::Handle const dependencyHandle = handleFor(dependency);
+        dependents_[dependencyHandle].append(handle);
+        dependencyHandles.append(dependencyHandle);
+    }
+
+    if (dependencyHandles.isEmpty() == false)
+    {
+        dependencies_.insert(handle, dependencyHandles);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::revalidateItems()
+//-----------------------------------------------------------------------------
+void LibraryHandler::revalidateItems(QVector<VLNV> const& items)
+{
+    for (VLNV const& vlnv : items)
+    {
+        auto it = findDocument(vlnv);
+        if (it == documentCache_.end())
+        {
+            continue;
+        }
+
+        QSharedPointer<Document> model = it->document;
+        if (model.isNull())
+        {
+            model = DocumentFileAccess::readDocument(it->path, it->contentHash);
+            cacheStatistics_.reads++;
+            it->metadata = DocumentMetadata::fromDocument(model);
+            updateDependencies(vlnv, it->metadata.dependencies);
+        }
+
+        if (model.isNull() == false)
         {
-            documentCache_.insert(target.vlnv, DocumentInfo(target.path));
+            TagManager::getInstance().addNewTags(model->getTags());
         }
+
+        it->isValid = validateDocument(model, it->path);
+        it->isChecked = true;
     }
-    messageChannel_->showStatusMessage(tr("Ready."));
 }
 
 //-----------------------------------------------------------------------------
-// Function: LibraryHandler::resetModels()
+// Function: LibraryHandler::revalidateDependents()
 //-----------------------------------------------------------------------------
-void LibraryHandler::resetModels()
+void LibraryHandler::revalidateDependents(QVector<VLNV> const& savedItems)
 {
-    messageChannel_->showStatusMessage(tr("Updating library view. Please wait..."));
+    // Follow the dependency index outwards from the saved items, visiting each item only once.
+    // The value is the validity of the item shown before the save.
+    QMap<VLNV, bool> visitedItems;
+    for (VLNV const& savedVLNV : savedItems)
+    {
+        visitedItems.insert(savedVLNV, true);
+    }
 
-    emit resetModel();
+    QVector<VLNV> dependentItems;
+    QVector<VLNV> unvisitedItems = savedItems;
+    while (unvisitedItems.isEmpty() == false)
+    {
+        for (VLNV const& dependentVLNV : findDependents(unvisitedItems.takeLast()))
+        {
+            if (visitedItems.contains(dependentVLNV) == false && contains(dependentVLNV))
+            {
+                visitedItems.insert(dependentVLNV, isValid(dependentVLNV));
+                dependentItems.append(dependentVLNV);
+                unvisitedItems.append(dependentVLNV);
+            }
+        }
+    }
 
-    messageChannel_->showStatusMessage(tr("Ready."));
+    if (dependentItems.isEmpty())
+    {
+        return;
+    }
+
+    KACTUS2_TRACE_SCOPE_DETAIL("library", "LibraryHandler::revalidateDependents",
+        QString::number(dependentItems.size()));
+
+    revalidateItems(dependentItems);
+
+    for (VLNV const& dependentVLNV : dependentItems)
+    {
+        bool const valid = findDocument(dependentVLNV)->isValid;
+        if (valid != visitedItems.value(dependentVLNV))
+        {
+            notifyValidityChanged(dependentVLNV, valid);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::notifyValidityChanged()
+//-----------------------------------------------------------------------------
+void LibraryHandler::notifyValidityChanged(VLNV const& vlnv, bool valid)
+{
+    treeModel_.onDocumentUpdated(vlnv);
+    hierarchyModel_.onDocumentUpdated(vlnv);
+
+    emit validityChanged(vlnv, valid);
 }
 
 //-----------------------------------------------------------------------------
@@ -758,6 +2254,194 @@ void LibraryHandler::showIntegrityResults() const
     {
         messageChannel_->showError(tr("Total items containing errors: %1").arg(checkResults_.documentCount));
     }
+
+    CacheStatistics const statistics = getCacheStatistics();
+    messageChannel_->showMessage(tr("Document cache: %1 hits, %2 misses, %3 evictions, %4 documents (%5 MB), "
+        "%6 MB still used after eviction.").arg(
+        QString::number(statistics.hits), QString::number(statistics.misses),
+        QString::number(statistics.evictions), QString::number(statistics.cachedDocuments),
+        QString::number(statistics.cachedBytes / (1024 * 1024)),
+        QString::number(statistics.retainedBytes / (1024 * 1024))));
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::loadDocument()
+//-----------------------------------------------------------------------------
+QSharedPointer<Document> LibraryHandler::loadDocument(VLNV const& vlnv, DocumentInfo& info,
+    QSharedPointer<Document> readModel)
+{
+    if (info.document.isNull())
+    {
+        // A model dropped from the cache but still used elsewhere is taken back instead of reading it again.
+        info.document = info.evictedDocument.toStrongRef();
+        info.evictedDocument.clear();
+
+        if (info.document.isNull())
+        {
+            // A document waiting to be written is more recent than its file.
+            if (readModel.isNull())
+            {
+                readModel = writeQueue_.queuedDocument(info.path);
+            }
+
+            if (readModel.isNull())
+            {
+                readModel = DocumentFileAccess::readDocument(info.path, info.contentHash);
+                cacheStatistics_.reads++;
+            }
+
+            info.document = readModel;
+            cacheStatistics_.misses++;
+
+            info.metadata = DocumentMetadata::fromDocument(info.document);
+            updateDependencies(vlnv, info.metadata.dependencies);
+        }
+        else
+        {
+            cacheStatistics_.hits++;
+        }
+    }
+    else
+    {
+        cacheStatistics_.hits++;
+    }
+
+    QSharedPointer<Document> document = info.document;
+    if (document.isNull() == false)
+    {
+        touchDocument(vlnv, info);
+    }
+
+    return document;
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::touchDocument()
+//-----------------------------------------------------------------------------
+void LibraryHandler::touchDocument(VLNV const& vlnv, DocumentInfo const& info)
+{
+    VLNVTable::Handle const handle = vlnvTable_.find(vlnv);
+
+    auto cached = cachedDocuments_.find(handle);
+    if (cached == cachedDocuments_.end())
+    {
+        // The parsed object graph takes several times the space of the XML in the file.
+        constexpr qint64 MEMORY_PER_FILE_BYTE = 4;
+
+        qint64 fileSize = info.fileSize >= 0 ? info.fileSize : QFileInfo(info.path).size();
+        cached = cachedDocuments_.insert(handle, CachedDocument{ fileSize * MEMORY_PER_FILE_BYTE, 0 });
+        cachedBytes_ += cached->size;
+    }
+
+    cached->lastAccess = ++accessCount_;
+    cached->isRetained = false;
+
+    if (cachedBytes_ > cacheBudget_)
+    {
+        evictDocuments();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::evictDocuments()
+//-----------------------------------------------------------------------------
+void LibraryHandler::evictDocuments()
+{
+    // Evict well below the budget so that the next documents read do not start another round immediately.
+    qint64 const targetBytes = cacheBudget_ - cacheBudget_ / 4;
+
+    QVector<QPair<quint64, VLNVTable::Handle> > leastRecentlyUsed;
+    leastRecentlyUsed.reserve(cachedDocuments_.size());
+    for (auto it = cachedDocuments_.begin(); it != cachedDocuments_.end(); )
+    {
+        if (it->isRetained == false)
+        {
+            leastRecentlyUsed.append(qMakePair(it->lastAccess, it.key()));
+        }
+        else
+        {
+            // The memory of a document dropped earlier is freed once its last user has released it.
+            auto info = documentCache_.find(it.key());
+            if (info == documentCache_.end() || info->evictedDocument.isNull())
+            {
+                cachedBytes_ -= it->size;
+                it = cachedDocuments_.erase(it);
+                continue;
+            }
+        }
+
+        ++it;
+    }
+
+    std::sort(leastRecentlyUsed.begin(), leastRecentlyUsed.end(),
+        [](QPair<quint64, VLNVTable::Handle> const& first, QPair<quint64, VLNVTable::Handle> const& second)
+        { return first.first < second.first; });
+
+    for (auto const& [lastAccess, handle] : leastRecentlyUsed)
+    {
+        if (cachedBytes_ <= targetBytes)
+        {
+            break;
+        }
+
+        // The path, VLNV and validity remain in the cache, so that the model can be read again when needed.
+        auto info = documentCache_.find(handle);
+        if (info != documentCache_.end() && info->document.isNull() == false)
+        {
+            info->evictedDocument = info->document;
+            info->document.clear();
+            cacheStatistics_.evictions++;
+        }
+
+        // Only the memory of the documents no longer used elsewhere is actually freed.
+        auto cached = cachedDocuments_.find(handle);
+        if (info == documentCache_.end() || info->evictedDocument.isNull())
+        {
+            cachedBytes_ -= cached->size;
+            cachedDocuments_.erase(cached);
+        }
+        else
+        {
+            cached->isRetained = true;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::dropCachedDocument()
+//-----------------------------------------------------------------------------
+void LibraryHandler::dropCachedDocument(VLNV const& vlnv)
+{
+    auto cached = cachedDocuments_.find(vlnvTable_.find(vlnv));
+    if (cached != cachedDocuments_.end())
+    {
+        cachedBytes_ -= cached->size;
+        cachedDocuments_.erase(cached);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::saveMetadata()
+//-----------------------------------------------------------------------------
+void LibraryHandler::saveMetadata() const
+{
+    QVector<LibraryLoader::LoadTarget> targets;
+    for (auto it = documentCache_.cbegin(); it != documentCache_.cend(); ++it)
+    {
+        if (it->metadata.isKnown())
+        {
+            LibraryLoader::LoadTarget target(vlnvTable_.vlnv(it.key()), it->path);
+            target.size = it->fileSize;
+            target.lastModified = it->lastModified;
+            target.metadata = it->metadata;
+            target.metadata.isValid = it->isValid;
+            target.contentHash = it->contentHash;
+
+            targets.append(target);
+        }
+    }
+
+    loader_.updateIndex(targets);
 }
 
 //-----------------------------------------------------------------------------
@@ -780,16 +2464,68 @@ bool LibraryHandler::removeFile(QString const& filePath) const
 //-----------------------------------------------------------------------------
 bool LibraryHandler::validateDocument(QSharedPointer<Document> document, QString const& documentPath)
 {
-    if (document.isNull() || QFileInfo(documentPath).exists() == false)
+    return validateDocument(document, documentPath, validator_, checkResults_.fileCount);
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::validateDocument()
+//-----------------------------------------------------------------------------
+bool LibraryHandler::validateDocument(QSharedPointer<Document> document, QString const& documentPath,
+    DocumentValidator& validator, int& fileCount)
+{
+    KACTUS2_TRACE_SCOPE_DETAIL("validation", "LibraryHandler::validateDocument", documentPath);
+
+    if (document.isNull() || documentFileExists(documentPath) == false)
     {
         return false;
     }
 
-    bool documentValid = validator_.validate(document);
+    bool documentValid = validator.validate(document);
 
     return documentValid && validateDependentVLNVReferencences(document) &&
         validateDependentDirectories(document, documentPath) &&
-        validateDependentFiles(document, documentPath);
+        validateDependentFiles(document, documentPath, fileCount);
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::documentFileExists()
+//-----------------------------------------------------------------------------
+bool LibraryHandler::documentFileExists(QString const& documentPath) const
+{
+    // A file waiting to be written exists once the write queue reaches it.
+    return QFileInfo(documentPath).exists() || writeQueue_.isPending(documentPath) ||
+        LibraryArchive::contains(documentPath);
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryHandler::validateDocumentsConcurrently()
+//-----------------------------------------------------------------------------
+void LibraryHandler::validateDocumentsConcurrently(QVector<CheckedDocument>& documents)
+{
+    // Split the documents into more ranges than there are workers to balance the load between them.
+    int const rangeCount = qMax(1, QThread::idealThreadCount() * 4);
+    int const rangeSize = qMax(1, (documents.size() + rangeCount - 1) / rangeCount);
+
+    QVector<QPair<int, int> > ranges;
+    for (int first = 0; first < documents.size(); first += rangeSize)
+    {
+        ranges.append(qMakePair(first, qMin(first + rangeSize, documents.size())));
+    }
+
+    // The workers write only to their own documents, so the vector must not be detached while they run.
+    CheckedDocument* const documentData = documents.data();
+
+    QtConcurrent::blockingMap(ranges, [this, documentData](QPair<int, int> const& range)
+        {
+            // The validators keep the state of the validated document, so each worker needs its own.
+            DocumentValidator validator(this);
+
+            for (int i = range.first; i < range.second; ++i)
+            {
+                CheckedDocument& document = documentData[i];
+                document.isValid = validateDocument(document.model, document.path, validator, document.fileCount);
+            }
+        });
 }
 
 //-----------------------------------------------------------------------------
@@ -814,7 +2550,7 @@ QVector<QString> LibraryHandler::findErrorsInDocument(QSharedPointer<Document> d
         return errorList;
     }
 
-    if (QFileInfo(path).exists() == false)
+    if (documentFileExists(path) == false)
     {
         errorList.append(tr("File %1 for the document was not found.").arg(path));
     }
@@ -895,7 +2631,8 @@ void LibraryHandler::findErrorsInDependentDirectories(QSharedPointer<const Docum
 //-----------------------------------------------------------------------------
 // Function: LibraryHandler::validateDependentFiles()
 //-----------------------------------------------------------------------------
-bool LibraryHandler::validateDependentFiles(QSharedPointer<Document> document, QString const& documentPath)
+bool LibraryHandler::validateDependentFiles(QSharedPointer<Document> document, QString const& documentPath,
+    int& fileCount)
 {
     for (QString const& filePath : document->getDependentFiles())
     {
@@ -905,7 +2642,7 @@ bool LibraryHandler::validateDependentFiles(QSharedPointer<Document> document, Q
         }
         else
         {
-            checkResults_.fileCount++;
+            fileCount++;
         }
     }
 
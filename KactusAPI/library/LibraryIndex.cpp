@@ -0,0 +1,175 @@
+//-----------------------------------------------------------------------------
+// File: LibraryIndex.cpp
+//-----------------------------------------------------------------------------
+// Project: Kactus2
+// Author: Kactus2 team
+// Date: 16.10.2026
+//
+// Description:
+// Persistent index of the IP-XACT files found in a single library location.
+//-----------------------------------------------------------------------------
+
+#include "LibraryIndex.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace
+{
+    //! Identifier for the index files.
+    constexpr quint32 INDEX_MAGIC = 0x4B324C49;
+
+    //! Version of the index file format. Increase whenever the stored data changes.
+    constexpr quint32 INDEX_VERSION = 5;
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryIndex::LibraryIndex()
+//-----------------------------------------------------------------------------
+LibraryIndex::LibraryIndex(QString const& location):
+location_(QDir::cleanPath(location)),
+entries_()
+{
+
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryIndex::load()
+//-----------------------------------------------------------------------------
+bool LibraryIndex::load()
+{
+    entries_.clear();
+
+    QFile indexFile(indexFilePath());
+    if (!indexFile.open(QFile::ReadOnly))
+    {
+        return false;
+    }
+
+    QDataStream stream(&indexFile);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString location;
+    qint32 entryCount = 0;
+    stream >> magic >> version >> location >> entryCount;
+
+    if (magic != INDEX_MAGIC || version != INDEX_VERSION || location != location_ || entryCount < 0)
+    {
+        return false;
+    }
+
+    entries_.reserve(entryCount);
+    for (qint32 i = 0; i < entryCount && stream.status() == QDataStream::Ok; ++i)
+    {
+        Entry entry;
+        qint32 type = VLNV::INVALID;
+        QString vendor;
+        QString library;
+        QString name;
+        QString vlnvVersion;
+
+        stream >> entry.path >> entry.size >> entry.lastModified >> type >> vendor >> library >> name >> vlnvVersion >>
+            entry.metadata >> entry.contentHash;
+
+        entry.vlnv = VLNV(static_cast<VLNV::IPXactType>(type), vendor, library, name, vlnvVersion);
+        entries_.insert(entry.path, entry);
+    }
+
+    if (stream.status() != QDataStream::Ok)
+    {
+        entries_.clear();
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryIndex::save()
+//-----------------------------------------------------------------------------
+bool LibraryIndex::save() const
+{
+    QString const filePath = indexFilePath();
+    if (!QDir().mkpath(QFileInfo(filePath).absolutePath()))
+    {
+        return false;
+    }
+
+    QSaveFile indexFile(filePath);
+    if (!indexFile.open(QFile::WriteOnly))
+    {
+        return false;
+    }
+
+    QDataStream stream(&indexFile);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    stream << INDEX_MAGIC << INDEX_VERSION << location_ << static_cast<qint32>(entries_.size());
+    for (Entry const& entry : entries_)
+    {
+        stream << entry.path << entry.size << entry.lastModified << static_cast<qint32>(entry.vlnv.getType()) <<
+            entry.vlnv.getVendor() << entry.vlnv.getLibrary() << entry.vlnv.getName() << entry.vlnv.getVersion() <<
+            entry.metadata << entry.contentHash;
+    }
+
+    return indexFile.commit();
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryIndex::find()
+//-----------------------------------------------------------------------------
+LibraryIndex::Entry LibraryIndex::find(QString const& path) const
+{
+    return entries_.value(path);
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryIndex::isCurrent()
+//-----------------------------------------------------------------------------
+bool LibraryIndex::isCurrent(Entry const& entry, qint64 size, qint64 lastModified)
+{
+    return entry.size >= 0 && entry.size == size && entry.lastModified == lastModified;
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryIndex::insert()
+//-----------------------------------------------------------------------------
+void LibraryIndex::insert(Entry const& entry)
+{
+    entries_.insert(entry.path, entry);
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryIndex::remove()
+//-----------------------------------------------------------------------------
+void LibraryIndex::remove(QString const& path)
+{
+    entries_.remove(path);
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryIndex::clear()
+//-----------------------------------------------------------------------------
+void LibraryIndex::clear()
+{
+    entries_.clear();
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryIndex::indexFilePath()
+//-----------------------------------------------------------------------------
+QString LibraryIndex::indexFilePath() const
+{
+    QByteArray const locationHash =
+        QCryptographicHash::hash(location_.toUtf8(), QCryptographicHash::Sha1).toHex();
+
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/libraryIndex/") +
+        QString::fromLatin1(locationHash) + QStringLiteral(".idx");
+}
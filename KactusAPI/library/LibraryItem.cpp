@@ -24,6 +24,7 @@ LibraryItem::LibraryItem(QObject* parent): QObject(parent),
     name_(tr("root")), 
     level_(Level::ROOT),
     childItems_(),
+    childIndex_(),
     parentItem_(0),
     vlnv_(),
     valid_(true)
@@ -38,6 +39,7 @@ QObject(parent),
     name_(), 
     level_(level),
     childItems_(), 
+    childIndex_(),
     parentItem_(parent),
     vlnv_(),
     valid_(true)
@@ -65,7 +67,9 @@ QObject(parent),
 	if (!vlnv_.isValid())
     {
 		// a new item can't yet have children so no need to search for one with a same name
-		childItems_.push_back(new LibraryItem(vlnv, static_cast<Level>(static_cast<int>(level) + 1), this));
+		LibraryItem* newItem = new LibraryItem(vlnv, static_cast<Level>(static_cast<int>(level) + 1), this);
+		childItems_.push_back(newItem);
+		childIndex_.insert(newItem->name(), newItem);
 	}
 }
 
@@ -92,6 +96,7 @@ void LibraryItem::createChild(VLNV const& vlnv, Level level)
 	// no child with same name was found so create a new child
 	LibraryItem* newItem = new LibraryItem(vlnv, static_cast<Level>(static_cast<int>(level) + 1), this);
 	childItems_.push_back(newItem);
+	childIndex_.insert(newItem->name(), newItem);
 	
 	return;
 }
@@ -208,6 +213,7 @@ void LibraryItem::removeChild(LibraryItem* childItem )
 
 	if (index != -1)
     {
+		childIndex_.remove(childItem->name());
 		delete childItems_.value(index);
 		childItems_.removeAt(index);
 	}
@@ -322,6 +328,7 @@ void LibraryItem::clear()
 {
 	qDeleteAll(childItems_);
 	childItems_.clear();
+	childIndex_.clear();
 }
 
 //-----------------------------------------------------------------------------
@@ -451,13 +458,5 @@ LibraryItem* LibraryItem::findChildForLevel(Level level, VLNV const& vlnv)
         childNameToMatch = vlnv.getVersion();
     }	
 
-    for (LibraryItem* child : childItems_)
-    {
-        if (child->name() == childNameToMatch)
-        {
-            return child;
-        }
-    }
-
-    return 0;
+    return childIndex_.value(childNameToMatch);
 }
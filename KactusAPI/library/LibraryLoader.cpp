@@ -10,39 +10,396 @@
 //-----------------------------------------------------------------------------
 
 #include "LibraryLoader.h"
+#include "LibraryArchive.h"
+#include "Tracing.h"
 
 #include <QDir>
 #include <QDirIterator>
+#include <QElapsedTimer>
 #include <QFileInfo>
 #include <QSettings>
 #include <QXmlStreamReader>
 
+#include <QtConcurrent>
+
+//-----------------------------------------------------------------------------
+// Function: LibraryLoader::ScanProgress::cancel()
+//-----------------------------------------------------------------------------
+void LibraryLoader::ScanProgress::cancel()
+{
+    cancelled_ = true;
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryLoader::ScanProgress::isCancelled()
+//-----------------------------------------------------------------------------
+bool LibraryLoader::ScanProgress::isCancelled() const
+{
+    return cancelled_;
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryLoader::ScanProgress::isFinished()
+//-----------------------------------------------------------------------------
+bool LibraryLoader::ScanProgress::isFinished() const
+{
+    return finished_;
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryLoader::ScanProgress::foundFileCount()
+//-----------------------------------------------------------------------------
+int LibraryLoader::ScanProgress::foundFileCount() const
+{
+    return foundFiles_;
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryLoader::ScanProgress::scannedFileCount()
+//-----------------------------------------------------------------------------
+int LibraryLoader::ScanProgress::scannedFileCount() const
+{
+    return scannedFiles_;
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryLoader::ScanProgress::takeResults()
+//-----------------------------------------------------------------------------
+LibraryLoader::ScanProgress::Results LibraryLoader::ScanProgress::takeResults()
+{
+    QMutexLocker locker(&mutex_);
+
+    Results results;
+    std::swap(results, results_);
+    return results;
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryLoader::ScanProgress::addResults()
+//-----------------------------------------------------------------------------
+void LibraryLoader::ScanProgress::addResults(Results const& results)
+{
+    QMutexLocker locker(&mutex_);
+
+    results_.targets.append(results.targets);
+    results_.errors.append(results.errors);
+    results_.notices.append(results.notices);
+    results_.directories.append(results.directories);
+}
+
 //-----------------------------------------------------------------------------
 // Function: LibraryLoader::parseLibrary()
 //-----------------------------------------------------------------------------
-QVector<LibraryLoader::LoadTarget> LibraryLoader::parseLibrary(MessageMediator const* messageChannel) const
+QVector<LibraryLoader::LoadTarget> LibraryLoader::parseLibrary(MessageMediator const* messageChannel,
+    QStringList* directories) const
+{
+    KACTUS2_TRACE_SCOPE("library", "LibraryLoader::parseLibrary");
+
+    ScanProgress progress;
+    scanLibrary(progress);
+
+    ScanProgress::Results const results = progress.takeResults();
+    for (QString const& error : results.errors)
+    {
+        messageChannel->showError(error);
+    }
+
+    for (QString const& notice : results.notices)
+    {
+        messageChannel->showMessage(notice);
+    }
+
+    if (directories)
+    {
+        *directories = results.directories;
+    }
+
+    return results.targets;
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryLoader::scanLibrary()
+//-----------------------------------------------------------------------------
+void LibraryLoader::scanLibrary(ScanProgress& progress) const
 {
-    QVector<LoadTarget> vlnvPaths;
+    KACTUS2_TRACE_SCOPE("library", "LibraryLoader::scanLibrary");
+
+    // The found targets are passed on when either limit is reached, so that the first items are shown
+    // quickly and large libraries are not passed on one item at a time.
+    constexpr int BATCH_SIZE = 500;
+    constexpr qint64 BATCH_INTERVAL_MS = 100;
+
+    // The changed files are read in chunks submitted during the traversal, so that reading overlaps the
+    // traversal of the rest of the location.
+    constexpr int READ_CHUNK_SIZE = 256;
+
     QStringList xmlFilter{ QStringLiteral("*.xml") };
 
+    // The state of a single location during the search.
+    struct LocationScan
+    {
+        LibraryIndex index;                                 //!< The index of the location.
+        QVector<HeaderResult> files;                        //!< All the files in the location in traversal order.
+        QVector<QFuture<HeaderResult> > changedFiles;       //!< The chunks of the files that must be read.
+    };
+
+    ScanProgress::Results batch;
+
+    // Reading of the changed files in a location starts while the next location is still being traversed.
+    QVector<LocationScan> locationScans;
     for (QString const& location : QSettings().value(QStringLiteral("Library/ActiveLocations")).toStringList())
-    {        
-        QDirIterator fileIterator(location, xmlFilter, QDir::Files,
-            QDirIterator::Subdirectories | QDirIterator::FollowSymlinks);
+    {
+        if (progress.isCancelled())
+        {
+            break;
+        }
+
+        LibraryIndex previousIndex(location);
+        previousIndex.load();
+
+        LocationScan scan{ LibraryIndex(location), QVector<HeaderResult>(), QVector<QFuture<HeaderResult> >() };
+        QVector<HeaderResult> changedFiles;
+        changedFiles.reserve(READ_CHUNK_SIZE);
+
+        // Starts reading the collected changed files.
+        auto submitChangedFiles = [&scan, &changedFiles]()
+        {
+            if (changedFiles.isEmpty() == false)
+            {
+                scan.changedFiles.append(QtConcurrent::mapped(std::move(changedFiles),
+                    &LibraryLoader::getDocumentVLNV));
+
+                changedFiles = QVector<HeaderResult>();
+                changedFiles.reserve(READ_CHUNK_SIZE);
+            }
+        };
+
+        auto addFile = [&previousIndex, &scan, &changedFiles, &submitChangedFiles, &progress](QString const& path,
+            qint64 size, qint64 lastModified)
+        {
+            HeaderResult file;
+            file.path = path;
+            file.size = size;
+            file.lastModified = lastModified;
+
+            LibraryIndex::Entry const indexed = previousIndex.find(file.path);
+            if (LibraryIndex::isCurrent(indexed, file.size, file.lastModified))
+            {
+                file.changed = false;
+                file.vlnv = indexed.vlnv;
+                file.metadata = indexed.metadata;
+                file.contentHash = indexed.contentHash;
+            }
+            else
+            {
+                // Files that have only been touched, e.g. by a checkout, are recognized from their content.
+                if (indexed.contentHash.isEmpty() == false)
+                {
+                    file.vlnv = indexed.vlnv;
+                    file.metadata = indexed.metadata;
+                    file.contentHash = indexed.contentHash;
+                }
+
+                changedFiles.append(file);
+                if (changedFiles.size() == READ_CHUNK_SIZE)
+                {
+                    submitChangedFiles();
+                }
+            }
+
+            scan.files.append(file);
+            progress.foundFiles_++;
+        };
+
+        // A location is either a directory tree or an archive of one.
+        if (LibraryArchive::isArchive(location))
+        {
+            QVector<LibraryArchive::Entry> archivedFiles;
+            if (LibraryArchive::findDocuments(location, archivedFiles) == false)
+            {
+                batch.errors.append(QObject::tr("Archive %1 could not be read.").arg(location));
+            }
+
+            for (LibraryArchive::Entry const& archivedFile : archivedFiles)
+            {
+                addFile(archivedFile.path, archivedFile.size, archivedFile.lastModified);
+            }
+        }
+        else
+        {
+            // The directories are collected in the same traversal, so that they can be watched for changes
+            // without reading the locations again.
+            batch.directories.append(QFileInfo(location).absoluteFilePath());
+
+            QDirIterator fileIterator(location, xmlFilter, QDir::Files | QDir::AllDirs | QDir::NoDotAndDotDot,
+                QDirIterator::Subdirectories | QDirIterator::FollowSymlinks);
+            while (fileIterator.hasNext() && progress.isCancelled() == false)
+            {
+                QString const path = fileIterator.next();
+
+                QFileInfo const fileInfo = fileIterator.fileInfo();
+                if (fileInfo.isDir())
+                {
+                    batch.directories.append(fileInfo.absoluteFilePath());
+                }
+                else
+                {
+                    addFile(path, fileInfo.size(), fileInfo.lastModified().toMSecsSinceEpoch());
+                }
+            }
+        }
+
+        submitChangedFiles();
+        locationScans.append(scan);
+    }
+
+    QElapsedTimer batchTimer;
+    batchTimer.start();
+
+    // Results are merged in traversal order so that the found targets do not depend on thread scheduling.
+    for (LocationScan& scan : locationScans)
+    {
+        bool locationComplete = true;
 
-        while (fileIterator.hasNext())
+        int changedIndex = 0;
+        for (HeaderResult const& indexedFile : scan.files)
         {
-            QString filePath(fileIterator.next());
+            if (progress.isCancelled())
+            {
+                locationComplete = false;
+                break;
+            }
 
-            VLNV vlnv = getDocumentVLNV(filePath, messageChannel);
-            if (vlnv.isValid())
+            // All the chunks but the last one of a location are full, so the chunk is found from the index.
+            HeaderResult const fileResult = indexedFile.changed ?
+                scan.changedFiles.at(changedIndex / READ_CHUNK_SIZE).resultAt(changedIndex % READ_CHUNK_SIZE) :
+                indexedFile;
+
+            if (indexedFile.changed)
             {
-                vlnvPaths.append(LoadTarget(vlnv, filePath));
+                ++changedIndex;
             }
+
+            if (fileResult.error.isEmpty() == false)
+            {
+                batch.errors.append(fileResult.error);
+            }
+            else if (fileResult.notice.isEmpty() == false)
+            {
+                batch.notices.append(fileResult.notice);
+            }
+            else
+            {
+                // Only files without any messages are indexed to keep reporting the problems on every search.
+                scan.index.insert({ fileResult.path, fileResult.size, fileResult.lastModified, fileResult.vlnv,
+                    fileResult.metadata, fileResult.contentHash });
+            }
+
+            if (fileResult.vlnv.isValid())
+            {
+                LoadTarget target(fileResult.vlnv, fileResult.path);
+                target.size = fileResult.size;
+                target.lastModified = fileResult.lastModified;
+                target.metadata = fileResult.metadata;
+                target.contentHash = fileResult.contentHash;
+
+                batch.targets.append(target);
+            }
+
+            progress.scannedFiles_++;
+
+            if (batch.targets.size() >= BATCH_SIZE || batchTimer.elapsed() >= BATCH_INTERVAL_MS)
+            {
+                progress.addResults(batch);
+                batch = ScanProgress::Results();
+                batchTimer.restart();
+            }
+        }
+
+        if (locationComplete)
+        {
+            scan.index.save();
         }
     }
 
-    return vlnvPaths;
+    // The files still being read are not needed after a cancel.
+    for (LocationScan& scan : locationScans)
+    {
+        for (QFuture<HeaderResult>& changedFiles : scan.changedFiles)
+        {
+            if (progress.isCancelled())
+            {
+                changedFiles.cancel();
+            }
+
+            changedFiles.waitForFinished();
+        }
+    }
+
+    progress.addResults(batch);
+    progress.finished_ = true;
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryLoader::readFile()
+//-----------------------------------------------------------------------------
+LibraryLoader::LoadTarget LibraryLoader::readFile(QString const& path, MessageMediator const* messageChannel) const
+{
+    QFileInfo const fileInfo(path);
+
+    HeaderResult file;
+    file.path = path;
+    file.size = fileInfo.size();
+    file.lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+
+    HeaderResult const fileResult = getDocumentVLNV(file);
+    if (fileResult.error.isEmpty() == false)
+    {
+        messageChannel->showError(fileResult.error);
+    }
+    else if (fileResult.notice.isEmpty() == false)
+    {
+        messageChannel->showMessage(fileResult.notice);
+    }
+
+    LoadTarget target(fileResult.vlnv, fileResult.path);
+    target.size = fileResult.size;
+    target.lastModified = fileResult.lastModified;
+
+    return target;
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryLoader::updateIndex()
+//-----------------------------------------------------------------------------
+void LibraryLoader::updateIndex(QVector<LoadTarget> const& targets) const
+{
+    for (QString const& location : QSettings().value(QStringLiteral("Library/ActiveLocations")).toStringList())
+    {
+        QString const locationPath = QDir::cleanPath(location) + QLatin1Char('/');
+
+        LibraryIndex index(location);
+        if (index.load() == false)
+        {
+            continue;
+        }
+
+        bool changed = false;
+        for (LoadTarget const& target : targets)
+        {
+            if (QDir::cleanPath(target.path).startsWith(locationPath))
+            {
+                index.insert({ target.path, target.size, target.lastModified, target.vlnv, target.metadata,
+                    target.contentHash });
+                changed = true;
+            }
+        }
+
+        if (changed)
+        {
+            index.save();
+        }
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -61,30 +418,109 @@ void LibraryLoader::clean(QStringList const& changedDirectories) const
 //-----------------------------------------------------------------------------
 // Function: LibraryLoader::getDocumentVLNV()
 //-----------------------------------------------------------------------------
-VLNV LibraryLoader::getDocumentVLNV(QString const& path, MessageMediator const* messageChannel) const
+LibraryLoader::HeaderResult LibraryLoader::getDocumentVLNV(HeaderResult const& file)
 {
+    // The root element and the VLNV are at the very start of a document, so a few kilobytes are enough to
+    // identify it. Foreign XML files, e.g. simulation dumps, are rejected without reading them any further.
+    constexpr qint64 HEADER_SIZE = 4096;
+
+    QString const& path = file.path;
+    if (file.contentHash.isEmpty() == false && DocumentFileAccess::hashFile(path) == file.contentHash)
+    {
+        return file;
+    }
+
+    // The indexed information is out of date.
+    HeaderResult unreadFile(file);
+    unreadFile.vlnv = VLNV();
+    unreadFile.metadata = DocumentMetadata();
+    unreadFile.contentHash.clear();
+
+    HeaderResult result(unreadFile);
+
+    // Files in archives are read whole, as they must be decompressed from the start anyway.
+    if (LibraryArchive::isArchiveEntry(path))
+    {
+        QByteArray content;
+        if (LibraryArchive::readEntry(path, content) == false)
+        {
+            result.error = QObject::tr("File %1 could not be read.").arg(path);
+            return result;
+        }
+
+        QXmlStreamReader documentReader(content);
+        readHeader(documentReader, result);
+        return result;
+    }
+
     QFile documentFile(path);
     if (!documentFile.open(QFile::ReadOnly))
     {
-        messageChannel->showError(QObject::tr("File %1 could not be read.").arg(path));
-        return VLNV();
+        result.error = QObject::tr("File %1 could not be read.").arg(path);
+        return result;
     }
 
-    QXmlStreamReader documentReader(&documentFile);
+    qint64 const fileSize = documentFile.size();
+    qint64 const headerSize = qMin(fileSize, HEADER_SIZE);
+
+    uchar* mappedHeader = headerSize > 0 ? documentFile.map(0, headerSize) : nullptr;
+
+    QByteArray header;
+    if (mappedHeader != nullptr)
+    {
+        header = QByteArray::fromRawData(reinterpret_cast<char const*>(mappedHeader), headerSize);
+    }
+    else
+    {
+        header.resize(headerSize);
+        header.resize(qMax(qint64(0), documentFile.read(header.data(), headerSize)));
+    }
+
+    QXmlStreamReader headerReader(header);
+    bool identified = readHeader(headerReader, result);
+
+    if (mappedHeader != nullptr)
+    {
+        documentFile.unmap(mappedHeader);
+    }
+
+    if (identified == false && headerSize < fileSize)
+    {
+        // The identifier did not fit in the header e.g. due to long comments, so the whole file is read.
+        result = unreadFile;
+        documentFile.seek(0);
+
+        QXmlStreamReader documentReader(&documentFile);
+        readHeader(documentReader, result);
+    }
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+// Function: LibraryLoader::readHeader()
+//-----------------------------------------------------------------------------
+bool LibraryLoader::readHeader(QXmlStreamReader& documentReader, HeaderResult& result)
+{
+    QString const& path = result.path;
+
     documentReader.readNextStartElement();
+    if (documentReader.error() == QXmlStreamReader::PrematureEndOfDocumentError)
+    {
+        return false;
+    }
 
     QString type = documentReader.qualifiedName().toString();
     if (type.startsWith(QStringLiteral("spirit:")))
     {
-        messageChannel->showMessage(QObject::tr("File %1 contains an IP-XACT description not compatible "
-            "with the supported standards and could not be read.").arg(path));
-        documentFile.close();
-        return VLNV();
+        result.notice = QObject::tr("File %1 contains an IP-XACT description not compatible "
+            "with the supported standards and could not be read.").arg(path);
+        return true;
     }
 
     if (!type.startsWith(QStringLiteral("ipxact:")) && !type.startsWith(QStringLiteral("kactus2:")))
     {
-        return VLNV();
+        return true;
     }
 
     // Find the first element of the VLVN.
@@ -102,16 +538,19 @@ VLNV LibraryLoader::getDocumentVLNV(QString const& path, MessageMediator const*
         vlnvString.append(documentReader.readElementText());
     }
 
-    documentFile.close();
+    if (documentReader.error() == QXmlStreamReader::PrematureEndOfDocumentError)
+    {
+        return false;
+    }
 
-    VLNV documentVLNV(VLNV::string2Type(type), vlnvString);
-    if (!documentVLNV.isValid())
+    result.vlnv = VLNV(VLNV::string2Type(type), vlnvString);
+    if (!result.vlnv.isValid())
     {
-        messageChannel->showError(QObject::tr("File %1 contains an invalid IP-XACT identifier %2.").arg(path,
-            vlnvString));
+        result.error = QObject::tr("File %1 contains an invalid IP-XACT identifier %2.").arg(path,
+            vlnvString);
     }
 
-    return documentVLNV;
+    return true;
 }
 
 //-----------------------------------------------------------------------------
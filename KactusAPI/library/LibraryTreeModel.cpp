@@ -27,6 +27,18 @@
 
 #include <QIcon>
 
+namespace
+{
+    //! Checks if the items of the given type are shown in the tree.
+    bool isShownInTree(VLNV::IPXactType documentType)
+    {
+        return documentType == VLNV::ABSTRACTIONDEFINITION || documentType == VLNV::BUSDEFINITION ||
+            documentType == VLNV::CATALOG || documentType == VLNV::COMPONENT ||
+            documentType == VLNV::DESIGN || documentType == VLNV::DESIGNCONFIGURATION ||
+            documentType == VLNV::APIDEFINITION || documentType == VLNV::COMDEFINITION;
+    }
+}
+
 //-----------------------------------------------------------------------------
 // Function: LibraryTreeModel::LibraryTreeModel()
 //-----------------------------------------------------------------------------
@@ -254,18 +266,17 @@ QVariant LibraryTreeModel::data(QModelIndex const& index, int role) const
             VLNV::IPXactType documentType = vlnv.getType();
             if (documentType == VLNV::COMPONENT)
             {
-                QSharedPointer<Component const> component = 
-                    handler_->getModelReadOnly(vlnv).staticCast<Component const>();
+                DocumentMetadata const component = handler_->getMetadata(vlnv);
 
-                if (component != 0)
+                if (component.isKnown())
                 {
-                    if (component->getImplementation() == KactusAttribute::SYSTEM)
+                    if (component.implementation == KactusAttribute::SYSTEM)
                     {
                         return QIcon(":/icons/common/graphics/system-component.png");
                     }
-                    else if (component->getImplementation() == KactusAttribute::SW)
+                    else if (component.implementation == KactusAttribute::SW)
                     {
-                        if (component->isHierarchical())
+                        if (component.isHierarchical)
                         {
                             return QIcon(":/icons/common/graphics/hier-sw-component.png");
                         }
@@ -276,7 +287,7 @@ QVariant LibraryTreeModel::data(QModelIndex const& index, int role) const
                     }
                     else
                     {
-                        if (component->isHierarchical())
+                        if (component.isHierarchical)
                         {
                             return QIcon(":/icons/common/graphics/hier-hw-component.png");
                         }
@@ -318,9 +329,9 @@ QVariant LibraryTreeModel::data(QModelIndex const& index, int role) const
             else if (documentType == VLNV::DESIGN)
             {
                 // Determine the design type.
-                QSharedPointer<const Design> design = handler_->getModelReadOnly<Design>(vlnv);
-                if (design && (design->getImplementation() == KactusAttribute::SW ||
-                    design->getImplementation() == KactusAttribute::SYSTEM))
+                DocumentMetadata const design = handler_->getMetadata(vlnv);
+                if (design.isKnown() && (design.implementation == KactusAttribute::SW ||
+                    design.implementation == KactusAttribute::SYSTEM))
                 {
                     return QIcon(":/icons/common/graphics/sw-design48x48.png");
                 }
@@ -461,6 +472,20 @@ void LibraryTreeModel::onAddVLNV(VLNV const& vlnv)
     endInsertRows();
 }
 
+//-----------------------------------------------------------------------------
+// Function: LibraryTreeModel::onAddVLNVs()
+//-----------------------------------------------------------------------------
+void LibraryTreeModel::onAddVLNVs(QVector<VLNV> const& vlnvs)
+{
+    for (VLNV const& vlnv : vlnvs)
+    {
+        if (isShownInTree(vlnv.getType()))
+        {
+            onAddVLNV(vlnv);
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 // Function: LibraryTreeModel::removeLibraryItem()
 //-----------------------------------------------------------------------------
@@ -497,11 +522,7 @@ void LibraryTreeModel::onResetModel()
     // get the items to be displayed from the data source
     for (VLNV const& item : handler_->getAllVLNVs())
     {
-        VLNV::IPXactType documentType = item.getType();
-        if (documentType == VLNV::ABSTRACTIONDEFINITION || documentType == VLNV::BUSDEFINITION ||
-            documentType == VLNV::CATALOG || documentType == VLNV::COMPONENT ||
-            documentType == VLNV::DESIGN || documentType == VLNV::DESIGNCONFIGURATION ||
-            documentType == VLNV::APIDEFINITION || documentType == VLNV::COMDEFINITION)
+        if (isShownInTree(item.getType()))
         {
             rootItem_->createChild(item, LibraryItem::Level::ROOT);
         }
@@ -0,0 +1,105 @@
+//-----------------------------------------------------------------------------
+// File: VLNVTable.cpp
+//-----------------------------------------------------------------------------
+// Project: Kactus2
+// Author: Kactus2 team
+// Date: 16.10.2026
+//
+// Description:
+// Table of interned VLNVs identified by compact integer handles.
+//-----------------------------------------------------------------------------
+
+#include <KactusAPI/include/VLNVTable.h>
+
+#include <QHashFunctions>
+
+//-----------------------------------------------------------------------------
+// Function: VLNVTable::insert()
+//-----------------------------------------------------------------------------
+VLNVTable::Handle VLNVTable::insert(VLNV const& vlnv)
+{
+    Handle handle = find(vlnv);
+    if (handle != INVALID_HANDLE)
+    {
+        if (vlnvs_.at(handle).getType() != vlnv.getType())
+        {
+            vlnvs_[handle].setType(vlnv.getType());
+        }
+
+        return handle;
+    }
+
+    VLNV interned(vlnv.getType(), internString(vlnv.getVendor()), internString(vlnv.getLibrary()),
+        internString(vlnv.getName()), internString(vlnv.getVersion()));
+
+    handle = vlnvs_.size();
+    vlnvs_.append(interned);
+    handles_.insert(Key{ interned }, handle);
+
+    return handle;
+}
+
+//-----------------------------------------------------------------------------
+// Function: VLNVTable::find()
+//-----------------------------------------------------------------------------
+VLNVTable::Handle VLNVTable::find(VLNV const& vlnv) const
+{
+    return handles_.value(Key{ vlnv }, INVALID_HANDLE);
+}
+
+//-----------------------------------------------------------------------------
+// Function: VLNVTable::vlnv()
+//-----------------------------------------------------------------------------
+VLNV VLNVTable::vlnv(Handle handle) const
+{
+    return vlnvs_.value(handle);
+}
+
+//-----------------------------------------------------------------------------
+// Function: VLNVTable::count()
+//-----------------------------------------------------------------------------
+int VLNVTable::count() const
+{
+    return vlnvs_.size();
+}
+
+//-----------------------------------------------------------------------------
+// Function: VLNVTable::stringCount()
+//-----------------------------------------------------------------------------
+int VLNVTable::stringCount() const
+{
+    return strings_.size();
+}
+
+//-----------------------------------------------------------------------------
+// Function: VLNVTable::Key::operator==()
+//-----------------------------------------------------------------------------
+bool VLNVTable::Key::operator==(Key const& other) const
+{
+    return vlnv.getVersion() == other.vlnv.getVersion() && vlnv.getName() == other.vlnv.getName() &&
+        vlnv.getLibrary() == other.vlnv.getLibrary() && vlnv.getVendor() == other.vlnv.getVendor();
+}
+
+//-----------------------------------------------------------------------------
+// Function: qHash()
+//-----------------------------------------------------------------------------
+size_t qHash(VLNVTable::Key const& key, size_t seed) noexcept
+{
+    return qHashMulti(seed, key.vlnv.getVendor(), key.vlnv.getLibrary(), key.vlnv.getName(),
+        key.vlnv.getVersion());
+}
+
+//-----------------------------------------------------------------------------
+// Function: VLNVTable::internString()
+//-----------------------------------------------------------------------------
+QString VLNVTable::internString(QString const& text)
+{
+    auto stored = strings_.constFind(text);
+    if (stored != strings_.cend())
+    {
+        return *stored;
+    }
+
+    strings_.insert(text);
+    return text;
+}
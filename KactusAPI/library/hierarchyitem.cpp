@@ -17,10 +17,6 @@
 
 #include <IPXACTmodels/common/VLNV.h>
 
-#include <IPXACTmodels/Catalog/IpxactFile.h>
-
-#include <IPXACTmodels/DesignConfiguration/DesignConfiguration.h>
-
 #include <IPXACTmodels/kactusExtensions/SystemView.h>
 
 //-----------------------------------------------------------------------------
@@ -30,7 +26,8 @@ HierarchyItem::HierarchyItem(LibraryInterface* handler, HierarchyItem* parent,
     VLNV const& vlnv, KactusAttribute::Implementation implementation, QString const& viewName):
 QObject(parent),
     vlnv_(vlnv),
-    component_(),    
+    implementation_(KactusAttribute::KTS_IMPLEMENTATION_COUNT),
+    isHierarchical_(false),
     library_(handler),
     childItems_(),
     parentItem_(parent),
@@ -38,11 +35,16 @@ QObject(parent),
     isDuplicate_(false),
     type_(HierarchyItem::ROOT),
     instanceCount_(),
-    viewName_()
+    viewName_(),
+    rootItem_(parent->rootItem_),
+    itemIndex_()
 {
     Q_ASSERT_X(handler, "HierarchyItem constructor", "Null LibraryInterface pointer given as parameter");
     Q_ASSERT_X(parent, "HierarchyItem constructor", "Null parent pointer given as parameter");
 
+    // The item is indexed before parsing, so that its children are found after it.
+    rootItem_->itemIndex_[vlnv_].append(this);
+
     connect(this, SIGNAL(errorMessage(QString const&)),
         parent, SIGNAL(errorMessage(QString const&)), Qt::UniqueConnection);
     connect(this, SIGNAL(noticeMessage(QString const&)),
@@ -96,7 +98,8 @@ QObject(parent),
 HierarchyItem::HierarchyItem(LibraryInterface* handler, QObject* parent ):
 QObject(parent),
     vlnv_(),
-    component_(),
+    implementation_(KactusAttribute::KTS_IMPLEMENTATION_COUNT),
+    isHierarchical_(false),
     library_(handler),
     childItems_(),
     parentItem_(NULL),
@@ -104,9 +107,34 @@ QObject(parent),
     isDuplicate_(false),
     type_(HierarchyItem::ROOT),
     instanceCount_(),
-    viewName_()
+    viewName_(),
+    rootItem_(this),
+    itemIndex_()
+{
+
+}
+
+//-----------------------------------------------------------------------------
+// Function: HierarchyItem::~HierarchyItem()
+//-----------------------------------------------------------------------------
+HierarchyItem::~HierarchyItem()
 {
+    // The children are deleted while the index of the root item is still available.
+    qDeleteAll(childItems_);
+    childItems_.clear();
 
+    if (rootItem_ != this)
+    {
+        auto indexedItems = rootItem_->itemIndex_.find(vlnv_);
+        if (indexedItems != rootItem_->itemIndex_.end())
+        {
+            indexedItems->removeOne(this);
+            if (indexedItems->isEmpty())
+            {
+                rootItem_->itemIndex_.erase(indexedItems);
+            }
+        }
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -122,6 +150,23 @@ void HierarchyItem::createChild(VLNV const& vlnv)
 	childItems_.append(new HierarchyItem(library_, this, vlnv));
 }
 
+//-----------------------------------------------------------------------------
+// Function: HierarchyItem::insertChild()
+//-----------------------------------------------------------------------------
+void HierarchyItem::insertChild(int index, VLNV const& vlnv, KactusAttribute::Implementation implementation,
+    QString const& viewName)
+{
+    childItems_.insert(index, new HierarchyItem(library_, this, vlnv, implementation, viewName));
+}
+
+//-----------------------------------------------------------------------------
+// Function: HierarchyItem::removeChild()
+//-----------------------------------------------------------------------------
+void HierarchyItem::removeChild(int index)
+{
+    delete childItems_.takeAt(index);
+}
+
 //-----------------------------------------------------------------------------
 // Function: HierarchyItem::parent()
 //-----------------------------------------------------------------------------
@@ -231,7 +276,7 @@ bool HierarchyItem::contains(VLNV const& vlnv) const
 void HierarchyItem::cleanUp()
 {
 	// make sure this is called only for root item
-	Q_ASSERT_X(!component_, "HierarchyItem::cleanUp", "Function was called for non-root item");
+	Q_ASSERT_X(isRoot(), "HierarchyItem::cleanUp", "Function was called for non-root item");
 
 	for (auto item = childItems_.begin(); item != childItems_.end(); ++item)
     {
@@ -250,14 +295,6 @@ void HierarchyItem::cleanUp()
 	}
 }
 
-//-----------------------------------------------------------------------------
-// Function: HierarchyItem::component()
-//-----------------------------------------------------------------------------
-QSharedPointer<Component const> HierarchyItem::component() const
-{
-	return component_;
-}
-
 //-----------------------------------------------------------------------------
 // Function: HierarchyItem::referenceCount()
 //-----------------------------------------------------------------------------
@@ -351,6 +388,11 @@ int HierarchyItem::removeItems(VLNV const& vlnv)
 //-----------------------------------------------------------------------------
 QVector<HierarchyItem*> HierarchyItem::findItems(const VLNV& vlnv)
 {
+    if (isRoot())
+    {
+        return itemIndex_.value(vlnv);
+    }
+
 	QVector<HierarchyItem*> items;
 
 	if (vlnv_ == vlnv)
@@ -486,20 +528,7 @@ void HierarchyItem::clear()
 //-----------------------------------------------------------------------------
 bool HierarchyItem::isHierarchical() const
 {
-	Q_ASSERT(component_);
-    if (component_.isNull())
-    {
-        return false;
-    }
-
-    if (component_->getImplementation() == KactusAttribute::SW)
-    {
-        return component_->hasViews();
-    }
-    else
-    {
-	    return component_->isHierarchical();
-    }
+    return isHierarchical_;
 }
 
 //-----------------------------------------------------------------------------
@@ -507,15 +536,7 @@ bool HierarchyItem::isHierarchical() const
 //-----------------------------------------------------------------------------
 KactusAttribute::Implementation HierarchyItem::getImplementation() const
 {
-    Q_ASSERT(component_);
-    if (component_)
-    {
-        return component_->getImplementation();
-    }
-    else
-    {
-        return KactusAttribute::KTS_IMPLEMENTATION_COUNT;
-    }
+    return implementation_;
 }
 
 //-----------------------------------------------------------------------------
@@ -532,7 +553,7 @@ HierarchyItem::ObjectType HierarchyItem::type() const
 void HierarchyItem::getChildren(QList<VLNV>& childList, VLNV const& owner) const
 {
 	// make sure this is called only for root item
-	Q_ASSERT_X(!component_, "HierarchyItem::getChildren", "Function was called for non-root item");
+	Q_ASSERT_X(isRoot(), "HierarchyItem::getChildren", "Function was called for non-root item");
 
 	// search each child item
 	for (HierarchyItem const* item : childItems_)
@@ -612,22 +633,30 @@ bool HierarchyItem::hasChild(VLNV const& vlnv)
 void HierarchyItem::parseComponent(VLNV const& vlnv)
 {
     type_ = HierarchyItem::COMPONENT;
-    component_ = library_->getModelReadOnly<Component>(vlnv);
-    isValid_ = library_->isValid(vlnv);
-    
-    Q_ASSERT(component_);
-    if (component_.isNull())
+
+    // The hierarchy is built from the summaries of the documents, so that the models need not be read.
+    DocumentMetadata const component = library_->getMetadata(vlnv);
+    isValid_ = component.isValid;
+
+    if (component.isKnown() == false)
     {
         return;
     }
 
-    for (QSharedPointer<View> view : *component_->getViews())
+    implementation_ = component.implementation;
+    if (implementation_ == KactusAttribute::SW)
     {
-        if (view->isHierarchical())
-        {
-            VLNV designVLNV = findDesignReference(view);
-            createChildItemForDesign(designVLNV, view->name());
-        }
+        isHierarchical_ = component.hasViews;
+    }
+    else
+    {
+        isHierarchical_ = component.isHierarchical;
+    }
+
+    for (HierarchyReference const& reference : component.hierarchyReferences)
+    {
+        VLNV designVLNV = findDesignReference(reference.vlnv);
+        createChildItemForDesign(designVLNV, reference.viewName);
     }
 }
 
@@ -637,84 +666,51 @@ void HierarchyItem::parseComponent(VLNV const& vlnv)
 void HierarchyItem::parseCatalog(VLNV const& vlnv)
 {
     type_ = HierarchyItem::CATALOG;
-    QSharedPointer<Catalog const> catalog = library_->getModelReadOnly<Catalog>(vlnv);
-    Q_ASSERT(catalog);
+    DocumentMetadata const catalog = library_->getMetadata(vlnv);
 
-    isValid_ = library_->isValid(vlnv);
+    isValid_ = catalog.isValid;
 
-    for (QSharedPointer<IpxactFile> catalogFile : *catalog->getCatalogs())
+    for (HierarchyReference const& reference : catalog.hierarchyReferences)
     {
-        if (!hasParent(catalogFile->getVlnv())) //<! Avoid cyclic instantiations.
+        if (!hasParent(reference.vlnv)) //<! Avoid cyclic instantiations.
         {
-             createChild(catalogFile->getVlnv());
-        }       
-    }
-
-    for (QSharedPointer<IpxactFile> const& busFile : *catalog->getBusDefinitions())
-    {
-        createChild(busFile->getVlnv());   
-    }
-
-    for (QSharedPointer<IpxactFile> const& abstractionFile : *catalog->getAbstractionDefinitions())
-    {
-        createChild(abstractionFile->getVlnv()); 
-    }
-
-    for (QSharedPointer<IpxactFile> const& componentFile : *catalog->getComponents())
-    {
-        createChild(componentFile->getVlnv());
+             createChild(reference.vlnv);
+        }
     }
 }
 
 //-----------------------------------------------------------------------------
 // Function: HierarchyItem::findDesignReference()
 //-----------------------------------------------------------------------------
-VLNV HierarchyItem::findDesignReference(QSharedPointer<View> view)
+VLNV HierarchyItem::findDesignReference(VLNV const& viewReference)
 {
-    if (!view->getDesignInstantiationRef().isEmpty())
+    if (viewReference.getType() != VLNV::DESIGNCONFIGURATION)
     {
-        QString viewDesign = view->getDesignInstantiationRef();
+        return viewReference;
+    }
 
-        for (QSharedPointer<DesignInstantiation> instantiation : *component_->getDesignInstantiations())
-        {
-            if (instantiation->name() == viewDesign)
-            {
-                return *instantiation->getDesignReference();
-            }
-        }
+    if (!library_->contains(viewReference))
+    {
+        isValid_ = false;
+        return viewReference;
+    }
+    else if (library_->getDocumentType(viewReference) != VLNV::DESIGNCONFIGURATION)
+    {
+        //emit errorMessage(tr("Design Configuration reference %1 was for wrong type of object.").arg(
+        //    configurationVLNV.toString()));
+        isValid_ = false;
+        return VLNV();
     }
     else
     {
-        QString viewConfiguration = view->getDesignConfigurationInstantiationRef();
-
-        for (QSharedPointer<DesignConfigurationInstantiation> instantiation : 
-            *component_->getDesignConfigurationInstantiations())
+        DocumentMetadata const configuration = library_->getMetadata(viewReference);
+        if (configuration.hierarchyReferences.isEmpty())
         {
-            if (instantiation->name() == viewConfiguration)
-            {
-                VLNV configurationVLNV = *instantiation->getDesignConfigurationReference();
-
-                if (!library_->contains(configurationVLNV))
-                {
-                    isValid_ = false;
-                    return configurationVLNV;
-                }
-                else if (library_->getDocumentType(configurationVLNV) != VLNV::DESIGNCONFIGURATION)
-                {
-                    //emit errorMessage(tr("Design Configuration reference %1 was for wrong type of object.").arg(
-                    //    configurationVLNV.toString()));
-                    isValid_ = false;
-                    return VLNV();
-                }
-                else
-                {
-                    return library_->getModelReadOnly<DesignConfiguration>(configurationVLNV)->getDesignRef();                   
-                }
-            }
+            return VLNV();
         }
-    }
 
-    return VLNV();
+        return configuration.hierarchyReferences.first().vlnv;
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -731,7 +727,7 @@ void HierarchyItem::createChildItemForDesign(VLNV const& designVLNV, QString con
         }
         else if (!hasChild(designVLNV)) 
         {
-            KactusAttribute::Implementation implementation = library_->getModelReadOnly(designVLNV)->getImplementation();
+            KactusAttribute::Implementation implementation = library_->getMetadata(designVLNV).implementation;
             HierarchyItem* designItem = new HierarchyItem(library_, this, designVLNV, implementation, viewName);
 
             connect(designItem, SIGNAL(errorMessage(QString const&)),
@@ -789,8 +785,8 @@ void HierarchyItem::parseDesign(VLNV const& vlnv, KactusAttribute::Implementatio
     instanceCount_.clear();
 
     viewName_ = viewName;
-    QSharedPointer<Design const> design = library_->getModelReadOnly<Design>(vlnv);
-    isValid_ = library_->isValid(vlnv);
+    DocumentMetadata const design = library_->getMetadata(vlnv);
+    isValid_ = design.isValid;
 
     if (implementation == KactusAttribute::HW)
     {
@@ -833,25 +829,23 @@ void HierarchyItem::parseDesign(VLNV const& vlnv, KactusAttribute::Implementatio
 //-----------------------------------------------------------------------------
 // Function: HierarchyItem::getValidComponentsInDesign()
 //-----------------------------------------------------------------------------
-QVector<VLNV> HierarchyItem::getValidComponentsInDesign(QSharedPointer<Design const> design)
+QVector<VLNV> HierarchyItem::getValidComponentsInDesign(DocumentMetadata const& design)
 {
     QVector<VLNV> componentReferences;
 
-    for (QSharedPointer<ComponentInstance> instance : *design->getComponentInstances())
+    // The summary lists the components of the instances that are not drafts.
+    for (HierarchyReference const& instance : design.hierarchyReferences)
     {
-        if (!instance->isDraft())
-        {
-            VLNV componentVLNV = *instance->getComponentRef();
+        VLNV componentVLNV = instance.vlnv;
 
-            if (isValidComponentInstanceVLNV(componentVLNV))
-            {
-                componentReferences.append(componentVLNV);
-            }
-            else
-            {
-                // Mark this object as invalid because not all items were valid.
-                isValid_ = false;
-            }
+        if (isValidComponentInstanceVLNV(componentVLNV))
+        {
+            componentReferences.append(componentVLNV);
+        }
+        else
+        {
+            // Mark this object as invalid because not all items were valid.
+            isValid_ = false;
         }
     }
 
@@ -13,6 +13,7 @@
 
 #include <KactusAPI/include/LibraryInterface.h>
 
+#include <IPXACTmodels/AbstractionDefinition/AbstractionDefinition.h>
 #include <IPXACTmodels/Component/Component.h>
 #include <IPXACTmodels/kactusExtensions/KactusAttribute.h>
 
@@ -65,15 +66,15 @@ void HierarchyModel::onResetModel()
         }
     }
 
-    // create the abstraction definitions
+    // create the abstraction definitions under their bus definitions
     for (VLNV const& absDefVlnv : absDefs) 
     {
-    	QSharedPointer<AbstractionDefinition const> absDef = 
-            handler_->getModelReadOnly(absDefVlnv).staticCast<AbstractionDefinition const>();
-
-        for (HierarchyItem* busDefItem : rootItem_->findItems(absDef->getBusType()))
+        for (HierarchyReference const& busType : handler_->getMetadata(absDefVlnv).hierarchyReferences)
         {
-    		busDefItem->createChild(absDefVlnv);
+            for (HierarchyItem* busDefItem : rootItem_->findItems(busType.vlnv))
+            {
+    		    busDefItem->createChild(absDefVlnv);
+            }
         }
     }
 
@@ -627,9 +628,109 @@ void HierarchyModel::onRemoveVLNV(VLNV const& vlnv)
     	return;
     }
 
-    beginResetModel();
-    rootItem_->removeItems(vlnv);
-    endResetModel();
+    for (HierarchyItem* removedItem : rootItem_->findItems(vlnv))
+    {
+        HierarchyItem* parentItem = removedItem->parent();
+        int row = removedItem->row();
+
+        beginRemoveRows(index(parentItem), row, row);
+        parentItem->removeChild(row);
+        endRemoveRows();
+
+        // Component is no longer valid because its design contains references to items not in the library.
+        if (parentItem->type() == HierarchyItem::COMPONENT)
+        {
+            parentItem->setValidity(false);
+
+            QModelIndex parentIndex = index(parentItem);
+            emit dataChanged(parentIndex, parentIndex.sibling(parentIndex.row(), HierarchyModel::COLUMN_COUNT - 1));
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: HierarchyModel::onAddVLNV()
+//-----------------------------------------------------------------------------
+void HierarchyModel::onAddVLNV(VLNV const& vlnv)
+{
+    if (!vlnv.isValid())
+    {
+        return;
+    }
+
+    VLNV::IPXactType documentType = vlnv.getType();
+    if (documentType == VLNV::ABSTRACTIONDEFINITION)
+    {
+        for (HierarchyReference const& busType : handler_->getMetadata(vlnv).hierarchyReferences)
+        {
+            for (HierarchyItem* busDefItem : rootItem_->findItems(busType.vlnv))
+            {
+                int row = busDefItem->getNumberOfChildren();
+
+                beginInsertRows(index(busDefItem), row, row);
+                busDefItem->insertChild(row, vlnv);
+                endInsertRows();
+            }
+        }
+    }
+
+    // Designs and configurations are created by their top-components.
+    else if (documentType == VLNV::BUSDEFINITION || documentType == VLNV::CATALOG ||
+        documentType == VLNV::COMPONENT || documentType == VLNV::APIDEFINITION ||
+        documentType == VLNV::COMDEFINITION)
+    {
+        int row = rootItem_->getNumberOfChildren();
+
+        beginInsertRows(QModelIndex(), row, row);
+        rootItem_->insertChild(row, vlnv);
+        endInsertRows();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: HierarchyModel::onReloadVLNV()
+//-----------------------------------------------------------------------------
+void HierarchyModel::onReloadVLNV(VLNV const& vlnv)
+{
+    if (!vlnv.isValid())
+    {
+        return;
+    }
+
+    for (HierarchyItem* changedItem : rootItem_->findItems(vlnv))
+    {
+        // Abstraction definitions under bus definitions are created by the model, so keep them.
+        if (changedItem->type() == HierarchyItem::BUSDEFINITION)
+        {
+            changedItem->setValidity(handler_->isValid(vlnv));
+
+            QModelIndex itemIndex = index(changedItem);
+            emit dataChanged(itemIndex, itemIndex.sibling(itemIndex.row(), HierarchyModel::COLUMN_COUNT - 1));
+            continue;
+        }
+
+        KactusAttribute::Implementation implementation = KactusAttribute::KTS_IMPLEMENTATION_COUNT;
+        if (changedItem->type() == HierarchyItem::HW_DESIGN || changedItem->type() == HierarchyItem::SW_DESIGN ||
+            changedItem->type() == HierarchyItem::SYS_DESIGN)
+        {
+            implementation = handler_->getMetadata(vlnv).implementation;
+        }
+
+        HierarchyItem* parentItem = changedItem->parent();
+        QModelIndex parentIndex = index(parentItem);
+        QString viewName = changedItem->getViewName();
+        bool isDuplicate = changedItem->isDuplicate();
+        int row = changedItem->row();
+
+        beginRemoveRows(parentIndex, row, row);
+        parentItem->removeChild(row);
+        endRemoveRows();
+
+        beginInsertRows(parentIndex, row, row);
+        parentItem->insertChild(row, vlnv, implementation, viewName);
+        parentItem->child(row)->setDuplicate(isDuplicate);
+        endInsertRows();
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -649,6 +750,9 @@ void HierarchyModel::onDocumentUpdated(VLNV const& vlnv)
     for (HierarchyItem* updatedItem : rootItem_->findItems(vlnv))
     {
         updatedItem->setValidity(isValid);
+
+        QModelIndex itemIndex = index(updatedItem);
+        emit dataChanged(itemIndex, itemIndex.sibling(itemIndex.row(), HierarchyModel::COLUMN_COUNT - 1));
     }
 }
 
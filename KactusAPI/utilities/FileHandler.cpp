@@ -10,6 +10,7 @@
 //-----------------------------------------------------------------------------
 
 #include "FileHandler.h"
+#include "LibraryArchive.h"
 
 #include <IPXACTmodels/generaldeclarations.h>
 
@@ -122,7 +123,8 @@ bool FileHandler::filePathExists(QString const& relativeTo, QString const& fileP
 
     QFileInfo fileInfo(absFilePath);
 
-    return fileInfo.exists();
+    // Files of documents in library archives are inside the same archive.
+    return fileInfo.exists() || LibraryArchive::contains(absFilePath);
 }
 
 //-----------------------------------------------------------------------------
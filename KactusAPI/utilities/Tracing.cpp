@@ -0,0 +1,315 @@
+//-----------------------------------------------------------------------------
+// File: Tracing.cpp
+//-----------------------------------------------------------------------------
+// Project: Kactus2
+// Author: Kactus2 team
+// Date: 16.10.2026
+//
+// Description:
+// Lightweight recording of timed spans for finding out where the time goes in a run.
+//-----------------------------------------------------------------------------
+
+#include <KactusAPI/include/Tracing.h>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QVector>
+
+#include <atomic>
+
+namespace
+{
+    //! A recorded span.
+    struct TraceEvent
+    {
+        char const* category = nullptr;     //<! The category of the span.
+        char const* name = nullptr;         //<! The name of the span.
+        QString detail;                     //<! Additional information on the span.
+        qint64 start = 0;                   //<! The start time in nanoseconds since tracing was first used.
+        qint64 duration = 0;                //<! The duration in nanoseconds.
+        int thread = 0;                     //<! The sequence number of the recording thread.
+    };
+
+    //! A group of counters written with the trace.
+    struct CounterGroup
+    {
+        char const* name = nullptr;         //<! The name of the group.
+        Tracing::CounterSource source;      //<! The function reading the counter values.
+    };
+
+    //! The shared state of the tracing.
+    struct TraceRecorder
+    {
+        std::atomic<bool> enabled{ false };     //<! Flag for recording the spans.
+        QElapsedTimer clock;                    //<! The time base for the events.
+        QMutex mutex;                           //<! Guards the buffer.
+        QVector<TraceEvent> events;             //<! The ring buffer of events.
+        int capacity = 1 << 16;                 //<! The maximum number of events kept.
+        int next = 0;                           //<! The position of the next event in the buffer.
+        QVector<CounterGroup> counters;         //<! The counters written with the trace.
+        QString outputPath;                     //<! The file to write the trace into at exit.
+        bool exitRoutineAdded = false;          //<! Flag for the registered exit routine.
+    };
+
+    //-----------------------------------------------------------------------------
+    // Function: recorder()
+    //-----------------------------------------------------------------------------
+    TraceRecorder& recorder()
+    {
+        static TraceRecorder instance;
+        return instance;
+    }
+
+    //-----------------------------------------------------------------------------
+    // Function: currentThread()
+    //-----------------------------------------------------------------------------
+    int currentThread()
+    {
+        // Small sequence numbers keep the threads readable in the trace viewer.
+        static std::atomic<int> threadCount{ 0 };
+        thread_local int thread = ++threadCount;
+        return thread;
+    }
+
+    //-----------------------------------------------------------------------------
+    // Function: writeOnExit()
+    //-----------------------------------------------------------------------------
+    void writeOnExit()
+    {
+        QString outputPath;
+        {
+            QMutexLocker locker(&recorder().mutex);
+            outputPath = recorder().outputPath;
+        }
+
+        if (outputPath.isEmpty() == false)
+        {
+            Tracing::writeChromeTrace(outputPath);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: Tracing::isEnabled()
+//-----------------------------------------------------------------------------
+bool Tracing::isEnabled()
+{
+    return recorder().enabled.load(std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+// Function: Tracing::setEnabled()
+//-----------------------------------------------------------------------------
+void Tracing::setEnabled(bool enabled)
+{
+    TraceRecorder& traces = recorder();
+    {
+        QMutexLocker locker(&traces.mutex);
+        if (traces.clock.isValid() == false)
+        {
+            traces.clock.start();
+        }
+    }
+
+    traces.enabled.store(enabled);
+}
+
+//-----------------------------------------------------------------------------
+// Function: Tracing::setCapacity()
+//-----------------------------------------------------------------------------
+void Tracing::setCapacity(int eventCount)
+{
+    TraceRecorder& traces = recorder();
+    QMutexLocker locker(&traces.mutex);
+
+    traces.capacity = qMax(1, eventCount);
+    traces.events.clear();
+    traces.next = 0;
+}
+
+//-----------------------------------------------------------------------------
+// Function: Tracing::clear()
+//-----------------------------------------------------------------------------
+void Tracing::clear()
+{
+    TraceRecorder& traces = recorder();
+    QMutexLocker locker(&traces.mutex);
+
+    traces.events.clear();
+    traces.next = 0;
+}
+
+//-----------------------------------------------------------------------------
+// Function: Tracing::setOutputFile()
+//-----------------------------------------------------------------------------
+void Tracing::setOutputFile(QString const& path)
+{
+    TraceRecorder& traces = recorder();
+    {
+        QMutexLocker locker(&traces.mutex);
+        traces.outputPath = path;
+
+        if (traces.exitRoutineAdded == false)
+        {
+            // Called from the destructor of the application object.
+            qAddPostRoutine(writeOnExit);
+            traces.exitRoutineAdded = true;
+        }
+    }
+
+    setEnabled(true);
+}
+
+//-----------------------------------------------------------------------------
+// Function: Tracing::enableFromEnvironment()
+//-----------------------------------------------------------------------------
+void Tracing::enableFromEnvironment()
+{
+    QString outputPath = qEnvironmentVariable("KACTUS2_TRACE_FILE");
+    if (outputPath.isEmpty() == false)
+    {
+        setOutputFile(outputPath);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: Tracing::writeChromeTrace()
+//-----------------------------------------------------------------------------
+bool Tracing::writeChromeTrace(QString const& path)
+{
+    QVector<TraceEvent> events;
+    QVector<CounterGroup> counters;
+    qint64 now = 0;
+    {
+        TraceRecorder& traces = recorder();
+        QMutexLocker locker(&traces.mutex);
+
+        counters = traces.counters;
+        now = traces.clock.isValid() ? traces.clock.nsecsElapsed() : 0;
+
+        // Once the buffer is full, the oldest event is at the position of the next write.
+        events.reserve(traces.events.size());
+        for (int i = 0; i < traces.events.size(); ++i)
+        {
+            events.append(traces.events.at((traces.next + i) % traces.events.size()));
+        }
+    }
+
+    qint64 processId = QCoreApplication::applicationPid();
+
+    QJsonArray traceEvents;
+    for (auto const& event : events)
+    {
+        QJsonObject traceEvent;
+        traceEvent.insert(QStringLiteral("name"), QString::fromLatin1(event.name));
+        traceEvent.insert(QStringLiteral("cat"), QString::fromLatin1(event.category));
+        traceEvent.insert(QStringLiteral("ph"), QStringLiteral("X"));
+        traceEvent.insert(QStringLiteral("ts"), event.start / 1000.0);
+        traceEvent.insert(QStringLiteral("dur"), event.duration / 1000.0);
+        traceEvent.insert(QStringLiteral("pid"), processId);
+        traceEvent.insert(QStringLiteral("tid"), event.thread);
+
+        if (event.detail.isEmpty() == false)
+        {
+            traceEvent.insert(QStringLiteral("args"), QJsonObject{ { QStringLiteral("detail"), event.detail } });
+        }
+
+        traceEvents.append(traceEvent);
+    }
+
+    // The counter sources may take their own locks, so they are read outside the lock of the recorder.
+    for (auto const& group : counters)
+    {
+        QJsonObject values;
+        for (auto const& counter : group.source())
+        {
+            values.insert(counter.first, counter.second);
+        }
+
+        QJsonObject counterEvent;
+        counterEvent.insert(QStringLiteral("name"), QString::fromLatin1(group.name));
+        counterEvent.insert(QStringLiteral("ph"), QStringLiteral("C"));
+        counterEvent.insert(QStringLiteral("ts"), now / 1000.0);
+        counterEvent.insert(QStringLiteral("pid"), processId);
+        counterEvent.insert(QStringLiteral("args"), values);
+
+        traceEvents.append(counterEvent);
+    }
+
+    QJsonObject trace;
+    trace.insert(QStringLiteral("traceEvents"), traceEvents);
+    trace.insert(QStringLiteral("displayTimeUnit"), QStringLiteral("ms"));
+
+    QSaveFile outputFile(path);
+    if (outputFile.open(QIODevice::WriteOnly) == false)
+    {
+        return false;
+    }
+
+    outputFile.write(QJsonDocument(trace).toJson(QJsonDocument::Compact));
+    return outputFile.commit();
+}
+
+//-----------------------------------------------------------------------------
+// Function: Tracing::addCounters()
+//-----------------------------------------------------------------------------
+void Tracing::addCounters(char const* name, CounterSource const& source)
+{
+    TraceRecorder& traces = recorder();
+    QMutexLocker locker(&traces.mutex);
+
+    traces.counters.append(CounterGroup{ name, source });
+}
+
+//-----------------------------------------------------------------------------
+// Function: Tracing::Span::Span()
+//-----------------------------------------------------------------------------
+Tracing::Span::Span(char const* category, char const* name):
+category_(category),
+name_(name)
+{
+    if (isEnabled())
+    {
+        recording_ = true;
+        start_ = recorder().clock.nsecsElapsed();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: Tracing::Span::~Span()
+//-----------------------------------------------------------------------------
+Tracing::Span::~Span()
+{
+    if (recording_ == false)
+    {
+        return;
+    }
+
+    TraceRecorder& traces = recorder();
+
+    TraceEvent event;
+    event.category = category_;
+    event.name = name_;
+    event.detail = detail_;
+    event.start = start_;
+    event.duration = traces.clock.nsecsElapsed() - start_;
+    event.thread = currentThread();
+
+    QMutexLocker locker(&traces.mutex);
+    if (traces.events.size() < traces.capacity)
+    {
+        traces.events.append(event);
+        traces.next = traces.events.size() % traces.capacity;
+    }
+    else
+    {
+        traces.events[traces.next] = event;
+        traces.next = (traces.next + 1) % traces.capacity;
+    }
+}
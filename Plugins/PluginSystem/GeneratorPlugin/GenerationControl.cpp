@@ -14,6 +14,7 @@
 #include <KactusAPI/include/MessageMediator.h>
 
 #include <KactusAPI/include/LibraryInterface.h>
+#include <KactusAPI/include/Tracing.h>
 
 #include <IPXACTmodels/Component/FileSet.h>
 #include <IPXACTmodels/Component/FileSetRef.h>
@@ -63,6 +64,8 @@ GenerationControl::GenerationControl(LibraryInterface* library,
 //-----------------------------------------------------------------------------
 bool GenerationControl::writeDocuments()
 {
+    KACTUS2_TRACE_SCOPE("generation", "GenerationControl::writeDocuments");
+
     // Remember the values chosen by the user.
     settings_->lastFileSetName_ = getViewSelection()->getFileSetName();
 
@@ -189,6 +192,8 @@ bool GenerationControl::validSelections(QString &warning)
 //-----------------------------------------------------------------------------
 void GenerationControl::parseDocuments()
 {
+    KACTUS2_TRACE_SCOPE("generation", "GenerationControl::parseDocuments");
+
     QSharedPointer<QList<QSharedPointer<GenerationOutput> > > generatedOutputs = outputControl_->getOutputs();
     if (generatedOutputs->isEmpty())
     {
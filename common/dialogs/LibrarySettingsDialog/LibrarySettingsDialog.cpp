@@ -36,6 +36,7 @@ iconProvider_(),
 libLocationsTable_(0),
 addLocationButton_(new QPushButton(QIcon(":/icons/common/graphics/add.png"), QString(), this)),
 removeLocationButton_(new QPushButton(QIcon(":/icons/common/graphics/remove.png"), QString(), this)),
+watchFileSystemBox_(new QCheckBox(tr("Follow the changes made to the library locations outside Kactus2"), this)),
 changed_(false),
 checkMarkIcon_(":/icons/common/graphics/checkMark.png")
 {
@@ -90,6 +91,8 @@ checkMarkIcon_(":/icons/common/graphics/checkMark.png")
     locationLayout->addWidget(libLocationsTable_);
     locationLayout->addWidget(listButtonBox);
 
+    watchFileSystemBox_->setToolTip(tr("Locations on network drives are checked for changes periodically."));
+
     QGroupBox* separator = new QGroupBox(this);
     separator->setFlat(true);
 
@@ -99,6 +102,7 @@ checkMarkIcon_(":/icons/common/graphics/checkMark.png")
     QVBoxLayout* topLayout = new QVBoxLayout(this);
     topLayout->addWidget(introWidget);
     topLayout->addWidget(locationGroup, 1);
+    topLayout->addWidget(watchFileSystemBox_);
     topLayout->addWidget(separator);
     topLayout->addWidget(buttonBox);
 
@@ -292,6 +296,7 @@ void LibrarySettingsDialog::accept()
     settings_.setValue("Library/Locations", locations);
     settings_.setValue("Library/DefaultLocation", defaultLocation);
     settings_.setValue("Library/ActiveLocations", activeLocations);
+    settings_.setValue("Library/WatchFileSystem", watchFileSystemBox_->isChecked());
 
     if (changed_)
     {
@@ -326,6 +331,8 @@ void LibrarySettingsDialog::loadSettings()
 
     libLocationsTable_->setCurrentIndex(QModelIndex());
 
+    watchFileSystemBox_->setChecked(settings_.value(QStringLiteral("Library/WatchFileSystem"), true).toBool());
+
     changed_ = false;
 }
 
@@ -12,6 +12,7 @@
 #ifndef LIBRARYSETTINGSDIALOG_H
 #define LIBRARYSETTINGSDIALOG_H
 
+#include <QCheckBox>
 #include <QDialog>
 #include <QFileIconProvider>
 #include <QPushButton>
@@ -151,6 +152,9 @@ private:
 	 //! OK button.
 	 QPushButton* okButton_;
 
+     //! Check box for following the changes made to the library locations on disk.
+     QCheckBox* watchFileSystemBox_;
+
 	 //! Holds the info on if the user has changed the library or not.
 	 bool changed_;
 
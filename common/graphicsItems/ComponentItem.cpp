@@ -194,6 +194,30 @@ QSharedPointer<Component> ComponentItem::componentModel() const
     return component_;
 }
 
+//-----------------------------------------------------------------------------
+// Function: ComponentItem::setSharedComponent()
+//-----------------------------------------------------------------------------
+void ComponentItem::setSharedComponent(SharedDocument<Component> const& component)
+{
+    Q_ASSERT(component.get() == component_);
+
+    sharedComponent_ = component;
+}
+
+//-----------------------------------------------------------------------------
+// Function: ComponentItem::editComponentModel()
+//-----------------------------------------------------------------------------
+QSharedPointer<Component> ComponentItem::editComponentModel()
+{
+    if (sharedComponent_.isNull() == false && sharedComponent_.isDetached() == false)
+    {
+        component_ = sharedComponent_.edit();
+        onComponentModelCopied();
+    }
+
+    return component_;
+}
+
 //-----------------------------------------------------------------------------
 // Function: ComponentItem::getComponentInstance()
 //-----------------------------------------------------------------------------
@@ -432,3 +456,11 @@ void ComponentItem::checkPortLabelSize(ConnectionEndpoint* port, QList<Connectio
         port->shortenNameLabel(ComponentItem::COMPONENTWIDTH);
     }
 }
+
+//-----------------------------------------------------------------------------
+// Function: ComponentItem::onComponentModelCopied()
+//-----------------------------------------------------------------------------
+void ComponentItem::onComponentModelCopied()
+{
+    // The base item has no port items of its own.
+}
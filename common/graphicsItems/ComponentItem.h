@@ -20,6 +20,8 @@
 #include <common/layouts/IVGraphicsLayout.h>
 #include <common/layouts/VCollisionLayout.h>
 
+#include <KactusAPI/include/SharedDocument.h>
+
 #include <QGraphicsRectItem>
 #include <QSharedPointer>
 
@@ -123,6 +125,20 @@ public:
      */
     QSharedPointer<Component> componentModel() const;
 
+    /*!
+     *  Sets the component model shared with the other instances of the component. The item refers to the
+     *  shared model until it edits the model.
+     *
+     *    @param [in] component   The shared component model given to the constructor.
+     */
+    void setSharedComponent(SharedDocument<Component> const& component);
+
+    /*!
+     *  Returns the IP-XACT component model for editing. A model shared with other instances is first copied
+     *  for this item.
+     */
+    QSharedPointer<Component> editComponentModel();
+
     /*!
      *  Returns the IP-XACT component instance.
      */
@@ -255,6 +271,12 @@ protected:
      */
     void checkPortLabelSize(ConnectionEndpoint* port, QList<ConnectionEndpoint*> const& otherSide);
 
+    /*!
+     *  Called when the item has copied the shared component model for editing. The port items must then
+     *  refer to the interfaces of the copy.
+     */
+    virtual void onComponentModelCopied();
+
     static constexpr int SPACING = GridSize;
     static constexpr int MIN_Y_PLACEMENT = 3 * GridSize;
     static constexpr int BOTTOM_MARGIN = 2 * GridSize;
@@ -280,6 +302,9 @@ private:
     //! The component model.
     QSharedPointer<Component> component_ = nullptr;
 
+    //! The component model shared with the other instances, if any.
+    SharedDocument<Component> sharedComponent_;
+
     //! The component instance.
     QSharedPointer<ComponentInstance> componentInstance_ = nullptr;
 
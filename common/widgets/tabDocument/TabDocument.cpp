@@ -402,7 +402,7 @@ bool TabDocument::fileExists()
     {
         return false;
     }
-    return libHandler_->getModel<Document>(getIdentifyingVLNV())!=nullptr;
+    return libHandler_->getModelReadOnly(getIdentifyingVLNV()) != nullptr;
 }
 
 //-----------------------------------------------------------------------------
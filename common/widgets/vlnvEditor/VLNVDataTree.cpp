@@ -14,7 +14,7 @@
 #include <KactusAPI/include/LibraryInterface.h>
 #include <KactusAPI/include//LibraryItem.h>
 
-#include <IPXACTmodels/Component/Component.h>
+#include <KactusAPI/include/DocumentMetadata.h>
 
 //-----------------------------------------------------------------------------
 // Function: VLNVDataNode()
@@ -201,21 +201,16 @@ void VLNVDataTree::parseSubtree(LibraryInterface* lh, LibraryItem const* libItem
             KactusAttribute::Firmness firmness = KactusAttribute::KTS_REUSE_LEVEL_COUNT;
             KactusAttribute::ProductHierarchy hierarchy = KactusAttribute::KTS_PRODHIER_COUNT;
             KactusAttribute::Implementation implementation = KactusAttribute::KTS_IMPLEMENTATION_COUNT;
-            Document::Revision revision = Document::Revision::Unknown;
-            
-            QSharedPointer<Document const> document = lh->getModelReadOnly(vlnv);
-            if (document)
-            {
-                revision = document->getRevision();
-            }
 
-            if (useComponentFilters)
+            // The summary is enough for filtering, so the models need not be read.
+            DocumentMetadata const metadata = lh->getMetadata(vlnv);
+            Document::Revision revision = metadata.revision;
+
+            if (useComponentFilters && metadata.isKnown())
             {
-                // Retrieve the library component for filtering.
-                QSharedPointer<Component const> component = document.dynamicCast<Component const>();
-                firmness = component->getFirmness();
-                hierarchy = component->getHierarchy();
-                implementation = component->getImplementation();
+                firmness = metadata.firmness;
+                hierarchy = metadata.productHierarchy;
+                implementation = metadata.implementation;
             }
 
             bool passesComponentFilters = (!firmnessFilterEnabled_ || firmnessFilter_ == firmness) &&
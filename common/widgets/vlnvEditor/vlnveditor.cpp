@@ -330,8 +330,8 @@ void VLNVEditor::dropEvent(QDropEvent* event)
         }
         else if (type == VLNV::DESIGNCONFIGURATION)
         {
-            QSharedPointer<Document> libComp = handler_->getModel(vlnv);
-            QSharedPointer<DesignConfiguration> designConf = libComp.staticCast<DesignConfiguration>();
+            QSharedPointer<DesignConfiguration const> designConf =
+                handler_->getModelReadOnly(vlnv).staticCast<DesignConfiguration const>();
             if (designConf->getDesignConfigImplementation() != implementationFilter_)
             {
                 return;
@@ -379,8 +379,8 @@ void VLNVEditor::dropEvent(QDropEvent* event)
     }
     else if(type == VLNV::ABSTRACTIONDEFINITION)
     {
-        QSharedPointer<Document> libComp = handler_->getModel(vlnv);
-        QSharedPointer<AbstractionDefinition> absDef = libComp.staticCast<AbstractionDefinition>();
+        QSharedPointer<AbstractionDefinition const> absDef =
+            handler_->getModelReadOnly(vlnv).staticCast<AbstractionDefinition const>();
         Q_ASSERT(absDef);
 
         VLNV busDefVLNV = absDef->getBusType();
@@ -259,12 +259,13 @@ void AdhocPortEditor::setTiedValueEditorToolTip(QString const& tiedValue)
 QString AdhocPortEditor::formattedValueFor(QString const& expression) const
 {
     bool isValidExpression = false;
-    QString value = expressionParser_->parseExpression(expression, &isValidExpression);
+    int base = 0;
+    QString value = expressionParser_->parseExpressionWithBase(expression, &isValidExpression, &base);
 
     if (isValidExpression)
     {
         ValueFormatter formatter;
-        return formatter.format(value, expressionParser_->baseForExpression(expression));
+        return formatter.format(value, base);
     }
     else
     {
@@ -209,7 +209,7 @@ ActiveBusInterfaceItem* HWComponentItem::addPort(QPointF const& pos)
     QSharedPointer<BusInterface> busIf(new BusInterface());
     busIf->setName(name);
     busIf->setInterfaceMode(General::INTERFACE_MODE_COUNT);
-    componentModel()->getBusInterfaces()->append(busIf);
+    editComponentModel()->getBusInterfaces()->append(busIf);
 
     // Create the visualization for the bus interface.
     auto draftPort = new ActiveBusInterfaceItem(busIf, getLibraryInterface(), this);
@@ -233,7 +233,7 @@ void HWComponentItem::addPort(HWConnectionEndpoint* port)
     if (port->type() == ActiveBusInterfaceItem::Type)
     {
         // Add the bus interface to the component.
-        componentModel()->getBusInterfaces()->append(port->getBusInterface());
+        editComponentModel()->getBusInterfaces()->append(port->getBusInterface());
     }
 
     addPortToSideByPosition(port);
@@ -246,6 +246,12 @@ void HWComponentItem::addPort(HWConnectionEndpoint* port)
 //-----------------------------------------------------------------------------
 void HWComponentItem::removePort(HWConnectionEndpoint* port)
 {
+    if (port->type() == ActiveBusInterfaceItem::Type)
+    {
+        // The model is copied while the port is still listed, so that the port refers to the copy.
+        editComponentModel();
+    }
+
     disconnect(port, SIGNAL(moved(ConnectionEndpoint*)), this, SIGNAL(endpointMoved(ConnectionEndpoint*)));
 
     leftPorts_.removeAll(port);
@@ -463,6 +469,35 @@ void HWComponentItem::mouseReleaseEvent(QGraphicsSceneMouseEvent* event)
     }
 }
 
+//-----------------------------------------------------------------------------
+// Function: HWComponentItem::onComponentModelCopied()
+//-----------------------------------------------------------------------------
+void HWComponentItem::onComponentModelCopied()
+{
+    setAdHocData(componentModel(), getPortAdHocVisibilities());
+
+    for (ConnectionEndpoint* endpoint : leftPorts_ + rightPorts_)
+    {
+        if (auto busPort = dynamic_cast<ActiveBusInterfaceItem*>(endpoint); busPort != nullptr)
+        {
+            QSharedPointer<BusInterface> copiedInterface =
+                componentModel()->getBusInterface(busPort->getBusInterface()->name());
+            if (copiedInterface)
+            {
+                busPort->setBusInterface(copiedInterface);
+            }
+        }
+        else if (auto adhocPort = dynamic_cast<ActivePortItem*>(endpoint); adhocPort != nullptr)
+        {
+            QSharedPointer<Port> copiedPort = componentModel()->getPort(adhocPort->name());
+            if (copiedPort)
+            {
+                adhocPort->setPort(copiedPort);
+            }
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 // Function: HWComponentItem::positionBusInterfaceTerminals()
 //-----------------------------------------------------------------------------
@@ -181,6 +181,9 @@ protected:
     //! Called when the user release the mouse.
     void mouseReleaseEvent(QGraphicsSceneMouseEvent* event);
 
+    //! Called when the item has copied the shared component model for editing.
+    void onComponentModelCopied() override;
+
 private:
 	
 	//! No copying
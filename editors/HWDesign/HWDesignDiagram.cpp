@@ -73,6 +73,7 @@
 #include <editors/HWDesign/undoCommands/TopAdHocVisibilityChangeCommand.h>
 
 #include <KactusAPI/include/LibraryHandler.h>
+#include <KactusAPI/include/Tracing.h>
 
 #include <IPXACTmodels/common/DirectionTypes.h>
 #include <IPXACTmodels/common/PartSelect.h>
@@ -130,7 +131,8 @@ designAndInstancesParameterFinder_(designandInstancesParameterFinder)
 //-----------------------------------------------------------------------------
 void HWDesignDiagram::loadDesign(QSharedPointer<Design> design)
 {
-    
+    KACTUS2_TRACE_SCOPE_DETAIL("diagram", "HWDesignDiagram::loadDesign", design->getVlnv().toString());
+
     if (QList<QSharedPointer<ColumnDesc> > designColumns = design->getColumns(); 
         designColumns.isEmpty())
     {
@@ -181,9 +183,10 @@ void HWDesignDiagram::loadDesign(QSharedPointer<Design> design)
         }        
     }
 
+    QMap<VLNV, SharedDocument<Component> > instancedComponents;
     for (QSharedPointer<ComponentInstance> instance : *design->getComponentInstances())
     {
-        createComponentItem(instance, design);
+        createComponentItem(instance, design, instancedComponents);
     }
 
     for (QSharedPointer<Interconnection> interconnection : *design->getInterconnections())
@@ -2009,13 +2012,24 @@ void HWDesignDiagram::replace(ComponentItem* destComp, ComponentItem* sourceComp
 //-----------------------------------------------------------------------------
 // Function: HWDesignDiagram::createComponentItem()
 //-----------------------------------------------------------------------------
-void HWDesignDiagram::createComponentItem(QSharedPointer<ComponentInstance> instance, QSharedPointer<Design> design)
+void HWDesignDiagram::createComponentItem(QSharedPointer<ComponentInstance> instance, QSharedPointer<Design> design,
+    QMap<VLNV, SharedDocument<Component> >& instancedComponents)
 {
     QSharedPointer<Component> component;
+    SharedDocument<Component> instancedComponent;
 
     if (!instance->isDraft())
     {
-        component = getLibraryInterface()->getModel<Component>(*instance->getComponentRef());
+        VLNV const& componentVLNV = *instance->getComponentRef();
+        if (instancedComponents.contains(componentVLNV) == false)
+        {
+            instancedComponents.insert(componentVLNV,
+                getLibraryInterface()->getSharedModel<Component>(componentVLNV));
+        }
+
+        // The instances share the component. An item copies it only when it edits it, e.g. to add a port.
+        instancedComponent = instancedComponents.value(componentVLNV);
+        component = qSharedPointerConstCast<Component>(instancedComponent.get());
 
         if (!component && instance->getComponentRef()->isValid())
         {
@@ -2032,6 +2046,10 @@ void HWDesignDiagram::createComponentItem(QSharedPointer<ComponentInstance> inst
     }
     
     auto item = new HWComponentItem(getLibraryInterface(), instance, component);
+    if (instancedComponent)
+    {
+        item->setSharedComponent(instancedComponent);
+    }
 
     // Check if the position is not found.
     // Migrate from the old layout to the column based layout.
@@ -2106,15 +2124,11 @@ bool HWDesignDiagram::referenceFinderContainsComponent(QSharedPointer<Component>
     {
         if (instance->getComponentRef())
         {
-            QSharedPointer<Document> componentDocument =
-                getLibraryInterface()->getModel(*instance->getComponentRef().data());
-            if (componentDocument)
+            QSharedPointer<Component const> instancedComponent =
+                getLibraryInterface()->getModelReadOnly<Component>(*instance->getComponentRef().data());
+            if (instancedComponent && instancedComponent->getVlnv() == component->getVlnv())
             {
-                QSharedPointer<Component> instancedComponent = componentDocument.dynamicCast<Component>();
-                if (instancedComponent && instancedComponent->getVlnv() == component->getVlnv())
-                {
-                    return true;
-                }
+                return true;
             }
         }
     }
@@ -16,6 +16,8 @@
 
 #include <editors/common/ComponentDesignDiagram.h>
 
+#include <KactusAPI/include/SharedDocument.h>
+
 #include <IPXACTmodels/generaldeclarations.h>
 
 #include <IPXACTmodels/Component/BusInterface.h>
@@ -650,10 +652,13 @@ private:
     /*!
      *  Creates a graphics item for component instance and adds it to the diagram.
      *
-     *    @param [in] instance    The instance to create item for.
-     *    @param [in] design      The design containing the instance.
+     *    @param [in] instance                The instance to create item for.
+     *    @param [in] design                  The design containing the instance.
+     *    @param [in/out] instancedComponents The components read for the instances so far. The component is
+     *                                        read from the library once and shared by the instances.
      */
-    void createComponentItem(QSharedPointer<ComponentInstance> instance, QSharedPointer<Design> design);
+    void createComponentItem(QSharedPointer<ComponentInstance> instance, QSharedPointer<Design> design,
+        QMap<VLNV, SharedDocument<Component> >& instancedComponents);
 
     /*!
      *  Finds a port item on a component item or creates one if not found.
@@ -23,6 +23,7 @@
 #include <KactusAPI/include/ParameterCache.h>
 #include <KactusAPI/include/ListParameterFinder.h>
 #include <KactusAPI/include/MultipleParameterFinder.h>
+#include <KactusAPI/include/Tracing.h>
 #include <KactusAPI/include/ComponentInstanceParameterFinder.h>
 #include <KactusAPI/include/DesignParameterFinder.h>
 
@@ -77,6 +78,8 @@ ConnectivityGraphFactory::~ConnectivityGraphFactory()
 QSharedPointer<ConnectivityGraph> ConnectivityGraphFactory::createConnectivityGraph(
     QSharedPointer<const Component> topComponent, QString const& activeView)
 {
+    KACTUS2_TRACE_SCOPE("connectivity", "ConnectivityGraphFactory::createConnectivityGraph");
+
     QSharedPointer<ConnectivityGraph> graph(new ConnectivityGraph());
 
     if (topComponent)
@@ -63,6 +63,14 @@ QSharedPointer<Component> SWConnectionEndpoint::getOwnerComponent() const
     return containingComponent_;
 }
 
+//-----------------------------------------------------------------------------
+// Function: SWConnectionEndpoint::setOwnerComponent()
+//-----------------------------------------------------------------------------
+void SWConnectionEndpoint::setOwnerComponent(QSharedPointer<Component> component)
+{
+    containingComponent_ = component;
+}
+
 //-----------------------------------------------------------------------------
 // Function: SWConnectionEndpoint::getNameLabel()
 //-----------------------------------------------------------------------------
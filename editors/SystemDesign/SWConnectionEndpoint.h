@@ -122,6 +122,13 @@ public:
 	 */
 	virtual QSharedPointer<Component> getOwnerComponent() const;
 
+    /*!
+     *  Sets the component that owns this interface.
+     *
+     *    @param [in] component   The owner component.
+     */
+    virtual void setOwnerComponent(QSharedPointer<Component> component);
+
 protected:
 
     /*!
@@ -137,6 +137,23 @@ QSharedPointer<ApiInterface> SWPortItem::getApiInterface() const
     return apiInterface_;
 }
 
+//-----------------------------------------------------------------------------
+// Function: SWPortItem::setOwnerComponent()
+//-----------------------------------------------------------------------------
+void SWPortItem::setOwnerComponent(QSharedPointer<Component> component)
+{
+    SWConnectionEndpoint::setOwnerComponent(component);
+
+    if (isCom() && component->getComInterface(comInterface_->name()))
+    {
+        comInterface_ = component->getComInterface(comInterface_->name());
+    }
+    else if (isApi() && component->getApiInterface(apiInterface_->name()))
+    {
+        apiInterface_ = component->getApiInterface(apiInterface_->name());
+    }
+}
+
 //-----------------------------------------------------------------------------
 // Function: SWPortItem::updateInterface()
 //-----------------------------------------------------------------------------
@@ -192,6 +192,13 @@ public:
      */
     virtual QSharedPointer<ApiInterface> getApiInterface() const;
 
+    /*!
+     *  Sets the component that owns the port. The port then refers to the interface of the same name in it.
+     *
+     *    @param [in] component   The owner component.
+     */
+    void setOwnerComponent(QSharedPointer<Component> component) override;
+
     /*!
      *  Returns true if the port represents a hierarchical connection.
      */
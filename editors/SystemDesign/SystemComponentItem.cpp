@@ -174,9 +174,10 @@ void SystemComponentItem::addPort(SWPortItem* port)
     {
         if (!getComponentInstance()->isDraft())
         {
-            QList<QSharedPointer<ApiInterface> > apiInterfaces = componentModel()->getApiInterfaces();
+            QSharedPointer<Component> component = editComponentModel();
+            QList<QSharedPointer<ApiInterface> > apiInterfaces = component->getApiInterfaces();
             apiInterfaces.append(port->getApiInterface());
-            componentModel()->setApiInterfaces(apiInterfaces);
+            component->setApiInterfaces(apiInterfaces);
         }
 
         getComponentInstance()->updateApiInterfacePosition(port->name(), port->pos());
@@ -185,9 +186,10 @@ void SystemComponentItem::addPort(SWPortItem* port)
     {
         if (!getComponentInstance()->isDraft())
         {
-            QList<QSharedPointer<ComInterface> > comInterfaces = componentModel()->getComInterfaces();
+            QSharedPointer<Component> component = editComponentModel();
+            QList<QSharedPointer<ComInterface> > comInterfaces = component->getComInterfaces();
             comInterfaces.append(port->getComInterface());
-            componentModel()->setComInterfaces(comInterfaces);
+            component->setComInterfaces(comInterfaces);
         }
 
         getComponentInstance()->updateComInterfacePosition(port->name(), port->pos());
@@ -205,6 +207,12 @@ void SystemComponentItem::addPort(SWPortItem* port)
 //-----------------------------------------------------------------------------
 void SystemComponentItem::removePort(SWPortItem* port)
 {
+    if (port->getType() == SWPortItem::ENDPOINT_TYPE_API || port->getType() == SWPortItem::ENDPOINT_TYPE_COM)
+    {
+        // The model is copied while the port is still listed, so that the port refers to the copy.
+        editComponentModel();
+    }
+
     leftPorts_.removeAll(port);
     rightPorts_.removeAll(port);
     
@@ -439,6 +447,20 @@ void SystemComponentItem::revalidateConnections()
     }
 }
 
+//-----------------------------------------------------------------------------
+// Function: SystemComponentItem::onComponentModelCopied()
+//-----------------------------------------------------------------------------
+void SystemComponentItem::onComponentModelCopied()
+{
+    for (ConnectionEndpoint* endpoint : leftPorts_ + rightPorts_)
+    {
+        if (auto port = dynamic_cast<SWPortItem*>(endpoint); port != nullptr)
+        {
+            port->setOwnerComponent(componentModel());
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 // Function: SystemComponentItem::itemChange()
 //-----------------------------------------------------------------------------
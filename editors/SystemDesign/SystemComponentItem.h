@@ -208,6 +208,9 @@ signals:
 protected:
     QVariant itemChange(GraphicsItemChange change, const QVariant &value);
 
+    //! Called when the item has copied the shared component model for editing.
+    void onComponentModelCopied() override;
+
 
     /*!
      *  Updates the port positions so that they have at minimum the given Y coordinate value.
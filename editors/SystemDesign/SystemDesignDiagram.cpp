@@ -51,6 +51,7 @@
 #include <editors/SystemDesign/UndoCommands/ReplaceSystemComponentCommand.h>
 
 #include <KactusAPI/include/LibraryInterface.h>
+#include <KactusAPI/include/Tracing.h>
 
 #include <IPXACTmodels/DesignConfiguration/DesignConfiguration.h>
 
@@ -525,8 +526,7 @@ void SystemDesignDiagram::dragEnterEvent(QGraphicsSceneDragDropEvent * event)
         if (vlnv.getType() == VLNV::COMPONENT)
         {
             // Determine the component type.
-            QSharedPointer<Document> libComp = getLibraryInterface()->getModel(vlnv);
-            QSharedPointer<Component> comp = libComp.staticCast<Component>();
+            QSharedPointer<Component const> comp = getLibraryInterface()->getModelReadOnly<Component>(vlnv);
 
             // component with given vlnv was not found
             if (!comp) {
@@ -1222,6 +1222,8 @@ void SystemDesignDiagram::onSelected(QGraphicsItem* newSelection)
 //-----------------------------------------------------------------------------
 void SystemDesignDiagram::loadDesign(QSharedPointer<Design> design)
 {
+    KACTUS2_TRACE_SCOPE_DETAIL("diagram", "SystemDesignDiagram::loadDesign", design->getVlnv().toString());
+
     if (design->getColumns().isEmpty())
     {
         if (onlySW_)
@@ -1258,13 +1260,27 @@ void SystemDesignDiagram::loadDesign(QSharedPointer<Design> design)
 
     unsigned int colIndex = 0;
 
+    // Each component is read from the library once and the instances share it. An item copies its component
+    // only when it edits it, e.g. to add a port.
+    QMap<VLNV, SharedDocument<Component> > instancedComponents;
+    auto findInstancedComponent = [this, &instancedComponents](VLNV const& componentVLNV)
+    {
+        if (instancedComponents.contains(componentVLNV) == false)
+        {
+            instancedComponents.insert(componentVLNV,
+                getLibraryInterface()->getSharedModel<Component>(componentVLNV));
+        }
+
+        return instancedComponents.value(componentVLNV);
+    };
+
     // Create (HW) component instances.
     if (!onlySW_)
     {
         for (auto const& instance : *design->getComponentInstances())
         {
-            QSharedPointer<Document> libComponent = getLibraryInterface()->getModel(*instance->getComponentRef());
-            QSharedPointer<Component> component = libComponent.staticCast<Component>();
+            SharedDocument<Component> instancedComponent = findInstancedComponent(*instance->getComponentRef());
+            QSharedPointer<Component> component = qSharedPointerConstCast<Component>(instancedComponent.get());
 
             // Only hardware components are applicable in this loop.
             if (instance->isDraft() || component->getImplementation() != KactusAttribute::HW)
@@ -1283,6 +1299,11 @@ void SystemDesignDiagram::loadDesign(QSharedPointer<Design> design)
             }
 
             HWMappingItem* item = new HWMappingItem(getLibraryInterface(), component, instance); //instance->getConfigurableElementValues());
+            if (instancedComponent)
+            {
+                item->setSharedComponent(instancedComponent);
+            }
+
             if (instance->isImported())
             {
 				item->setImported(instance->isImported());
@@ -1324,10 +1345,12 @@ void SystemDesignDiagram::loadDesign(QSharedPointer<Design> design)
     for (auto const& instance : *design->getComponentInstances())
     {
         QSharedPointer<Component> component;
+        SharedDocument<Component> instancedComponent;
 
         if (!instance->getComponentRef()->isEmpty())
         {
-             component = getLibraryInterface()->getModel(*instance->getComponentRef()).dynamicCast<Component>();
+             instancedComponent = findInstancedComponent(*instance->getComponentRef());
+             component = qSharedPointerConstCast<Component>(instancedComponent.get());
 
              if (!component && instance->getComponentRef()->isValid())
              {
@@ -1350,6 +1373,11 @@ void SystemDesignDiagram::loadDesign(QSharedPointer<Design> design)
         }
 
         SWComponentItem* item = new SWComponentItem(getLibraryInterface(), component, instance);
+        if (instancedComponent)
+        {
+            item->setSharedComponent(instancedComponent);
+        }
+
         connect(item, SIGNAL(openCSource(ComponentItem*)), this, SIGNAL(openCSource(ComponentItem*)));
         connect(item, SIGNAL(errorMessage(QString const&)), this, SIGNAL(errorMessage(QString const&)));
 
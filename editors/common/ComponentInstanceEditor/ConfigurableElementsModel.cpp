@@ -383,12 +383,12 @@ QString ConfigurableElementsModel::evaluateValue(int column, QString const& choi
 QString ConfigurableElementsModel::formattedValueFor(QString const& expression) const
 {
     bool isValidExpression = false;
-    QString value = defaultValueParser_->parseExpression(expression, &isValidExpression);
+    int base = 0;
+    QString value = defaultValueParser_->parseExpressionWithBase(expression, &isValidExpression, &base);
     if (isValidExpression)
     {
         ValueFormatter formatter;
-        return formatter.format(value,
-            defaultValueParser_->baseForExpression(expression));
+        return formatter.format(value, base);
     }
     else
     {
@@ -281,24 +281,19 @@ void DocumentationWriter::writeReferencedDesignConfigurationInstantiation(QTextS
 {
     if (auto const& configurationVLNV = instantiation->getDesignConfigurationReference(); configurationVLNV)
     {
-        QSharedPointer<Document> configurationDocument = libraryHandler->getModel(*configurationVLNV);
-        if (configurationDocument)
+        QSharedPointer<DesignConfiguration const> configuration =
+            libraryHandler->getModelReadOnly<DesignConfiguration>(*configurationVLNV);
+        if (configuration)
         {
-            QSharedPointer<DesignConfiguration> configuration =
-                configurationDocument.dynamicCast<DesignConfiguration>();
+            configurationFinder->setParameterList(configuration->getParameters());
 
-            if (configuration)
-            {
-                configurationFinder->setParameterList(configuration->getParameters());
+            QString header = QString("Parameters of the referenced design configuration %1:").
+                arg(configurationVLNV->toString());
+            QSharedPointer<ExpressionFormatter> configurationFormatter(new ExpressionFormatter(configurationFinder));
 
-                QString header = QString("Parameters of the referenced design configuration %1:").
-                    arg(configurationVLNV->toString());
-                QSharedPointer<ExpressionFormatter> configurationFormatter(new ExpressionFormatter(configurationFinder));
-
-                writeParameterTable(stream, header, configuration->getParameters(), configurationFormatter);
-                writeConfigurableElementValues(stream,
-                    instantiation->getDesignConfigurationReference(), instantiationFormatter);
-            }
+            writeParameterTable(stream, header, configuration->getParameters(), configurationFormatter);
+            writeConfigurableElementValues(stream,
+                instantiation->getDesignConfigurationReference(), instantiationFormatter);
         }
     }
 
@@ -54,8 +54,8 @@ bool HierarchyFilter::filterAcceptsRow(int sourceRow, QModelIndex const& sourceP
         return false;
     }
     
-    if (auto document = getLibraryInterface()->getModelReadOnly(item->getVLNV()); 
-        !document || checkRevision(document->getRevision()) == false || checkTags(document) == false)
+    DocumentMetadata const metadata = getLibraryInterface()->getMetadata(item->getVLNV());
+    if (metadata.isKnown() == false || checkRevision(metadata.revision) == false || checkTags(metadata) == false)
     {
         return false;
     }
@@ -88,8 +88,8 @@ bool HierarchyFilter::filterAcceptsRow(int sourceRow, QModelIndex const& sourceP
         }
     }
 
-    if (QSharedPointer<Component const> component = item->component(); 
-        component && (!checkFirmness(component) || !checkImplementation(component) || !checkHierarchy(component)))
+    if (metadata.type == VLNV::COMPONENT &&
+        (!checkFirmness(metadata) || !checkImplementation(metadata) || !checkHierarchy(metadata)))
     {
         return false;
     }
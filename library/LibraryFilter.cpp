@@ -133,16 +133,14 @@ Utils::TypeOptions LibraryFilter::type() const
 //-----------------------------------------------------------------------------
 // Function: LibraryFilter::checkFirmness()
 //-----------------------------------------------------------------------------
-bool LibraryFilter::checkFirmness(QSharedPointer<Component const> component) const
+bool LibraryFilter::checkFirmness(DocumentMetadata const& metadata) const
 {
-	Q_ASSERT(component);
-
-    if (component->getImplementation() == KactusAttribute::SW)
+    if (metadata.implementation == KactusAttribute::SW)
     {
         return true;
     }
 
-    KactusAttribute::Firmness componentFirmness = component->getFirmness();
+    KactusAttribute::Firmness componentFirmness = metadata.firmness;
     if (componentFirmness == KactusAttribute::TEMPLATE)
     {
         return firmness_.templates_;
@@ -164,15 +162,13 @@ bool LibraryFilter::checkFirmness(QSharedPointer<Component const> component) con
 //-----------------------------------------------------------------------------
 // Function: LibraryFilter::checkImplementation()
 //-----------------------------------------------------------------------------
-bool LibraryFilter::checkImplementation(QSharedPointer<Component const> component) const
+bool LibraryFilter::checkImplementation(DocumentMetadata const& metadata) const
 {
-    Q_ASSERT(component);
-
-    KactusAttribute::Implementation componentImplementation = component->getImplementation();
+    KactusAttribute::Implementation componentImplementation = metadata.implementation;
     if (componentImplementation == KactusAttribute::HW)
     {
         // if the HW component contains system views then it should be considered also as system
-        if (component->hasSystemViews())
+        if (metadata.hasSystemViews)
         {
             return implementation_.hw_ || implementation_.system_;
         }
@@ -197,16 +193,14 @@ bool LibraryFilter::checkImplementation(QSharedPointer<Component const> componen
 //-----------------------------------------------------------------------------
 // Function: LibraryFilter::checkHierarchy()
 //-----------------------------------------------------------------------------
-bool LibraryFilter::checkHierarchy(QSharedPointer<Component const> component) const
+bool LibraryFilter::checkHierarchy(DocumentMetadata const& metadata) const
 {
-	Q_ASSERT(component);
-
-    if (component->getImplementation() == KactusAttribute::SW)
+    if (metadata.implementation == KactusAttribute::SW)
     {
         return true;
     }
 
-    KactusAttribute::ProductHierarchy componentHierarchy = component->getHierarchy();
+    KactusAttribute::ProductHierarchy componentHierarchy = metadata.productHierarchy;
     if (componentHierarchy == KactusAttribute::FLAT)
     {
         return hierarchy_.flat_;
@@ -263,7 +257,7 @@ bool LibraryFilter::checkValidity(bool isValid) const
 //-----------------------------------------------------------------------------
 // Function: LibraryFilter::checkTags()
 //-----------------------------------------------------------------------------
-bool LibraryFilter::checkTags(QSharedPointer<Document const> document) const
+bool LibraryFilter::checkTags(DocumentMetadata const& metadata) const
 {
     int tagCount = tags_.size();
     if (tagCount == 0)
@@ -271,7 +265,7 @@ bool LibraryFilter::checkTags(QSharedPointer<Document const> document) const
         return true;
     }
 
-    QVector<TagData> documentTags = document->getTags();
+    QVector<TagData> const& documentTags = metadata.tags;
     if (documentTags.size() < tagCount)
     {
         return false;
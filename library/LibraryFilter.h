@@ -12,6 +12,7 @@
 #ifndef LIBRARYFILTER_H
 #define LIBRARYFILTER_H
 
+#include <KactusAPI/include/DocumentMetadata.h>
 #include <KactusAPI/include/utils.h>
 
 #include <IPXACTmodels/common/TagData.h>
@@ -115,13 +116,13 @@ protected:
     Utils::TypeOptions type() const;
 
     //! Check the firmness matching.
-	bool checkFirmness(QSharedPointer<Component const> component) const;
+	bool checkFirmness(DocumentMetadata const& metadata) const;
 
 	//! Check the implementation matching.
-	bool checkImplementation(QSharedPointer<Component const> component) const;
+	bool checkImplementation(DocumentMetadata const& metadata) const;
 
 	//! Check the hierarchy matching.
-	bool checkHierarchy(QSharedPointer<Component const> component) const;
+	bool checkHierarchy(DocumentMetadata const& metadata) const;
 
     //! Check the revision matching.
     bool checkRevision(Document::Revision revision) const;
@@ -138,11 +139,11 @@ protected:
     /*!
      *  Check the tag matching of the selected document.
      *
-     *    @param [in] document    The selected document.
+     *    @param [in] metadata    The summary of the selected document.
      *
      *    @return True, if the tags match the visible tags, false otherwise.
      */
-    bool checkTags(QSharedPointer<Document const> document) const;
+    bool checkTags(DocumentMetadata const& metadata) const;
 
     /*!
      *  Get the access to the library.
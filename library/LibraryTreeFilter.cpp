@@ -60,25 +60,24 @@ bool LibraryTreeFilter::checkType(VLNV const& vlnv) const
 {
     auto libraryAccess = getLibraryInterface();
 
+    // The summary is enough for filtering, so the models need not be read.
     VLNV::IPXactType documentType = libraryAccess->getDocumentType(vlnv);
-    QSharedPointer<Document const> document = libraryAccess->getModelReadOnly(vlnv);
+    DocumentMetadata const metadata = libraryAccess->getMetadata(vlnv);
     
-    if (checkRevision(document->getRevision()) == false)
+    if (checkRevision(metadata.revision) == false)
     {
         return false;
     }
 
-    if (checkTags(document) == false)
+    if (checkTags(metadata) == false)
     {
         return false;
     }
 
     if (documentType == VLNV::COMPONENT && type().components_)
     {
-        QSharedPointer<Component const> component = document.staticCast<Component const>();
-
-        if (checkImplementation(component) && checkHierarchy(component) &&
-            checkFirmness(component))
+        if (checkImplementation(metadata) && checkHierarchy(metadata) &&
+            checkFirmness(metadata))
         {
             return true;
         }
@@ -106,10 +105,8 @@ bool LibraryTreeFilter::checkType(VLNV const& vlnv) const
 
     else if (documentType == VLNV::DESIGN)
     {
-        QSharedPointer<Design> design = libraryAccess->getDesign(vlnv);
-
         if (type().advanced_ || (type().components_ && implementation().sw_ &&
-            design->getImplementation() == KactusAttribute::SW))
+            metadata.implementation == KactusAttribute::SW))
         {
             return true;
         }
@@ -156,8 +156,7 @@ void parseProgrammableElementsV2(LibraryInterface* lh, VLNV designVLNV,
     {
         if (!instance->isDraft())
         {
-            QSharedPointer<Document> libComp = lh->getModel(*instance->getComponentRef());
-            QSharedPointer<Component> childComp = libComp.staticCast<Component>();
+            QSharedPointer<Component const> childComp = lh->getModelReadOnly<Component>(*instance->getComponentRef());
 
             if (childComp)
             {
@@ -243,8 +242,7 @@ void addNewInstancesV2(LibraryInterface* lh, QList<QSharedPointer<ComponentInsta
             {
                 QSharedPointer<ConfigurableVLNVReference> ref = instance->getComponentRef();
 
-                QSharedPointer<Document> componentDoc = lh->getModel(*ref.data());
-                QSharedPointer<Component> swComponent = componentDoc.dynamicCast<Component>();
+                QSharedPointer<Component const> swComponent = lh->getModelReadOnly<Component>(*ref.data());
 
                 // Only software components are applicable in this loop.
                 if (!instance->isDraft() &&
@@ -372,8 +370,7 @@ void updateSystemDesignV2(LibraryInterface* lh, VLNV const& hwDesignVLNV, Design
     {
         QSharedPointer<ConfigurableVLNVReference> ref = hwInstance->getComponentRef();
 
-        QSharedPointer<Document> componentDoc = lh->getModel(*ref.data());
-        QSharedPointer<Component> hwComponent = componentDoc.dynamicCast<Component>();
+        QSharedPointer<Component const> hwComponent = lh->getModelReadOnly<Component>(*ref.data());
 
         // Only hardware components are applicable in this loop.
         if (!hwComponent || hwComponent->getImplementation() != KactusAttribute::HW)
@@ -431,8 +428,7 @@ void updateSystemDesignV2(LibraryInterface* lh, VLNV const& hwDesignVLNV, Design
     {
         QSharedPointer<ConfigurableVLNVReference> ref = swInstance->getComponentRef();
 
-        QSharedPointer<Document> componentDoc = lh->getModel(*ref.data());
-        QSharedPointer<Component> swComponent = componentDoc.dynamicCast<Component>();
+        QSharedPointer<Component const> swComponent = lh->getModelReadOnly<Component>(*ref.data());
 
         // Only software components are applicable in this loop.
         if (!swInstance->isDraft() &&
@@ -475,8 +471,7 @@ void updateSystemDesignV2(LibraryInterface* lh, VLNV const& hwDesignVLNV, Design
             {
                 QSharedPointer<ConfigurableVLNVReference> ref = swInstance->getComponentRef();
 
-                QSharedPointer<Document> componentDoc = lh->getModel(*ref.data());
-                QSharedPointer<Component> swComponent = componentDoc.dynamicCast<Component>();
+                QSharedPointer<Component const> swComponent = lh->getModelReadOnly<Component>(*ref.data());
 
                 // Only software components are applicable in this loop.
                 if (!swInstance->isDraft() &&
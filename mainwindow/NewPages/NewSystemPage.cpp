@@ -169,7 +169,8 @@ void NewSystemPage::onTreeItemChanged(QTreeWidgetItem* current, QTreeWidgetItem*
             VLNV vlnv = data.value<VLNV>();
 
             // Add all available hierarchical views to the view combo box.
-            QSharedPointer<Component> component = libInterface_->getModel(vlnv).staticCast<Component>();
+            QSharedPointer<Component const> component =
+                libInterface_->getModelReadOnly(vlnv).staticCast<Component const>();
 
             viewComboBox_->clear();
             viewComboBox_->addItems(component->getHierViews());
@@ -230,7 +231,8 @@ QTreeWidgetItem* NewSystemPage::createChildRecursively(LibraryItem const* librar
 
         if (vlnv.isValid() && vlnv.getType() == VLNV::COMPONENT)
         {
-            QSharedPointer<Component> component = libInterface_->getModel(vlnv).staticCast<Component>();
+            QSharedPointer<Component const> component =
+                libInterface_->getModelReadOnly(vlnv).staticCast<Component const>();
 
             if (component->getImplementation() == KactusAttribute::HW && !component->getHierViews().isEmpty())
             {
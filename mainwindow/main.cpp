@@ -29,6 +29,7 @@
 
 #include <KactusAPI/include/PluginManager.h>
 #include <KactusAPI/include/PluginUtilityAdapter.h>
+#include <KactusAPI/include/Tracing.h>
 
 #include <settings/SettingsUpdater.h>
 
@@ -127,6 +128,9 @@ int main(int argc, char *argv[])
     QScopedPointer<QCoreApplication> application(createApplication(argc, argv));
     QScopedPointer<MessageMediator> mediator(createMessageMediator(argc));
 
+    // Record a trace of the run, if an output file is given in the environment.
+    Tracing::enableFromEnvironment();
+
     QSettings::setDefaultFormat(QSettings::IniFormat);
 
     QSettings settings;
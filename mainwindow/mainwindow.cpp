@@ -127,6 +127,8 @@ rightToolbar_(new QToolBar(this)),
 dockHandler_(new DockWidgetHandler(library, messageChannel, leftToolbar_, rightToolbar_, this)),
 ribbon_(0), 
 statusBar_(new QStatusBar(this)),
+scanProgressBar_(new QProgressBar(this)),
+cancelScanButton_(new QPushButton(tr("Cancel"), this)),
 scriptEditor_(new PythonSourceEditor(this)),
 actNew_(0),
 actMainSave_(0),
@@ -251,9 +253,29 @@ MainWindow::~MainWindow()
 //-----------------------------------------------------------------------------
 void MainWindow::onLibrarySearch()
 {
-    QApplication::setOverrideCursor(Qt::WaitCursor);
-    libraryHandler_->searchForIPXactFiles();
-    QApplication::restoreOverrideCursor();
+    // Show the library items as they are found instead of after the whole library has been read.
+    libraryHandler_->startLibrarySearch();
+}
+
+//-----------------------------------------------------------------------------
+// Function: mainwindow::onLibraryScanProgress()
+//-----------------------------------------------------------------------------
+void MainWindow::onLibraryScanProgress(int scannedCount, int foundCount)
+{
+    scanProgressBar_->setMaximum(foundCount);
+    scanProgressBar_->setValue(scannedCount);
+
+    scanProgressBar_->show();
+    cancelScanButton_->show();
+}
+
+//-----------------------------------------------------------------------------
+// Function: mainwindow::onLibraryScanFinished()
+//-----------------------------------------------------------------------------
+void MainWindow::onLibraryScanFinished()
+{
+    scanProgressBar_->hide();
+    cancelScanButton_->hide();
 }
 
 //-----------------------------------------------------------------------------
@@ -856,6 +878,31 @@ void MainWindow::connectDockHandler()
 //-----------------------------------------------------------------------------
 void MainWindow::setupAndConnectLibraryHandler()
 {
+    // Validate the library in the background to keep the user interface responsive after library search.
+    libraryHandler_->setBackgroundValidation(true);
+
+    // Follow the changes made to the library outside Kactus2, unless turned off e.g. for very large libraries.
+    libraryHandler_->setFileSystemWatching(QSettings().value("Library/WatchFileSystem", true).toBool());
+
+    scanProgressBar_->setMaximumWidth(200);
+    scanProgressBar_->setFormat(tr("%v/%m files"));
+    scanProgressBar_->hide();
+    statusBar_->addPermanentWidget(scanProgressBar_);
+
+    cancelScanButton_->setToolTip(tr("Stop reading the library. The items found so far are kept."));
+    cancelScanButton_->hide();
+    statusBar_->addPermanentWidget(cancelScanButton_);
+
+    connect(cancelScanButton_, SIGNAL(clicked()), libraryHandler_, SLOT(cancelLibraryScan()), Qt::UniqueConnection);
+    connect(libraryHandler_, SIGNAL(libraryScanProgress(int, int)),
+        this, SLOT(onLibraryScanProgress(int, int)), Qt::UniqueConnection);
+    connect(libraryHandler_, SIGNAL(libraryScanFinished()), this, SLOT(onLibraryScanFinished()), Qt::UniqueConnection);
+
+    // Limit the memory taken by the parsed library documents.
+    QSettings settings;
+    qint64 cacheBudgetMB = settings.value("Library/DocumentCacheBudgetMB", 1024).toLongLong();
+    libraryHandler_->setCacheBudget(cacheBudgetMB * 1024 * 1024);
+
     connect(libraryHandler_, SIGNAL(openDesign(const VLNV&, const QString&)),
         this, SLOT(openHWDesign(const VLNV&, const QString&)));
     connect(libraryHandler_, SIGNAL(openMemoryDesign(const VLNV&, const QString&)),
@@ -3162,8 +3209,8 @@ void MainWindow::changeProtection(bool locked)
             QString message = tr("Are you sure you want to unlock the document?\n");
             QString detailMsg = "";
 
-            // If edited document was component and has been instantiated in other components, print them.
-            if (docVLNV.isValid() && libraryHandler_->getDocumentType(docVLNV) == VLNV::COMPONENT)
+            // If the edited document is referenced by other documents, print them.
+            if (docVLNV.isValid())
             {
                 QList<VLNV> list;
                 int refCount = libraryHandler_->getOwners(list, docVLNV);
@@ -3171,7 +3218,7 @@ void MainWindow::changeProtection(bool locked)
                 {
                     message += tr("Changes to the document can affect %1 other documents.").arg(refCount);
 
-                    detailMsg += tr("The component has been instantiated in the following %1 component(s):\n").arg(
+                    detailMsg += tr("The document is referenced by the following %1 document(s):\n").arg(
                         refCount);
                     for (VLNV const& owner : list)
                     {
@@ -3430,8 +3477,8 @@ bool MainWindow::hasInvalidReferences(QList<VLNV> hierRefs, VLNV const& referenc
         {
             VLNV designVLNV = libraryHandler_->getDesignVLNV(ref);
 
-            QSharedPointer<Document> libComp2 = libraryHandler_->getModel(ref);
-            QSharedPointer<DesignConfiguration> desConf = libComp2.staticCast<DesignConfiguration>();
+            QSharedPointer<DesignConfiguration const> desConf =
+                libraryHandler_->getModelReadOnly(ref).staticCast<DesignConfiguration const>();
             VLNV refToDesign = desConf->getDesignRef();
 
             // if the referenced design was not found in the library
@@ -3459,7 +3506,10 @@ void MainWindow::setLibraryLocations()
     LibrarySettingsDialog dialog(settings, this);
     connect(&dialog, SIGNAL(scanLibrary()), this, SLOT(onLibrarySearch()), Qt::UniqueConnection);
 
-    dialog.exec();
+    if (dialog.exec() == QDialog::Accepted)
+    {
+        libraryHandler_->setFileSystemWatching(settings.value("Library/WatchFileSystem", true).toBool());
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -28,6 +28,8 @@
 #include <QMainWindow>
 #include <QActionGroup>
 #include <QMenu>
+#include <QProgressBar>
+#include <QPushButton>
 #include <QShowEvent>
 #include <QHideEvent>
 
@@ -175,6 +177,17 @@ public slots:
 	 */
 	void onLibrarySearch();
 
+    /*!
+     *  Shows the progress of the library search in the status bar.
+     *
+     *    @param [in] scannedCount    The number of files read so far.
+     *    @param [in] foundCount      The number of files found in the library locations so far.
+     */
+    void onLibraryScanProgress(int scannedCount, int foundCount);
+
+    //! Hides the progress of the library search once the search has ended.
+    void onLibraryScanFinished();
+
 	/*!
      *  Called when user selects a component on the draw board.
 	 *
@@ -704,6 +717,12 @@ private:
 
     QStatusBar* statusBar_;
 
+    //! Shows the progress of the library search.
+    QProgressBar* scanProgressBar_;
+
+    //! Cancels the running library search.
+    QPushButton* cancelScanButton_;
+
 
     PythonSourceEditor* scriptEditor_;
 
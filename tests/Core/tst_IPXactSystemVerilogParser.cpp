@@ -70,6 +70,14 @@ private slots:
 
     void testLongReferenceChainPerformance();
     void testLongReferenceChainPerformance_data();
+
+    void testCompiledExpressionUsesCurrentParameterValue();
+
+    void testEditedParameterChangesDependentValues();
+    void testAddedParameterIsResolved();
+    void testRemovedParameterValuesArePruned();
+
+    void testParameterFinderFollowsModelChanges();
 };
 
 //-----------------------------------------------------------------------------
@@ -420,6 +428,12 @@ void tst_IPXactSystemVerilogParser::testGetBaseForExpression()
     IPXactSystemVerilogParser parser(QSharedPointer<ParameterFinder>(new ComponentParameterFinder(testComponent)));
 
     QCOMPARE(parser.baseForExpression(QString("2*first")), 16);
+
+    bool isValid = false;
+    int base = 0;
+    QCOMPARE(parser.parseExpressionWithBase(QString("2*first"), &isValid, &base), QString("2"));
+    QCOMPARE(isValid, true);
+    QCOMPARE(base, 16);
 }
 
 //-----------------------------------------------------------------------------
@@ -576,6 +590,188 @@ void tst_IPXactSystemVerilogParser::testLongReferenceChainPerformance_data()
     QTest::newRow("Chain of 20 parameters, cached") << 20 << true;
 }
 
+//-----------------------------------------------------------------------------
+// Function: tst_IPXactSystemVerilogParser::testCompiledExpressionUsesCurrentParameterValue()
+//-----------------------------------------------------------------------------
+void tst_IPXactSystemVerilogParser::testCompiledExpressionUsesCurrentParameterValue()
+{
+    QSharedPointer<Component> testComponent(new Component(VLNV(), Document::Revision::Std14));
+    QSharedPointer<Parameter> baseParameter(new Parameter());
+    baseParameter->setValueId("base");
+    baseParameter->setValue("'h100");
+    testComponent->getParameters()->append(baseParameter);
+
+    IPXactSystemVerilogParser parser(QSharedPointer<ParameterFinder>(new ComponentParameterFinder(testComponent)));
+
+    QCOMPARE(parser.parseExpression(QString("base + 4*2")), QString("264"));
+
+    baseParameter->setValue("'h200");
+    QCOMPARE(parser.parseExpression(QString("base + 4*2")), QString("520"));
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_IPXactSystemVerilogParser::testEditedParameterChangesDependentValues()
+//-----------------------------------------------------------------------------
+void tst_IPXactSystemVerilogParser::testEditedParameterChangesDependentValues()
+{
+    QSharedPointer<Component> testComponent(new Component(VLNV(), Document::Revision::Std14));
+
+    QSharedPointer<Parameter> widthParameter(new Parameter());
+    widthParameter->setValueId("width");
+    widthParameter->setValue("8");
+    testComponent->getParameters()->append(widthParameter);
+
+    QSharedPointer<Parameter> bytesParameter(new Parameter());
+    bytesParameter->setValueId("bytes");
+    bytesParameter->setValue("width/8");
+    testComponent->getParameters()->append(bytesParameter);
+
+    QSharedPointer<Parameter> sizeParameter(new Parameter());
+    sizeParameter->setValueId("size");
+    sizeParameter->setValue("bytes*depth");
+    testComponent->getParameters()->append(sizeParameter);
+
+    QSharedPointer<Parameter> depthParameter(new Parameter());
+    depthParameter->setValueId("depth");
+    depthParameter->setValue("16");
+    testComponent->getParameters()->append(depthParameter);
+
+    IPXactSystemVerilogParser parser(QSharedPointer<ParameterFinder>(new ComponentParameterFinder(testComponent)));
+
+    QCOMPARE(parser.parseExpression(QString("size")), QString("16"));
+    QCOMPARE(parser.parseExpression(QString("depth + bytes")), QString("17"));
+
+    widthParameter->setValue("32");
+    QCOMPARE(parser.parseExpression(QString("size")), QString("64"));
+    QCOMPARE(parser.parseExpression(QString("bytes")), QString("4"));
+
+    depthParameter->setValue("2");
+    QCOMPARE(parser.parseExpression(QString("size")), QString("8"));
+
+    bytesParameter->setValue("width");
+    QCOMPARE(parser.parseExpression(QString("size")), QString("64"));
+    QCOMPARE(parser.parseExpression(QString("depth + bytes")), QString("34"));
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_IPXactSystemVerilogParser::testAddedParameterIsResolved()
+//-----------------------------------------------------------------------------
+void tst_IPXactSystemVerilogParser::testAddedParameterIsResolved()
+{
+    QSharedPointer<Component> testComponent(new Component(VLNV(), Document::Revision::Std14));
+
+    QSharedPointer<Parameter> firstParameter(new Parameter());
+    firstParameter->setValueId("first");
+    firstParameter->setValue("second + 1");
+    testComponent->getParameters()->append(firstParameter);
+
+    IPXactSystemVerilogParser parser(QSharedPointer<ParameterFinder>(new ComponentParameterFinder(testComponent)));
+
+    bool valid = true;
+    parser.parseExpression(QString("first"), &valid);
+    QCOMPARE(valid, false);
+
+    QSharedPointer<Parameter> secondParameter(new Parameter());
+    secondParameter->setValueId("second");
+    secondParameter->setValue("2");
+    testComponent->getParameters()->append(secondParameter);
+
+    QCOMPARE(parser.parseExpression(QString("first"), &valid), QString("3"));
+    QCOMPARE(valid, true);
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_IPXactSystemVerilogParser::testRemovedParameterValuesArePruned()
+//-----------------------------------------------------------------------------
+void tst_IPXactSystemVerilogParser::testRemovedParameterValuesArePruned()
+{
+    QSharedPointer<Component> testComponent(new Component(VLNV(), Document::Revision::Std14));
+
+    const int parameterCount = 2000;
+    for (int i = 0; i < parameterCount; ++i)
+    {
+        QSharedPointer<Parameter> parameter(new Parameter());
+        parameter->setValueId("id" + QString::number(i));
+        parameter->setValue(QString::number(i));
+        testComponent->getParameters()->append(parameter);
+    }
+
+    QSharedPointer<Parameter> keptParameter(new Parameter());
+    keptParameter->setValueId("kept");
+    keptParameter->setValue("id0 + 1");
+    testComponent->getParameters()->append(keptParameter);
+
+    IPXactSystemVerilogParser parser(QSharedPointer<ParameterFinder>(new ComponentParameterFinder(testComponent)));
+
+    for (int i = 0; i < parameterCount; ++i)
+    {
+        parser.parseExpression("id" + QString::number(i));
+    }
+    QCOMPARE(parser.parseExpression(QString("kept")), QString("1"));
+    QCOMPARE(parser.cachedValueCount(), parameterCount + 1);
+
+    testComponent->getParameters()->erase(testComponent->getParameters()->begin() + 1,
+        testComponent->getParameters()->begin() + parameterCount);
+
+    QCOMPARE(parser.parseExpression(QString("kept")), QString("1"));
+    QCOMPARE(parser.cachedValueCount(), 2);
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_IPXactSystemVerilogParser::testParameterFinderFollowsModelChanges()
+//-----------------------------------------------------------------------------
+void tst_IPXactSystemVerilogParser::testParameterFinderFollowsModelChanges()
+{
+    QSharedPointer<Component> testComponent(new Component(VLNV(), Document::Revision::Std14));
+
+    QSharedPointer<MemoryMap> memoryMap(new MemoryMap());
+    testComponent->getMemoryMaps()->append(memoryMap);
+
+    QSharedPointer<AddressBlock> addressBlock(new AddressBlock());
+    memoryMap->getMemoryBlocks()->append(addressBlock);
+
+    QSharedPointer<Register> testRegister(new Register());
+    addressBlock->getRegisterData()->append(testRegister);
+
+    QSharedPointer<Parameter> firstParameter(new Parameter());
+    firstParameter->setValueId("first");
+    firstParameter->setValue("1");
+    testRegister->getParameters()->append(firstParameter);
+
+    QSharedPointer<Parameter> secondParameter(new Parameter());
+    secondParameter->setValueId("second");
+    secondParameter->setValue("2");
+    testComponent->getParameters()->append(secondParameter);
+
+    ComponentParameterFinder finder(testComponent);
+
+    QCOMPARE(finder.valueForId(QString("first")), QString("1"));
+    QCOMPARE(finder.valueForId(QString("second")), QString("2"));
+    QCOMPARE(finder.hasId(QString("third")), false);
+
+    firstParameter->setValueId("renamed");
+    QCOMPARE(finder.hasId(QString("first")), false);
+    QCOMPARE(finder.valueForId(QString("renamed")), QString("1"));
+
+    testComponent->getParameters()->removeOne(secondParameter);
+    QCOMPARE(finder.hasId(QString("second")), false);
+
+    testRegister->getParameters()->prepend(secondParameter);
+    QCOMPARE(finder.getParameterWithID(QString("second")), secondParameter);
+    QCOMPARE(finder.getParameterWithID(QString("renamed")), firstParameter);
+
+    addressBlock->getRegisterData()->removeOne(testRegister);
+    QCOMPARE(finder.hasId(QString("second")), false);
+    QCOMPARE(finder.hasId(QString("renamed")), false);
+
+    addressBlock->getRegisterData()->append(testRegister);
+    QCOMPARE(finder.getParameterWithID(QString("second")), secondParameter);
+
+    testComponent->getMemoryMaps()->clear();
+    QCOMPARE(finder.hasId(QString("second")), false);
+    QCOMPARE(finder.hasId(QString("renamed")), false);
+}
+
 QTEST_MAIN(tst_IPXactSystemVerilogParser)
 
 #include "tst_IPXactSystemVerilogParser.moc"
@@ -71,8 +71,14 @@ private slots:
     void testTernaryOperations();
     void testTernaryOperations_data();
 
+    void testLargeIntegers();
+    void testLargeIntegers_data();
+
     void testParserPerformance();
     void testParserPerformance_data();
+
+    void testCompiledExpressionCache();
+    void testCompiledExpressionCache_data();
 };
 
 //-----------------------------------------------------------------------------
@@ -704,6 +710,15 @@ void tst_SystemVerilogExpressionParser::testGetBaseForExpression()
     SystemVerilogExpressionParser parser;
     
     QCOMPARE(parser.baseForExpression(expression), expectedBase);
+
+    bool expectedValid = false;
+    QString expectedValue = parser.parseExpression(expression, &expectedValid);
+
+    bool isValid = !expectedValid;
+    int base = -1;
+    QCOMPARE(parser.parseExpressionWithBase(expression, &isValid, &base), expectedValue);
+    QCOMPARE(isValid, expectedValid);
+    QCOMPARE(base, expectedBase);
 }
 
 //-----------------------------------------------------------------------------
@@ -955,6 +970,54 @@ void tst_SystemVerilogExpressionParser::testTernaryOperations_data()
 
 }
 
+//-----------------------------------------------------------------------------
+// Function: tst_SystemVerilogExpressionParser::testLargeIntegers()
+//-----------------------------------------------------------------------------
+void tst_SystemVerilogExpressionParser::testLargeIntegers()
+{
+    QFETCH(QString, expression);
+    QFETCH(QString, expectedResult);
+
+    SystemVerilogExpressionParser parser;
+
+    bool isValid = false;
+    QCOMPARE(parser.parseExpression(expression, &isValid), expectedResult);
+    QCOMPARE(isValid, true);
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_SystemVerilogExpressionParser::testLargeIntegers_data()
+//-----------------------------------------------------------------------------
+void tst_SystemVerilogExpressionParser::testLargeIntegers_data()
+{
+    QTest::addColumn<QString>("expression");
+    QTest::addColumn<QString>("expectedResult");
+
+    QTest::newRow("Sum above 2^53 is exact") << "9007199254740993 + 1" << "9007199254740994";
+    QTest::newRow("Power of two plus one") << "2**60 + 1" << "1152921504606846977";
+    QTest::newRow("Product of 32-bit values") << "'h7FFFFFFF * 'h100000000" << "9223372032559808512";
+    QTest::newRow("Largest 64-bit value") << "(2**62 - 1) * 2 + 1" << "9223372036854775807";
+    QTest::newRow("Shift to bit 62") << "1 << 62" << "4611686018427387904";
+    QTest::newRow("Division of a large value") << "2**62 / 3" << "1537228672809129301";
+    QTest::newRow("Comparison of values differing in the last bit") << "9007199254740993 == 9007199254740992"
+        << "0";
+    QTest::newRow("Large negative value") << "-(2**62) - 2**62" << "-9223372036854775808";
+
+    QTest::newRow("Largest unsigned 64-bit value") << "2**64 - 1" << "18446744073709551615";
+    QTest::newRow("Power of two above 64-bit signed range") << "2**63" << "9223372036854775808";
+    QTest::newRow("Product above 64-bit signed range") << "'hFFFFFFFF * 'h100000001" << "18446744073709551615";
+    QTest::newRow("Division of an unsigned 64-bit value") << "(2**64 - 1) / 3" << "6148914691236517205";
+    QTest::newRow("Remainder of an unsigned 64-bit value") << "(2**64 - 1) % 10" << "5";
+    QTest::newRow("Shift beyond 64 bits") << "1 << 64" << "18446744073709551616";
+    QTest::newRow("Shift of a wide value") << "2**64 >> 4" << "1152921504606846976";
+    QTest::newRow("Wide value back in 64-bit range") << "2**64 - 2**63 - 1" << "9223372036854775807";
+    QTest::newRow("Negative wide value") << "-(2**64)" << "-18446744073709551616";
+    QTest::newRow("Comparison of wide values") << "2**64 - 1 < 2**64" << "1";
+    QTest::newRow("Bitwise and of wide values") << "(2**64 - 1) & 'hFF" << "255";
+    QTest::newRow("Clog2 of a wide value") << "$clog2(2**64 + 1)" << "65";
+    QTest::newRow("Sum above 100 bits is exact") << "2**100 + 1" << "1267650600228229401496703205377";
+}
+
 //-----------------------------------------------------------------------------
 // Function: tst_SystemVerilogExpressionParser::testParserPerformance()
 //-----------------------------------------------------------------------------
@@ -989,7 +1052,55 @@ void tst_SystemVerilogExpressionParser::testParserPerformance_data()
     QTest::newRow("clog2 operations") << "$clog2(256) - $clog2(8)" << 5;
     QTest::newRow("Nested clog2 operations") << "$clog2($clog2(256))" << 3;
     QTest::newRow("Sum of multiple values of different bases") << "'hA + 'b1010 + 'o12 + 10" << 40;
+    QTest::newRow("Register offset") << "'h1000 + 4*12" << 4144;
+    QTest::newRow("Address shift and mask") << "('h12345678 >> 8) & 'hFFFF" << 13398;
+    QTest::newRow("Ternary selection") << "16 > 8 ? 'h40 : 'h20" << 64;
+
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_SystemVerilogExpressionParser::testCompiledExpressionCache()
+//-----------------------------------------------------------------------------
+void tst_SystemVerilogExpressionParser::testCompiledExpressionCache()
+{
+    QFETCH(QString, expression);
+    QFETCH(QString, expectedResult);
+    QFETCH(bool, expectedValid);
+
+    SystemVerilogExpressionParser::clearCache();
+
+    SystemVerilogExpressionParser parser;
+
+    bool firstValid = !expectedValid;
+    QCOMPARE(parser.parseExpression(expression, &firstValid), expectedResult);
+    QCOMPARE(firstValid, expectedValid);
+
+    SystemVerilogExpressionParser otherParser;
+
+    bool secondValid = !expectedValid;
+    QCOMPARE(otherParser.parseExpression(expression, &secondValid), expectedResult);
+    QCOMPARE(secondValid, expectedValid);
+
+    auto statistics = SystemVerilogExpressionParser::cacheStatistics();
+    QCOMPARE(statistics.misses, qint64(1));
+    QCOMPARE(statistics.hits, qint64(1));
+    QCOMPARE(statistics.size, 1);
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_SystemVerilogExpressionParser::testCompiledExpressionCache_data()
+//-----------------------------------------------------------------------------
+void tst_SystemVerilogExpressionParser::testCompiledExpressionCache_data()
+{
+    QTest::addColumn<QString>("expression");
+    QTest::addColumn<QString>("expectedResult");
+    QTest::addColumn<bool>("expectedValid");
 
+    QTest::newRow("Register offset") << "'h100 + 4*3" << "268" << true;
+    QTest::newRow("Unary minus") << "-(2 + 3)" << "-5" << true;
+    QTest::newRow("Ternary operation") << "1 < 2 ? 8 : 16" << "8" << true;
+    QTest::newRow("Array") << "{1, 2+1, 'h4}" << "{1,3,4}" << true;
+    QTest::newRow("Unbalanced parentheses") << "(1 + 2" << "x" << false;
 }
 
 QTEST_APPLESS_MAIN(tst_SystemVerilogExpressionParser)
@@ -40,8 +40,13 @@
 #include <IPXACTmodels/kactusExtensions/ApiInterface.h>
 #include <IPXACTmodels/kactusExtensions/FileDependency.h>
 
+#include <IPXACTmodels/Component/ComponentWriter.h>
+#include <IPXACTmodels/Component/AddressBlock.h>
+
 #include <QtTest>
 #include <QDomNode>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
 
 class tst_ComponentReader : public QObject
 {
@@ -93,6 +98,9 @@ private slots:
     void readAuthorAndLicense();
 
     void readTags();
+
+    void streamedComponentMatchesDocument();
+    void streamedComponentMatchesDocument_data();
 };
 
 //-----------------------------------------------------------------------------
@@ -1562,6 +1570,177 @@ void tst_ComponentReader::readTags()
     QCOMPARE(testComponent->getTags().first().color_, QLatin1String("#79D173"));
 }
 
+//-----------------------------------------------------------------------------
+// Function: tst_ComponentReader::streamedComponentMatchesDocument()
+//-----------------------------------------------------------------------------
+void tst_ComponentReader::streamedComponentMatchesDocument()
+{
+    QFETCH(QString, documentContent);
+    QFETCH(int, expectedRegisterCount);
+
+    QDomDocument document;
+    document.setContent(documentContent);
+
+    ComponentReader componentReader;
+    QSharedPointer<Component> documentComponent = componentReader.createComponentFrom(document);
+
+    QXmlStreamReader streamReader(documentContent);
+    QSharedPointer<Component> streamedComponent = componentReader.createComponentFrom(streamReader);
+
+    QVERIFY(streamedComponent.isNull() == false);
+    QCOMPARE(streamedComponent->getVlnv(), documentComponent->getVlnv());
+    QCOMPARE(streamedComponent->getRevision(), documentComponent->getRevision());
+    QCOMPARE(streamedComponent->getMemoryMaps()->size(), 1);
+    QCOMPARE(streamedComponent->getMemoryMaps()->first()->getMemoryBlocks()->size(), 2);
+
+    QSharedPointer<AddressBlock> streamedBlock =
+        streamedComponent->getMemoryMaps()->first()->getMemoryBlocks()->first().dynamicCast<AddressBlock>();
+    QVERIFY(streamedBlock.isNull() == false);
+    QCOMPARE(streamedBlock->getRegisterData()->size(), expectedRegisterCount);
+
+    ComponentWriter componentWriter;
+
+    QString documentOutput;
+    QXmlStreamWriter documentWriter(&documentOutput);
+    componentWriter.writeComponent(documentWriter, documentComponent);
+
+    QString streamedOutput;
+    QXmlStreamWriter streamedWriter(&streamedOutput);
+    componentWriter.writeComponent(streamedWriter, streamedComponent);
+
+    QCOMPARE(streamedOutput, documentOutput);
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_ComponentReader::streamedComponentMatchesDocument_data()
+//-----------------------------------------------------------------------------
+void tst_ComponentReader::streamedComponentMatchesDocument_data()
+{
+    QTest::addColumn<QString>("documentContent");
+    QTest::addColumn<int>("expectedRegisterCount");
+
+    QString componentContent(
+        "<?xml version=\"1.0\"?>\n"
+        "<!-- Header comment -->\n"
+        "<?kactus2 renderHint=\"compact\"?>\n"
+        "<ipxact:component "
+        "xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\" "
+        "xmlns:ipxact=\"http://www.accellera.org/XMLSchema/IPXACT/%1\" "
+        "xmlns:kactus2=\"http://kactus2.cs.tut.fi\" "
+        "xsi:schemaLocation=\"http://www.accellera.org/XMLSchema/IPXACT/%1/ "
+        "http://www.accellera.org/XMLSchema/IPXACT/%1/index.xsd\">\n"
+        "    <ipxact:vendor>tuni.fi</ipxact:vendor>\n"
+        "    <ipxact:library>TestLibrary</ipxact:library>\n"
+        "    <ipxact:name>TestComponent</ipxact:name>\n"
+        "    <ipxact:version>1.0</ipxact:version>\n"
+        "    <ipxact:busInterfaces>\n"
+        "        <ipxact:busInterface>\n"
+        "            <ipxact:name>slave</ipxact:name>\n"
+        "            <ipxact:busType vendor=\"tuni.fi\" library=\"bus\" name=\"testBus\" version=\"1.0\"/>\n"
+        "            <ipxact:slave>\n"
+        "                <ipxact:memoryMapRef memoryMapRef=\"map\"/>\n"
+        "            </ipxact:slave>\n"
+        "        </ipxact:busInterface>\n"
+        "        <!-- Interface comment -->\n"
+        "        <ipxact:busInterface>\n"
+        "            <ipxact:name>master</ipxact:name>\n"
+        "            <ipxact:busType vendor=\"tuni.fi\" library=\"bus\" name=\"testBus\" version=\"1.0\"/>\n"
+        "            <ipxact:master/>\n"
+        "        </ipxact:busInterface>\n"
+        "    </ipxact:busInterfaces>\n"
+        "    <ipxact:memoryMaps>\n"
+        "        <ipxact:memoryMap>\n"
+        "            <ipxact:name>map</ipxact:name>\n"
+        "            <ipxact:addressBlock>\n"
+        "                <ipxact:name>block</ipxact:name>\n"
+        "                <ipxact:baseAddress>'h0</ipxact:baseAddress>\n"
+        "                <ipxact:range>16</ipxact:range>\n"
+        "                <ipxact:width>32</ipxact:width>\n"
+        "                <ipxact:register>\n"
+        "                    <ipxact:name>control</ipxact:name>\n"
+        "                    <ipxact:addressOffset>'h0</ipxact:addressOffset>\n"
+        "                    <ipxact:size>32</ipxact:size>\n"
+        "                    <ipxact:field>\n"
+        "                        <ipxact:name>enable</ipxact:name>\n"
+        "                        <ipxact:bitOffset>0</ipxact:bitOffset>\n"
+        "                        <ipxact:bitWidth>1</ipxact:bitWidth>\n"
+        "                    </ipxact:field>\n"
+        "                </ipxact:register>\n"
+        "                <ipxact:registerFile>\n"
+        "                    <ipxact:name>file</ipxact:name>\n"
+        "                    <ipxact:addressOffset>'h4</ipxact:addressOffset>\n"
+        "                    <ipxact:range>8</ipxact:range>\n"
+        "                    <ipxact:register>\n"
+        "                        <ipxact:name>inner</ipxact:name>\n"
+        "                        <ipxact:addressOffset>'h0</ipxact:addressOffset>\n"
+        "                        <ipxact:size>32</ipxact:size>\n"
+        "                    </ipxact:register>\n"
+        "                </ipxact:registerFile>\n"
+        "                <ipxact:register>\n"
+        "                    <ipxact:name>status</ipxact:name>\n"
+        "                    <ipxact:description><![CDATA[Status <flags>]]></ipxact:description>\n"
+        "                    <ipxact:addressOffset>'hC</ipxact:addressOffset>\n"
+        "                    <ipxact:size>32</ipxact:size>\n"
+        "                </ipxact:register>\n"
+        "            </ipxact:addressBlock>\n"
+        "            <ipxact:subspaceMap %2=\"master\">\n"
+        "                <ipxact:name>subspace</ipxact:name>\n"
+        "                <ipxact:baseAddress>'h100</ipxact:baseAddress>\n"
+        "            </ipxact:subspaceMap>\n"
+        "            <ipxact:addressUnitBits>8</ipxact:addressUnitBits>\n"
+        "        </ipxact:memoryMap>\n"
+        "    </ipxact:memoryMaps>\n"
+        "    <ipxact:model>\n"
+        "        <ipxact:views>\n"
+        "            <ipxact:view>\n"
+        "                <ipxact:name>rtl</ipxact:name>\n"
+        "            </ipxact:view>\n"
+        "        </ipxact:views>\n"
+        "        <ipxact:ports>\n"
+        "            <ipxact:port>\n"
+        "                <ipxact:name>clk</ipxact:name>\n"
+        "                <ipxact:wire>\n"
+        "                    <ipxact:direction>in</ipxact:direction>\n"
+        "                </ipxact:wire>\n"
+        "            </ipxact:port>\n"
+        "            <ipxact:port>\n"
+        "                <ipxact:name>data</ipxact:name>\n"
+        "                <ipxact:wire>\n"
+        "                    <ipxact:direction>out</ipxact:direction>\n"
+        "                    <ipxact:vectors>\n"
+        "                        <ipxact:vector>\n"
+        "                            <ipxact:left>31</ipxact:left>\n"
+        "                            <ipxact:right>0</ipxact:right>\n"
+        "                        </ipxact:vector>\n"
+        "                    </ipxact:vectors>\n"
+        "                </ipxact:wire>\n"
+        "            </ipxact:port>\n"
+        "        </ipxact:ports>\n"
+        "    </ipxact:model>\n"
+        "    <ipxact:fileSets>\n"
+        "        <ipxact:fileSet>\n"
+        "            <ipxact:name>sources</ipxact:name>\n"
+        "            <ipxact:file>\n"
+        "                <ipxact:name>top.v</ipxact:name>\n"
+        "                <ipxact:fileType>verilogSource</ipxact:fileType>\n"
+        "            </ipxact:file>\n"
+        "        </ipxact:fileSet>\n"
+        "    </ipxact:fileSets>\n"
+        "    <ipxact:vendorExtensions>\n"
+        "        <kactus2:version>3,10,0,0</kactus2:version>\n"
+        "        <kactus2:kts_attributes>\n"
+        "            <kactus2:kts_productHier>Flat</kactus2:kts_productHier>\n"
+        "            <kactus2:kts_implementation>HW</kactus2:kts_implementation>\n"
+        "            <kactus2:kts_firmness>Mutable</kactus2:kts_firmness>\n"
+        "        </kactus2:kts_attributes>\n"
+        "    </ipxact:vendorExtensions>\n"
+        "</ipxact:component>\n");
+
+    QTest::newRow("IP-XACT 2014 component") <<
+        componentContent.arg(QStringLiteral("1685-2014"), QStringLiteral("masterRef")) << 3;
+    QTest::newRow("IP-XACT 2022 component") <<
+        componentContent.arg(QStringLiteral("1685-2022"), QStringLiteral("initiatorRef")) << 3;
+}
 
 QTEST_APPLESS_MAIN(tst_ComponentReader)
 
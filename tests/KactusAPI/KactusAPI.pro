@@ -13,4 +13,12 @@ TEMPLATE = subdirs
 
 CONFIG += testcase
 SUBDIRS += \
-            tst_ModeConditionParser.pro 
+            tst_ModeConditionParser.pro \
+            tst_LibraryArchive.pro \
+            tst_Tracing.pro
+
+# The library benchmarks take minutes, so they are built only on request with qmake CONFIG+=benchmarks.
+# They are not test cases, so they are run directly instead of with make check.
+benchmarks {
+    SUBDIRS += tst_LibraryPerformance.pro
+} 
@@ -0,0 +1,256 @@
+//-----------------------------------------------------------------------------
+// File: SyntheticLibraryGenerator.cpp
+//-----------------------------------------------------------------------------
+// Project: Kactus2
+// Author: Kactus2 team
+// Date: 16.10.2026
+//
+// Description:
+// Generates deterministic IP-XACT libraries of a given size for performance tests.
+//-----------------------------------------------------------------------------
+
+#include "SyntheticLibraryGenerator.h"
+
+#include <KactusAPI/include/DocumentFileAccess.h>
+
+#include <IPXACTmodels/common/ConfigurableVLNVReference.h>
+#include <IPXACTmodels/common/DirectionTypes.h>
+
+#include <IPXACTmodels/Component/AddressBlock.h>
+#include <IPXACTmodels/Component/Component.h>
+#include <IPXACTmodels/Component/DesignInstantiation.h>
+#include <IPXACTmodels/Component/Field.h>
+#include <IPXACTmodels/Component/MemoryMap.h>
+#include <IPXACTmodels/Component/Port.h>
+#include <IPXACTmodels/Component/Register.h>
+#include <IPXACTmodels/Component/View.h>
+
+#include <IPXACTmodels/Design/ComponentInstance.h>
+#include <IPXACTmodels/Design/Design.h>
+
+#include <QDir>
+
+namespace
+{
+    const QString VENDOR = QStringLiteral("tut.fi");
+    const QString LIBRARY = QStringLiteral("synthetic");
+    const QString VERSION = QStringLiteral("1.0");
+}
+
+//-----------------------------------------------------------------------------
+// Function: SyntheticLibraryGenerator::SyntheticLibraryGenerator()
+//-----------------------------------------------------------------------------
+SyntheticLibraryGenerator::SyntheticLibraryGenerator(Parameters const& parameters):
+parameters_(parameters),
+random_(parameters.seed)
+{
+
+}
+
+//-----------------------------------------------------------------------------
+// Function: SyntheticLibraryGenerator::generate()
+//-----------------------------------------------------------------------------
+bool SyntheticLibraryGenerator::generate(QString const& directory)
+{
+    random_.seed(parameters_.seed);
+    levels_.fill(QVector<VLNV>(), parameters_.hierarchyDepth + 1);
+    componentPaths_.clear();
+    documentCount_ = 0;
+
+    for (int i = 0; i < parameters_.componentCount; ++i)
+    {
+        int level = levelOf(i);
+
+        // The lower levels always fill up first, but guard against too small libraries.
+        while (level > 0 && levels_.at(level - 1).isEmpty())
+        {
+            --level;
+        }
+
+        VLNV vlnv(VLNV::COMPONENT, VENDOR, LIBRARY,
+            QStringLiteral("l%1_component%2").arg(level).arg(i, 6, 10, QLatin1Char('0')), VERSION);
+
+        QSharedPointer<Component> component = createComponent(vlnv);
+        if (level > 0)
+        {
+            QSharedPointer<Design> design = createDesign(component, levels_.at(level - 1));
+            if (writeDocument(directory, design).isEmpty())
+            {
+                return false;
+            }
+        }
+
+        QString componentPath = writeDocument(directory, component);
+        if (componentPath.isEmpty())
+        {
+            return false;
+        }
+
+        componentPaths_.append(componentPath);
+        levels_[level].append(vlnv);
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Function: SyntheticLibraryGenerator::documentCount()
+//-----------------------------------------------------------------------------
+int SyntheticLibraryGenerator::documentCount() const
+{
+    return documentCount_;
+}
+
+//-----------------------------------------------------------------------------
+// Function: SyntheticLibraryGenerator::componentPaths()
+//-----------------------------------------------------------------------------
+QVector<QString> SyntheticLibraryGenerator::componentPaths() const
+{
+    return componentPaths_;
+}
+
+//-----------------------------------------------------------------------------
+// Function: SyntheticLibraryGenerator::topComponent()
+//-----------------------------------------------------------------------------
+VLNV SyntheticLibraryGenerator::topComponent() const
+{
+    for (int level = levels_.size() - 1; level >= 0; --level)
+    {
+        if (levels_.at(level).isEmpty() == false)
+        {
+            return levels_.at(level).last();
+        }
+    }
+
+    return VLNV();
+}
+
+//-----------------------------------------------------------------------------
+// Function: SyntheticLibraryGenerator::createComponent()
+//-----------------------------------------------------------------------------
+QSharedPointer<Component> SyntheticLibraryGenerator::createComponent(VLNV const& vlnv)
+{
+    QSharedPointer<Component> component(new Component(vlnv, Document::Revision::Std22));
+
+    for (int i = 0; i < parameters_.portsPerComponent; ++i)
+    {
+        QSharedPointer<Port> port(new Port(QStringLiteral("port%1").arg(i)));
+        port->setDirection(i % 2 == 0 ? DirectionTypes::IN : DirectionTypes::OUT);
+        port->setPortSize(1 << random_.bounded(6));
+
+        component->getPorts()->append(port);
+    }
+
+    if (parameters_.registersPerMap > 0)
+    {
+        QSharedPointer<AddressBlock> block(new AddressBlock(QStringLiteral("registers"), QStringLiteral("0")));
+        block->setRange(QString::number(parameters_.registersPerMap * 4));
+        block->setWidth(QStringLiteral("32"));
+
+        for (int i = 0; i < parameters_.registersPerMap; ++i)
+        {
+            QSharedPointer<Register> reg(new Register(QStringLiteral("reg%1").arg(i),
+                QStringLiteral("'h%1").arg(i * 4, 0, 16), QStringLiteral("32")));
+
+            // Split the register into fields of random widths.
+            int offset = 0;
+            while (offset < 32)
+            {
+                int width = qMin(32 - offset, 1 + random_.bounded(16));
+
+                QSharedPointer<Field> field(new Field(QStringLiteral("field%1").arg(offset)));
+                field->setBitOffset(QString::number(offset));
+                field->setBitWidth(QString::number(width));
+                reg->getFields()->append(field);
+
+                offset += width;
+            }
+
+            block->getRegisterData()->append(reg);
+        }
+
+        QSharedPointer<MemoryMap> memoryMap(new MemoryMap(QStringLiteral("memoryMap")));
+        memoryMap->setAddressUnitBits(QStringLiteral("8"));
+        memoryMap->getMemoryBlocks()->append(block);
+
+        component->getMemoryMaps()->append(memoryMap);
+    }
+
+    return component;
+}
+
+//-----------------------------------------------------------------------------
+// Function: SyntheticLibraryGenerator::createDesign()
+//-----------------------------------------------------------------------------
+QSharedPointer<Design> SyntheticLibraryGenerator::createDesign(QSharedPointer<Component> component,
+    QVector<VLNV> const& instantiated)
+{
+    VLNV componentVLNV = component->getVlnv();
+    VLNV designVLNV(VLNV::DESIGN, componentVLNV.getVendor(), componentVLNV.getLibrary(),
+        componentVLNV.getName() + QStringLiteral(".design"), componentVLNV.getVersion());
+
+    QSharedPointer<Design> design(new Design(designVLNV, Document::Revision::Std22));
+    for (int i = 0; i < parameters_.instanceFanout; ++i)
+    {
+        VLNV instanceVLNV = instantiated.at(random_.bounded(instantiated.size()));
+
+        QSharedPointer<ConfigurableVLNVReference> componentReference(new ConfigurableVLNVReference(instanceVLNV));
+        design->getComponentInstances()->append(QSharedPointer<ComponentInstance>(
+            new ComponentInstance(QStringLiteral("instance%1").arg(i), componentReference)));
+    }
+
+    QSharedPointer<DesignInstantiation> designInstantiation(new DesignInstantiation(QStringLiteral("structural")));
+    designInstantiation->setDesignReference(
+        QSharedPointer<ConfigurableVLNVReference>(new ConfigurableVLNVReference(designVLNV)));
+    component->getDesignInstantiations()->append(designInstantiation);
+
+    QSharedPointer<View> hierarchicalView(new View(QStringLiteral("structural")));
+    hierarchicalView->setDesignInstantiationRef(designInstantiation->name());
+    component->getViews()->append(hierarchicalView);
+
+    return design;
+}
+
+//-----------------------------------------------------------------------------
+// Function: SyntheticLibraryGenerator::writeDocument()
+//-----------------------------------------------------------------------------
+QString SyntheticLibraryGenerator::writeDocument(QString const& directory, QSharedPointer<Document> document)
+{
+    VLNV vlnv = document->getVlnv();
+
+    QString documentDirectory = directory + QLatin1Char('/') + vlnv.getVendor() + QLatin1Char('/') +
+        vlnv.getLibrary() + QLatin1Char('/') + vlnv.getName() + QLatin1Char('/') + vlnv.getVersion();
+
+    QString path = documentDirectory + QLatin1Char('/') + vlnv.getName() + QLatin1Char('.') +
+        vlnv.getVersion() + QStringLiteral(".xml");
+
+    if (QDir().mkpath(documentDirectory) == false || DocumentFileAccess::writeDocument(document, path) == false)
+    {
+        return QString();
+    }
+
+    documentCount_++;
+    return path;
+}
+
+//-----------------------------------------------------------------------------
+// Function: SyntheticLibraryGenerator::levelOf()
+//-----------------------------------------------------------------------------
+int SyntheticLibraryGenerator::levelOf(int index) const
+{
+    if (parameters_.instanceFanout < 2)
+    {
+        return 0;
+    }
+
+    // Every fan-out:th component is one level up, every fan-out^2:th two levels up and so on.
+    int level = 0;
+    int position = index + 1;
+    while (level < parameters_.hierarchyDepth && position % parameters_.instanceFanout == 0)
+    {
+        position /= parameters_.instanceFanout;
+        ++level;
+    }
+
+    return level;
+}
@@ -0,0 +1,149 @@
+//-----------------------------------------------------------------------------
+// File: SyntheticLibraryGenerator.h
+//-----------------------------------------------------------------------------
+// Project: Kactus2
+// Author: Kactus2 team
+// Date: 16.10.2026
+//
+// Description:
+// Generates deterministic IP-XACT libraries of a given size for performance tests.
+//-----------------------------------------------------------------------------
+
+#ifndef SYNTHETICLIBRARYGENERATOR_H
+#define SYNTHETICLIBRARYGENERATOR_H
+
+#include <IPXACTmodels/common/VLNV.h>
+
+#include <QRandomGenerator>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+class Component;
+class Document;
+class Design;
+
+//-----------------------------------------------------------------------------
+//! Generates deterministic IP-XACT libraries of a given size for performance tests.
+//!
+//! Every component has the given number of ports and one memory map with the given number of registers.
+//! The components are arranged in levels: every fan-out:th component is hierarchical and instantiates
+//! fan-out components from the level below it in a design of its own, up to the given hierarchy depth.
+//! The same parameters always produce the same library.
+//-----------------------------------------------------------------------------
+class SyntheticLibraryGenerator
+{
+public:
+
+    //! The parameters of the generated library.
+    struct Parameters
+    {
+        int componentCount = 1000;      //<! The number of components.
+        int portsPerComponent = 16;     //<! The number of ports in each component.
+        int registersPerMap = 32;       //<! The number of registers in the memory map of each component.
+        int hierarchyDepth = 3;         //<! The maximum number of hierarchy levels above the leaf components.
+        int instanceFanout = 4;         //<! The number of instances in each design.
+        quint32 seed = 1;               //<! The seed for the generated port and register variations.
+    };
+
+    /*!
+     *  The constructor.
+     *
+     *    @param [in] parameters  The parameters of the generated library.
+     */
+    explicit SyntheticLibraryGenerator(Parameters const& parameters);
+
+    //! The destructor.
+    ~SyntheticLibraryGenerator() = default;
+
+    /*!
+     *  Writes the library into the given directory using the vendor/library/name/version layout.
+     *
+     *    @param [in] directory   The root directory of the library.
+     *
+     *    @return True, if all the documents were written, otherwise false.
+     */
+    bool generate(QString const& directory);
+
+    /*!
+     *  Gets the number of documents in the generated library.
+     *
+     *    @return The number of components and designs.
+     */
+    int documentCount() const;
+
+    /*!
+     *  Gets the paths of the generated component files.
+     *
+     *    @return The file paths in the order of generation.
+     */
+    QVector<QString> componentPaths() const;
+
+    /*!
+     *  Gets the topmost generated component.
+     *
+     *    @return The VLNV of the last component on the highest hierarchy level.
+     */
+    VLNV topComponent() const;
+
+private:
+
+    /*!
+     *  Creates a component with ports and a memory map.
+     *
+     *    @param [in] vlnv    The VLNV of the component.
+     *
+     *    @return The created component.
+     */
+    QSharedPointer<Component> createComponent(VLNV const& vlnv);
+
+    /*!
+     *  Creates a design instantiating components from the given level and references it from the component.
+     *
+     *    @param [in] component       The hierarchical component.
+     *    @param [in] instantiated    The components to choose the instances from.
+     *
+     *    @return The created design.
+     */
+    QSharedPointer<Design> createDesign(QSharedPointer<Component> component, QVector<VLNV> const& instantiated);
+
+    /*!
+     *  Writes a document to its place in the library.
+     *
+     *    @param [in] directory   The root directory of the library.
+     *    @param [in] document    The document to write.
+     *
+     *    @return The path to the written file, or an empty string if writing failed.
+     */
+    QString writeDocument(QString const& directory, QSharedPointer<Document> document);
+
+    /*!
+     *  Finds the hierarchy level of a component.
+     *
+     *    @param [in] index   The index of the component.
+     *
+     *    @return The hierarchy level, zero for leaf components.
+     */
+    int levelOf(int index) const;
+
+    //-----------------------------------------------------------------------------
+    // Data.
+    //-----------------------------------------------------------------------------
+
+    //! The parameters of the generated library.
+    Parameters parameters_;
+
+    //! The source of the generated variations.
+    QRandomGenerator random_;
+
+    //! The generated components on each hierarchy level.
+    QVector<QVector<VLNV> > levels_;
+
+    //! The paths of the generated component files.
+    QVector<QString> componentPaths_;
+
+    //! The number of generated documents.
+    int documentCount_ = 0;
+};
+
+#endif // SYNTHETICLIBRARYGENERATOR_H
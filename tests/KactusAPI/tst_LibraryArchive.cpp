@@ -0,0 +1,473 @@
+//-----------------------------------------------------------------------------
+// File: tst_LibraryArchive.cpp
+//-----------------------------------------------------------------------------
+// Project: Kactus2
+// Author: Kactus2 team
+// Date: 16.10.2026
+//
+// Description:
+// Unit test for reading library locations packed into zip archives.
+//-----------------------------------------------------------------------------
+
+#include <QtTest>
+
+#include <KactusAPI/include/LibraryArchive.h>
+#include <KactusAPI/include/LibraryHandler.h>
+#include <KactusAPI/include/LibraryLoader.h>
+#include <KactusAPI/include/MessageMediator.h>
+
+#include <IPXACTmodels/common/Document.h>
+#include <IPXACTmodels/common/VLNV.h>
+
+#include <QBuffer>
+#include <QDataStream>
+#include <QTemporaryDir>
+
+namespace
+{
+    //! A file to pack into a test archive.
+    struct ArchivedFile
+    {
+        QString name;           //<! The path of the file in the archive.
+        QByteArray content;     //<! The content of the file.
+        bool compressed;        //<! Flag for deflating the content.
+        qint64 declaredSize = -1;   //<! The size written in the archive, if other than the size of the content.
+    };
+
+    //-----------------------------------------------------------------------------
+    // Function: checksum()
+    //-----------------------------------------------------------------------------
+    quint32 checksum(QByteArray const& data)
+    {
+        quint32 crc = 0xFFFFFFFFu;
+        for (char const byte : data)
+        {
+            crc ^= static_cast<quint8>(byte);
+            for (int bit = 0; bit < 8; ++bit)
+            {
+                crc = (crc & 1) ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+            }
+        }
+
+        return crc ^ 0xFFFFFFFFu;
+    }
+
+    //-----------------------------------------------------------------------------
+    // Function: createArchive()
+    //-----------------------------------------------------------------------------
+    QByteArray createArchive(QVector<ArchivedFile> const& files, bool zip64 = false)
+    {
+        // 16.2.2025 12:00:00 in the MS-DOS format.
+        constexpr quint16 FILE_TIME = 12 << 11;
+        constexpr quint16 FILE_DATE = (45 << 9) | (2 << 5) | 16;
+
+        QByteArray archive;
+        QBuffer archiveBuffer(&archive);
+        archiveBuffer.open(QIODevice::WriteOnly);
+
+        QDataStream stream(&archiveBuffer);
+        stream.setByteOrder(QDataStream::LittleEndian);
+
+        QByteArray directory;
+        QBuffer directoryBuffer(&directory);
+        directoryBuffer.open(QIODevice::WriteOnly);
+
+        QDataStream directoryStream(&directoryBuffer);
+        directoryStream.setByteOrder(QDataStream::LittleEndian);
+
+        for (ArchivedFile const& file : files)
+        {
+            // The zlib stream of qCompress() has a size prefix, a header and a checksum around the raw deflate data.
+            QByteArray const data = file.compressed ? qCompress(file.content, 9).mid(6).chopped(4) : file.content;
+            QByteArray const name = file.name.toUtf8();
+            quint16 const method = file.compressed ? 8 : 0;
+            quint32 const headerOffset = archive.size();
+            quint64 const size = file.declaredSize >= 0 ? file.declaredSize : file.content.size();
+
+            // In zip64 archives, the sizes are in the extra field of the central directory instead.
+            quint32 const compressedSizeField = zip64 ? 0xFFFFFFFFu : quint32(data.size());
+            quint32 const sizeField = zip64 ? 0xFFFFFFFFu : quint32(size);
+            quint16 const extraLength = zip64 ? 20 : 0;
+
+            stream << quint32(0x04034B50) << quint16(45) << quint16(0x0800) << method << FILE_TIME << FILE_DATE <<
+                checksum(file.content) << compressedSizeField << sizeField << quint16(name.size()) << quint16(0);
+            stream.writeRawData(name.constData(), name.size());
+            stream.writeRawData(data.constData(), data.size());
+
+            directoryStream << quint32(0x02014B50) << quint16(45) << quint16(45) << quint16(0x0800) << method <<
+                FILE_TIME << FILE_DATE << checksum(file.content) << compressedSizeField << sizeField <<
+                quint16(name.size()) << extraLength << quint16(0) << quint16(0) << quint16(0) << quint32(0) <<
+                headerOffset;
+            directoryStream.writeRawData(name.constData(), name.size());
+
+            if (zip64)
+            {
+                directoryStream << quint16(0x0001) << quint16(16) << size << quint64(data.size());
+            }
+        }
+
+        quint32 const directoryOffset = archive.size();
+        stream.writeRawData(directory.constData(), directory.size());
+
+        if (zip64)
+        {
+            quint64 const zip64RecordOffset = archive.size();
+            stream << quint32(0x06064B50) << quint64(44) << quint16(45) << quint16(45) << quint32(0) << quint32(0) <<
+                quint64(files.size()) << quint64(files.size()) << quint64(directory.size()) <<
+                quint64(directoryOffset);
+            stream << quint32(0x07064B50) << quint32(0) << zip64RecordOffset << quint32(1);
+            stream << quint32(0x06054B50) << quint16(0) << quint16(0) << quint16(0xFFFF) << quint16(0xFFFF) <<
+                quint32(0xFFFFFFFFu) << quint32(0xFFFFFFFFu) << quint16(0);
+        }
+        else
+        {
+            stream << quint32(0x06054B50) << quint16(0) << quint16(0) << quint16(files.size()) <<
+                quint16(files.size()) << quint32(directory.size()) << directoryOffset << quint16(0);
+        }
+
+        return archive;
+    }
+
+    //-----------------------------------------------------------------------------
+    // Function: componentContent()
+    //-----------------------------------------------------------------------------
+    QByteArray componentContent(QString const& name, int portCount)
+    {
+        QByteArray content = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            "<ipxact:component xmlns:ipxact=\"http://www.accellera.org/XMLSchema/IPXACT/1685-2014\">\n"
+            "\t<ipxact:vendor>tut.fi</ipxact:vendor>\n"
+            "\t<ipxact:library>ip</ipxact:library>\n"
+            "\t<ipxact:name>" + name.toUtf8() + "</ipxact:name>\n"
+            "\t<ipxact:version>1.0</ipxact:version>\n"
+            "\t<ipxact:model>\n"
+            "\t\t<ipxact:ports>\n";
+
+        for (int i = 0; i < portCount; ++i)
+        {
+            content += "\t\t\t<ipxact:port>\n"
+                "\t\t\t\t<ipxact:name>data_" + QByteArray::number(i) + "</ipxact:name>\n"
+                "\t\t\t\t<ipxact:wire>\n"
+                "\t\t\t\t\t<ipxact:direction>" + QByteArray(i % 2 ? "in" : "out") + "</ipxact:direction>\n"
+                "\t\t\t\t</ipxact:wire>\n"
+                "\t\t\t</ipxact:port>\n";
+        }
+
+        content += "\t\t</ipxact:ports>\n"
+            "\t</ipxact:model>\n"
+            "</ipxact:component>\n";
+
+        return content;
+    }
+}
+
+//-----------------------------------------------------------------------------
+//! Collects the errors of the library during the tests.
+//-----------------------------------------------------------------------------
+class ErrorChannel : public MessageMediator
+{
+public:
+    void showMessage(QString const&) const final {}
+    void showError(QString const& error) const final { errors_.append(error); }
+    void showFailure(QString const& error) const final { errors_.append(error); }
+    void showStatusMessage(QString const&) const final {}
+
+    //! The reported errors.
+    mutable QStringList errors_;
+};
+
+class tst_LibraryArchive : public QObject
+{
+    Q_OBJECT
+
+public:
+    tst_LibraryArchive();
+
+private slots:
+
+    void initTestCase();
+
+    void testArchiveIsRecognized();
+    void testDocumentsAreFound();
+    void testEntriesAreRead();
+    void testPathsInArchiveAreFound();
+    void testCorruptedEntryIsRejected();
+    void testZip64ArchiveIsRead();
+    void testOversizedEntryIsRejected();
+
+    void testArchiveLocationIsScanned();
+    void testArchivedDocumentIsReadOnly();
+
+private:
+
+    /*!
+     *  Writes an archive into the test directory.
+     *
+     *    @param [in] fileName    The name of the archive file.
+     *    @param [in] content     The content of the archive.
+     *
+     *    @return The path to the archive.
+     */
+    QString writeArchive(QString const& fileName, QByteArray const& content) const;
+
+    //! The directory for the test archives.
+    QTemporaryDir testDirectory_;
+
+    //! The path to the archive of the test library.
+    QString archivePath_;
+
+    //! The files in the archive of the test library.
+    QVector<ArchivedFile> archivedFiles_;
+
+    //! Output for the library messages.
+    ErrorChannel messageChannel_;
+};
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryArchive::tst_LibraryArchive()
+//-----------------------------------------------------------------------------
+tst_LibraryArchive::tst_LibraryArchive():
+testDirectory_(),
+archivePath_(),
+archivedFiles_(),
+messageChannel_()
+{
+
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryArchive::initTestCase()
+//-----------------------------------------------------------------------------
+void tst_LibraryArchive::initTestCase()
+{
+    QVERIFY(testDirectory_.isValid());
+
+    QCoreApplication::setOrganizationDomain(QStringLiteral("tut.fi"));
+    QCoreApplication::setOrganizationName(QStringLiteral("TUT"));
+    QCoreApplication::setApplicationName(QStringLiteral("Kactus2_tests"));
+
+    archivedFiles_ = {
+        { QStringLiteral("tut.fi/ip/uart/1.0/uart.1.0.xml"), componentContent(QStringLiteral("uart"), 200), true },
+        { QStringLiteral("tut.fi/ip/uart/1.0/uart.v"), QByteArray("module uart();\nendmodule\n"), false },
+        { QStringLiteral("tut.fi/ip/gpio/1.0/gpio.1.0.xml"), componentContent(QStringLiteral("gpio"), 2), false },
+        { QStringLiteral("tut.fi/ip/gpio/1.0/gpio.v"), QByteArray(), false }
+    };
+
+    archivePath_ = writeArchive(QStringLiteral("library.zip"), createArchive(archivedFiles_));
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryArchive::testArchiveIsRecognized()
+//-----------------------------------------------------------------------------
+void tst_LibraryArchive::testArchiveIsRecognized()
+{
+    QVERIFY(LibraryArchive::isArchive(archivePath_));
+    QVERIFY(LibraryArchive::isArchive(testDirectory_.path()) == false);
+
+    QVERIFY(LibraryArchive::isArchiveEntry(archivePath_ + QStringLiteral("/tut.fi/ip/uart/1.0/uart.1.0.xml")));
+    QVERIFY(LibraryArchive::isArchiveEntry(testDirectory_.filePath(QStringLiteral("library/uart.1.0.xml"))) ==
+        false);
+    QVERIFY(LibraryArchive::isArchiveEntry(testDirectory_.filePath(QStringLiteral("missing.zip/uart.1.0.xml"))) ==
+        false);
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryArchive::testDocumentsAreFound()
+//-----------------------------------------------------------------------------
+void tst_LibraryArchive::testDocumentsAreFound()
+{
+    QVector<LibraryArchive::Entry> documents;
+    QVERIFY(LibraryArchive::findDocuments(archivePath_, documents));
+
+    QCOMPARE(documents.size(), 2);
+    QCOMPARE(documents.first().path, archivePath_ + QStringLiteral("/tut.fi/ip/uart/1.0/uart.1.0.xml"));
+    QCOMPARE(documents.first().size, qint64(archivedFiles_.first().content.size()));
+    QCOMPARE(documents.last().path, archivePath_ + QStringLiteral("/tut.fi/ip/gpio/1.0/gpio.1.0.xml"));
+
+    QDateTime const expectedTime(QDate(2025, 2, 16), QTime(12, 0));
+    QCOMPARE(documents.first().lastModified, expectedTime.toMSecsSinceEpoch());
+
+    QVERIFY(LibraryArchive::findDocuments(testDirectory_.filePath(QStringLiteral("missing.zip")), documents) ==
+        false);
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryArchive::testEntriesAreRead()
+//-----------------------------------------------------------------------------
+void tst_LibraryArchive::testEntriesAreRead()
+{
+    for (ArchivedFile const& file : archivedFiles_)
+    {
+        QByteArray content;
+        QVERIFY(LibraryArchive::readEntry(archivePath_ + QLatin1Char('/') + file.name, content));
+        QCOMPARE(content, file.content);
+    }
+
+    QByteArray content;
+    QVERIFY(LibraryArchive::readEntry(archivePath_ + QStringLiteral("/tut.fi/ip/uart/1.0/missing.xml"), content) ==
+        false);
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryArchive::testPathsInArchiveAreFound()
+//-----------------------------------------------------------------------------
+void tst_LibraryArchive::testPathsInArchiveAreFound()
+{
+    QVERIFY(LibraryArchive::contains(archivePath_ + QStringLiteral("/tut.fi/ip/uart/1.0/uart.v")));
+    QVERIFY(LibraryArchive::contains(archivePath_ + QStringLiteral("/tut.fi/ip/gpio/1.0/../../uart/1.0/uart.v")));
+    QVERIFY(LibraryArchive::contains(archivePath_ + QStringLiteral("/tut.fi/ip")));
+
+    QVERIFY(LibraryArchive::contains(archivePath_ + QStringLiteral("/tut.fi/ip/uart/1.0/uart.vhd")) == false);
+    QVERIFY(LibraryArchive::contains(testDirectory_.filePath(QStringLiteral("uart.v"))) == false);
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryArchive::testCorruptedEntryIsRejected()
+//-----------------------------------------------------------------------------
+void tst_LibraryArchive::testCorruptedEntryIsRejected()
+{
+    ArchivedFile const file = archivedFiles_.first();
+
+    // The data of the first file follows its local header.
+    QByteArray archive = createArchive({ file });
+    archive[30 + file.name.size() + 100] = archive.at(30 + file.name.size() + 100) ^ 0x10;
+
+    QString const corruptedPath = writeArchive(QStringLiteral("corrupted.zip"), archive);
+
+    QVector<LibraryArchive::Entry> documents;
+    QVERIFY(LibraryArchive::findDocuments(corruptedPath, documents));
+    QCOMPARE(documents.size(), 1);
+
+    QByteArray content;
+    QVERIFY(LibraryArchive::readEntry(documents.first().path, content) == false);
+    QVERIFY(content.isEmpty());
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryArchive::testZip64ArchiveIsRead()
+//-----------------------------------------------------------------------------
+void tst_LibraryArchive::testZip64ArchiveIsRead()
+{
+    QString const zip64Path = writeArchive(QStringLiteral("zip64.zip"), createArchive(archivedFiles_, true));
+
+    QVector<LibraryArchive::Entry> documents;
+    QVERIFY(LibraryArchive::findDocuments(zip64Path, documents));
+
+    QCOMPARE(documents.size(), 2);
+    QCOMPARE(documents.first().size, qint64(archivedFiles_.first().content.size()));
+
+    for (ArchivedFile const& file : archivedFiles_)
+    {
+        QByteArray content;
+        QVERIFY(LibraryArchive::readEntry(zip64Path + QLatin1Char('/') + file.name, content));
+        QCOMPARE(content, file.content);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryArchive::testOversizedEntryIsRejected()
+//-----------------------------------------------------------------------------
+void tst_LibraryArchive::testOversizedEntryIsRejected()
+{
+    // The sizes in an archive are not trusted, so neither a huge size nor a size smaller than the content is read.
+    ArchivedFile hugeFile = archivedFiles_.first();
+    hugeFile.declaredSize = Q_INT64_C(1) << 40;
+
+    ArchivedFile truncatedFile = archivedFiles_.first();
+    truncatedFile.name = QStringLiteral("tut.fi/ip/uart/1.0/truncated.xml");
+    truncatedFile.declaredSize = 100;
+
+    QString const oversizedPath = writeArchive(QStringLiteral("oversized.zip"),
+        createArchive({ hugeFile, truncatedFile }, true));
+
+    QVector<LibraryArchive::Entry> documents;
+    QVERIFY(LibraryArchive::findDocuments(oversizedPath, documents));
+    QCOMPARE(documents.size(), 2);
+
+    for (LibraryArchive::Entry const& document : documents)
+    {
+        QByteArray content;
+        QVERIFY(LibraryArchive::readEntry(document.path, content) == false);
+        QVERIFY(content.isEmpty());
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryArchive::testArchiveLocationIsScanned()
+//-----------------------------------------------------------------------------
+void tst_LibraryArchive::testArchiveLocationIsScanned()
+{
+    QSettings().setValue(QStringLiteral("Library/ActiveLocations"), QStringList(archivePath_));
+
+    LibraryLoader loader;
+    QVector<LibraryLoader::LoadTarget> const targets = loader.parseLibrary(&messageChannel_);
+
+    QCOMPARE(targets.size(), 2);
+    QCOMPARE(targets.first().vlnv, VLNV(VLNV::COMPONENT, QStringLiteral("tut.fi:ip:uart:1.0")));
+    QCOMPARE(targets.first().path, archivePath_ + QStringLiteral("/tut.fi/ip/uart/1.0/uart.1.0.xml"));
+
+    LibraryHandler& library = LibraryHandler::getInstance();
+    library.setOutputChannel(&messageChannel_);
+    library.searchForIPXactFiles();
+
+    VLNV const uartVLNV(VLNV::COMPONENT, QStringLiteral("tut.fi:ip:uart:1.0"));
+    QVERIFY(library.contains(uartVLNV));
+    QVERIFY(library.contains(VLNV(VLNV::COMPONENT, QStringLiteral("tut.fi:ip:gpio:1.0"))));
+    QCOMPARE(library.getPath(uartVLNV), targets.first().path);
+
+    QSharedPointer<Document const> model = library.getModelReadOnly(uartVLNV);
+    QVERIFY(model.isNull() == false);
+    QCOMPARE(model->getVlnv(), uartVLNV);
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryArchive::testArchivedDocumentIsReadOnly()
+//-----------------------------------------------------------------------------
+void tst_LibraryArchive::testArchivedDocumentIsReadOnly()
+{
+    QSettings().setValue(QStringLiteral("Library/ActiveLocations"), QStringList(archivePath_));
+
+    LibraryHandler& library = LibraryHandler::getInstance();
+    library.setOutputChannel(&messageChannel_);
+    library.searchForIPXactFiles();
+
+    VLNV const uartVLNV(VLNV::COMPONENT, QStringLiteral("tut.fi:ip:uart:1.0"));
+    QSharedPointer<Document> model = library.getModel(uartVLNV);
+    QVERIFY(model.isNull() == false);
+
+    QFileInfo const archiveInfo(archivePath_);
+    qint64 const archiveSize = archiveInfo.size();
+    messageChannel_.errors_.clear();
+
+    QVERIFY(library.writeModelToFile(model) == false);
+    QCOMPARE(messageChannel_.errors_.size(), 1);
+
+    library.removeObject(uartVLNV);
+    QCOMPARE(messageChannel_.errors_.size(), 2);
+    QVERIFY(library.contains(uartVLNV));
+
+    QCOMPARE(QFileInfo(archivePath_).size(), archiveSize);
+
+    QByteArray content;
+    QVERIFY(LibraryArchive::readEntry(library.getPath(uartVLNV), content));
+    QCOMPARE(content, archivedFiles_.first().content);
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryArchive::writeArchive()
+//-----------------------------------------------------------------------------
+QString tst_LibraryArchive::writeArchive(QString const& fileName, QByteArray const& content) const
+{
+    QString const path = QDir::cleanPath(testDirectory_.filePath(fileName));
+
+    QFile archiveFile(path);
+    if (archiveFile.open(QIODevice::WriteOnly) == false || archiveFile.write(content) != content.size())
+    {
+        return QString();
+    }
+
+    return path;
+}
+
+QTEST_GUILESS_MAIN(tst_LibraryArchive)
+
+#include "tst_LibraryArchive.moc"
@@ -0,0 +1,640 @@
+//-----------------------------------------------------------------------------
+// File: tst_LibraryPerformance.cpp
+//-----------------------------------------------------------------------------
+// Project: Kactus2
+// Author: Kactus2 team
+// Date: 16.10.2026
+//
+// Description:
+// Performance benchmarks for loading and checking a large library.
+//-----------------------------------------------------------------------------
+
+#include <QtTest>
+
+#include "SyntheticLibraryGenerator.h"
+
+#include <KactusAPI/include/DocumentFileAccess.h>
+#include <KactusAPI/include/LibraryHandler.h>
+#include <KactusAPI/include/LibraryLoader.h>
+#include <KactusAPI/include/MessageMediator.h>
+#include <KactusAPI/include/VLNVTable.h>
+#include <KactusAPI/include/hierarchymodel.h>
+
+#include <IPXACTmodels/common/Document.h>
+
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+namespace
+{
+    //-----------------------------------------------------------------------------
+    // Function: stringDataSize()
+    //-----------------------------------------------------------------------------
+    qint64 stringDataSize(QVector<VLNV> const& vlnvs)
+    {
+        // Strings sharing their data are counted once.
+        QSet<QChar const*> countedData;
+        qint64 size = 0;
+        for (VLNV const& vlnv : vlnvs)
+        {
+            QStringList const fields{ vlnv.getVendor(), vlnv.getLibrary(), vlnv.getName(), vlnv.getVersion() };
+            for (QString const& field : fields)
+            {
+                if (countedData.contains(field.constData()) == false)
+                {
+                    countedData.insert(field.constData());
+                    size += sizeof(QArrayData) + field.capacity() * sizeof(QChar);
+                }
+            }
+        }
+
+        return size;
+    }
+}
+
+//-----------------------------------------------------------------------------
+//! Discards the messages of the library during the benchmarks.
+//-----------------------------------------------------------------------------
+class SilentChannel : public MessageMediator
+{
+public:
+    void showMessage(QString const&) const final {}
+    void showError(QString const&) const final {}
+    void showFailure(QString const&) const final {}
+    void showStatusMessage(QString const&) const final {}
+};
+
+//-----------------------------------------------------------------------------
+//! Performance benchmarks for loading and checking a large library.
+//!
+//! The size of the generated library is read from the environment variables KACTUS2_BENCHMARK_COMPONENTS,
+//! KACTUS2_BENCHMARK_PORTS, KACTUS2_BENCHMARK_REGISTERS, KACTUS2_BENCHMARK_DEPTH and KACTUS2_BENCHMARK_FANOUT.
+//! The results are written in JSON to the file named by KACTUS2_BENCHMARK_OUTPUT, if set, for comparing the
+//! results between builds.
+//!
+//! The benchmarks are built only with qmake CONFIG+=benchmarks and are not run with the unit tests. The benchmarks
+//! using the library start from a freshly searched library, so they do not depend on the order they are run in.
+//-----------------------------------------------------------------------------
+class tst_LibraryPerformance : public QObject
+{
+    Q_OBJECT
+
+public:
+    tst_LibraryPerformance();
+
+private slots:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkParseLibrary();
+    void benchmarkReadHeadersOfMixedFiles();
+
+    void benchmarkInternVLNVs();
+    void benchmarkFindVLNVs_data();
+    void benchmarkFindVLNVs();
+
+    void benchmarkReadComponent();
+    void benchmarkReadComponentWithHash();
+    void benchmarkReadHierarchicalComponent();
+    void benchmarkWriteComponent();
+
+    void benchmarkCheckLibraryIntegrity();
+    void benchmarkRefreshTouchedLibrary();
+    void benchmarkResetHierarchyModel();
+
+private:
+
+    /*!
+     *  Sets the library locations searched by the library.
+     *
+     *    @param [in] locations   The locations to search.
+     */
+    void setLibraryLocations(QStringList const& locations);
+
+    /*!
+     *  Searches the generated library again, dropping the documents read and the changes made by the previous
+     *  benchmarks.
+     */
+    void resetLibrary();
+
+    /*!
+     *  Stores the result of the current benchmark for the JSON output.
+     *
+     *    @param [in] timer           The timer started right before the benchmark.
+     *    @param [in] iterations      The number of times the benchmarked code was run.
+     *    @param [in] measurements    Other measurements of the benchmark to store.
+     */
+    void recordResult(QElapsedTimer const& timer, int iterations,
+        QJsonObject const& measurements = QJsonObject());
+
+    //! Reads a library size parameter from the environment.
+    static int parameterFromEnvironment(char const* name, int defaultValue);
+
+    //! The directory of the generated library.
+    QTemporaryDir libraryDirectory_;
+
+    //! The parameters of the generated library.
+    SyntheticLibraryGenerator::Parameters parameters_;
+
+    //! The generator of the library.
+    SyntheticLibraryGenerator generator_;
+
+    //! Output for the library messages.
+    SilentChannel messageChannel_;
+
+    //! The results of the benchmarks.
+    QJsonArray results_;
+};
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryPerformance::tst_LibraryPerformance()
+//-----------------------------------------------------------------------------
+tst_LibraryPerformance::tst_LibraryPerformance():
+parameters_{ parameterFromEnvironment("KACTUS2_BENCHMARK_COMPONENTS", 2000),
+    parameterFromEnvironment("KACTUS2_BENCHMARK_PORTS", 16),
+    parameterFromEnvironment("KACTUS2_BENCHMARK_REGISTERS", 32),
+    parameterFromEnvironment("KACTUS2_BENCHMARK_DEPTH", 3),
+    parameterFromEnvironment("KACTUS2_BENCHMARK_FANOUT", 4), 1 },
+generator_(parameters_)
+{
+
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryPerformance::initTestCase()
+//-----------------------------------------------------------------------------
+void tst_LibraryPerformance::initTestCase()
+{
+    QVERIFY(libraryDirectory_.isValid());
+    QVERIFY(generator_.generate(libraryDirectory_.path()));
+
+    QCoreApplication::setOrganizationDomain(QStringLiteral("tut.fi"));
+    QCoreApplication::setOrganizationName(QStringLiteral("TUT"));
+    QCoreApplication::setApplicationName(QStringLiteral("Kactus2_benchmarks"));
+
+    setLibraryLocations(QStringList(libraryDirectory_.path()));
+
+    LibraryHandler& library = LibraryHandler::getInstance();
+    library.setOutputChannel(&messageChannel_);
+    library.setBackgroundValidation(false);
+    library.searchForIPXactFiles();
+
+    QCOMPARE(library.getAllVLNVs().count(), generator_.documentCount());
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryPerformance::cleanupTestCase()
+//-----------------------------------------------------------------------------
+void tst_LibraryPerformance::cleanupTestCase()
+{
+    QJsonObject library;
+    library.insert(QStringLiteral("components"), parameters_.componentCount);
+    library.insert(QStringLiteral("portsPerComponent"), parameters_.portsPerComponent);
+    library.insert(QStringLiteral("registersPerMap"), parameters_.registersPerMap);
+    library.insert(QStringLiteral("hierarchyDepth"), parameters_.hierarchyDepth);
+    library.insert(QStringLiteral("instanceFanout"), parameters_.instanceFanout);
+    library.insert(QStringLiteral("documents"), generator_.documentCount());
+
+    QJsonObject report;
+    report.insert(QStringLiteral("qtVersion"), QString::fromLatin1(qVersion()));
+    report.insert(QStringLiteral("timestamp"), QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    report.insert(QStringLiteral("library"), library);
+    report.insert(QStringLiteral("results"), results_);
+
+    QString outputPath = qEnvironmentVariable("KACTUS2_BENCHMARK_OUTPUT");
+    if (outputPath.isEmpty())
+    {
+        return;
+    }
+
+    QFile outputFile(outputPath);
+    QVERIFY2(outputFile.open(QFile::WriteOnly | QFile::Truncate), qPrintable(outputPath));
+    outputFile.write(QJsonDocument(report).toJson());
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryPerformance::benchmarkParseLibrary()
+//-----------------------------------------------------------------------------
+void tst_LibraryPerformance::benchmarkParseLibrary()
+{
+    LibraryLoader loader;
+    QVector<LibraryLoader::LoadTarget> targets;
+
+    int iterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK
+    {
+        targets = loader.parseLibrary(&messageChannel_);
+        iterations++;
+    }
+    recordResult(timer, iterations);
+
+    QCOMPARE(targets.count(), generator_.documentCount());
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryPerformance::benchmarkReadHeadersOfMixedFiles()
+//-----------------------------------------------------------------------------
+void tst_LibraryPerformance::benchmarkReadHeadersOfMixedFiles()
+{
+    constexpr int FILES_OF_EACH_KIND = 50;
+
+    QTemporaryDir mixedDirectory;
+    QVERIFY(mixedDirectory.isValid());
+
+    // Library documents mixed with large foreign XML files, like simulation dumps and tool project files.
+    QStringList paths;
+    QVector<QString> componentPaths = generator_.componentPaths();
+    for (int i = 0; i < FILES_OF_EACH_KIND && i < componentPaths.size(); ++i)
+    {
+        QString path = mixedDirectory.filePath(QStringLiteral("component%1.xml").arg(i));
+        QVERIFY(QFile::copy(componentPaths.at(i), path));
+        paths.append(path);
+    }
+
+    QByteArray foreignContent("<?xml version=\"1.0\"?>\n<waveform>\n");
+    for (int i = 0; i < 10000; ++i)
+    {
+        foreignContent.append("  <sample time=\"" + QByteArray::number(i) + "\">0101</sample>\n");
+    }
+    foreignContent.append("</waveform>\n");
+
+    for (int i = 0; i < FILES_OF_EACH_KIND; ++i)
+    {
+        QString path = mixedDirectory.filePath(QStringLiteral("dump%1.xml").arg(i));
+
+        QFile foreignFile(path);
+        QVERIFY(foreignFile.open(QFile::WriteOnly));
+        foreignFile.write(foreignContent);
+        paths.append(path);
+    }
+
+    LibraryLoader loader;
+    int documentCount = 0;
+
+    int iterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK
+    {
+        documentCount = 0;
+        for (QString const& path : paths)
+        {
+            if (loader.readFile(path, &messageChannel_).vlnv.isValid())
+            {
+                documentCount++;
+            }
+        }
+        iterations++;
+    }
+    recordResult(timer, iterations);
+
+    QCOMPARE(documentCount, qMin(FILES_OF_EACH_KIND, componentPaths.size()));
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryPerformance::benchmarkInternVLNVs()
+//-----------------------------------------------------------------------------
+void tst_LibraryPerformance::benchmarkInternVLNVs()
+{
+    LibraryLoader loader;
+
+    // Each VLNV read from a file has its own copies of the strings.
+    QVector<VLNV> foundVLNVs;
+    for (LibraryLoader::LoadTarget const& target : loader.parseLibrary(&messageChannel_))
+    {
+        foundVLNVs.append(target.vlnv);
+    }
+
+    QVector<VLNV> internedVLNVs;
+    int stringCount = 0;
+
+    int iterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK
+    {
+        VLNVTable table;
+        internedVLNVs.clear();
+        for (VLNV const& vlnv : foundVLNVs)
+        {
+            internedVLNVs.append(table.vlnv(table.insert(vlnv)));
+        }
+
+        stringCount = table.stringCount();
+        iterations++;
+    }
+
+    QJsonObject measurements;
+    measurements.insert(QStringLiteral("vlnvs"), foundVLNVs.size());
+    measurements.insert(QStringLiteral("internedStrings"), stringCount);
+    measurements.insert(QStringLiteral("stringBytesBefore"), stringDataSize(foundVLNVs));
+    measurements.insert(QStringLiteral("stringBytesAfter"), stringDataSize(internedVLNVs));
+    recordResult(timer, iterations, measurements);
+
+    QCOMPARE(internedVLNVs, foundVLNVs);
+    QVERIFY(stringDataSize(internedVLNVs) < stringDataSize(foundVLNVs));
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryPerformance::benchmarkFindVLNVs_data()
+//-----------------------------------------------------------------------------
+void tst_LibraryPerformance::benchmarkFindVLNVs_data()
+{
+    QTest::addColumn<bool>("interned");
+
+    QTest::newRow("orderedMap") << false;
+    QTest::newRow("internedTable") << true;
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryPerformance::benchmarkFindVLNVs()
+//-----------------------------------------------------------------------------
+void tst_LibraryPerformance::benchmarkFindVLNVs()
+{
+    QFETCH(bool, interned);
+
+    QMap<VLNV, int> orderedMap;
+    VLNVTable table;
+
+    // The searched VLNVs are copies, like the references read from the documents.
+    QVector<VLNV> searchedVLNVs;
+    for (VLNV const& vlnv : LibraryHandler::getInstance().getAllVLNVs())
+    {
+        orderedMap.insert(vlnv, table.insert(vlnv));
+        searchedVLNVs.append(VLNV(vlnv.getType(), vlnv.toString()));
+    }
+
+    int foundCount = 0;
+
+    int iterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK
+    {
+        foundCount = 0;
+        for (VLNV const& vlnv : searchedVLNVs)
+        {
+            if (interned ? table.find(vlnv) != VLNVTable::INVALID_HANDLE : orderedMap.contains(vlnv))
+            {
+                foundCount++;
+            }
+        }
+
+        iterations++;
+    }
+
+    QJsonObject measurements;
+    measurements.insert(QStringLiteral("lookupsPerIteration"), searchedVLNVs.size());
+    recordResult(timer, iterations, measurements);
+
+    QCOMPARE(foundCount, searchedVLNVs.size());
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryPerformance::benchmarkReadComponent()
+//-----------------------------------------------------------------------------
+void tst_LibraryPerformance::benchmarkReadComponent()
+{
+    QString path = generator_.componentPaths().first();
+    QSharedPointer<Document> model;
+
+    int iterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK
+    {
+        model = DocumentFileAccess::readDocument(path);
+        iterations++;
+    }
+    recordResult(timer, iterations);
+
+    QVERIFY(model.isNull() == false);
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryPerformance::benchmarkReadComponentWithHash()
+//-----------------------------------------------------------------------------
+void tst_LibraryPerformance::benchmarkReadComponentWithHash()
+{
+    // The library reads documents with their content hash, so the difference to benchmarkReadComponent()
+    // is the cost of recognizing touched files later.
+    QString path = generator_.componentPaths().first();
+    QSharedPointer<Document> model;
+    QByteArray contentHash;
+
+    int iterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK
+    {
+        model = DocumentFileAccess::readDocument(path, contentHash);
+        iterations++;
+    }
+    recordResult(timer, iterations);
+
+    QVERIFY(model.isNull() == false);
+    QCOMPARE(contentHash, DocumentFileAccess::hashFile(path));
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryPerformance::benchmarkReadHierarchicalComponent()
+//-----------------------------------------------------------------------------
+void tst_LibraryPerformance::benchmarkReadHierarchicalComponent()
+{
+    QString path = LibraryHandler::getInstance().getPath(generator_.topComponent());
+    QSharedPointer<Document> model;
+
+    int iterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK
+    {
+        model = DocumentFileAccess::readDocument(path);
+        iterations++;
+    }
+    recordResult(timer, iterations);
+
+    QVERIFY(model.isNull() == false);
+    QVERIFY(model->getDependentVLNVs().isEmpty() == false);
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryPerformance::benchmarkWriteComponent()
+//-----------------------------------------------------------------------------
+void tst_LibraryPerformance::benchmarkWriteComponent()
+{
+    QSharedPointer<Document> model = DocumentFileAccess::readDocument(generator_.componentPaths().first());
+    QVERIFY(model.isNull() == false);
+
+    QTemporaryDir outputDirectory;
+    QString path = outputDirectory.filePath(QStringLiteral("written.xml"));
+
+    bool written = false;
+    int iterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK
+    {
+        written = DocumentFileAccess::writeDocument(model, path);
+        iterations++;
+    }
+    recordResult(timer, iterations);
+
+    QVERIFY(written);
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryPerformance::benchmarkCheckLibraryIntegrity()
+//-----------------------------------------------------------------------------
+void tst_LibraryPerformance::benchmarkCheckLibraryIntegrity()
+{
+    resetLibrary();
+
+    LibraryHandler& library = LibraryHandler::getInstance();
+
+    int iterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK
+    {
+        library.onCheckLibraryIntegrity();
+        iterations++;
+    }
+    recordResult(timer, iterations);
+
+    QVERIFY(library.isValid(generator_.topComponent()));
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryPerformance::benchmarkRefreshTouchedLibrary()
+//-----------------------------------------------------------------------------
+void tst_LibraryPerformance::benchmarkRefreshTouchedLibrary()
+{
+    resetLibrary();
+
+    LibraryHandler& library = LibraryHandler::getInstance();
+
+    // Touch a few files without changing them, like a checkout switching between branches does.
+    QStringList touchedPaths(library.getPath(generator_.topComponent()));
+    for (QString const& componentPath : generator_.componentPaths().mid(0, 19))
+    {
+        touchedPaths.append(componentPath);
+    }
+
+    QSharedPointer<Document const> topModel = library.getModelReadOnly(generator_.topComponent());
+    QVERIFY(topModel.isNull() == false);
+
+    int iterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK
+    {
+        QDateTime const touchTime = QDateTime::currentDateTime().addSecs(iterations + 1);
+        for (QString const& touchedPath : touchedPaths)
+        {
+            QFile touchedFile(touchedPath);
+            QVERIFY(touchedFile.open(QFile::ReadWrite));
+            QVERIFY(touchedFile.setFileTime(touchTime, QFileDevice::FileModificationTime));
+        }
+
+        library.searchForIPXactFiles();
+        iterations++;
+    }
+    recordResult(timer, iterations);
+
+    // The unchanged content is recognized, so the model is not read again.
+    QCOMPARE(library.getModelReadOnly(generator_.topComponent()), topModel);
+    QVERIFY(library.isValid(generator_.topComponent()));
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryPerformance::benchmarkResetHierarchyModel()
+//-----------------------------------------------------------------------------
+void tst_LibraryPerformance::benchmarkResetHierarchyModel()
+{
+    resetLibrary();
+
+    HierarchyModel* hierarchyModel = LibraryHandler::getInstance().getHierarchyModel();
+
+    int iterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK
+    {
+        hierarchyModel->onResetModel();
+        iterations++;
+    }
+    recordResult(timer, iterations);
+
+    QVERIFY(hierarchyModel->rowCount(QModelIndex()) > 0);
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryPerformance::setLibraryLocations()
+//-----------------------------------------------------------------------------
+void tst_LibraryPerformance::setLibraryLocations(QStringList const& locations)
+{
+    QSettings settings;
+    settings.setValue(QStringLiteral("Library/ActiveLocations"), locations);
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryPerformance::resetLibrary()
+//-----------------------------------------------------------------------------
+void tst_LibraryPerformance::resetLibrary()
+{
+    LibraryHandler& library = LibraryHandler::getInstance();
+
+    // Searching without locations drops all the documents, so none of them is kept as unchanged.
+    setLibraryLocations(QStringList());
+    library.searchForIPXactFiles();
+    QCOMPARE(library.getAllVLNVs().count(), 0);
+
+    setLibraryLocations(QStringList(libraryDirectory_.path()));
+    library.searchForIPXactFiles();
+    QCOMPARE(library.getAllVLNVs().count(), generator_.documentCount());
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryPerformance::recordResult()
+//-----------------------------------------------------------------------------
+void tst_LibraryPerformance::recordResult(QElapsedTimer const& timer, int iterations,
+    QJsonObject const& measurements)
+{
+    qint64 elapsed = timer.nsecsElapsed();
+
+    QString name = QString::fromLatin1(QTest::currentTestFunction());
+    if (QTest::currentDataTag())
+    {
+        name += QLatin1Char(':') + QString::fromLatin1(QTest::currentDataTag());
+    }
+
+    QJsonObject result = measurements;
+    result.insert(QStringLiteral("name"), name);
+    result.insert(QStringLiteral("iterations"), iterations);
+    result.insert(QStringLiteral("totalMs"), elapsed / 1e6);
+    result.insert(QStringLiteral("msPerIteration"), iterations > 0 ? elapsed / 1e6 / iterations : 0.0);
+
+    results_.append(result);
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_LibraryPerformance::parameterFromEnvironment()
+//-----------------------------------------------------------------------------
+int tst_LibraryPerformance::parameterFromEnvironment(char const* name, int defaultValue)
+{
+    bool isNumber = false;
+    int value = qEnvironmentVariableIntValue(name, &isNumber);
+
+    return isNumber ? value : defaultValue;
+}
+
+QTEST_GUILESS_MAIN(tst_LibraryPerformance)
+
+#include "tst_LibraryPerformance.moc"
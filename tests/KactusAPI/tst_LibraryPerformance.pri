@@ -0,0 +1,8 @@
+# ----------------------------------------------------
+# This file is generated by the Qt Visual Studio Add-in.
+# ------------------------------------------------------
+
+HEADERS += ./SyntheticLibraryGenerator.h
+
+SOURCES += ./SyntheticLibraryGenerator.cpp \
+    ./tst_LibraryPerformance.cpp
@@ -0,0 +1,232 @@
+//-----------------------------------------------------------------------------
+// File: tst_Tracing.cpp
+//-----------------------------------------------------------------------------
+// Project: Kactus2
+// Author: Kactus2 team
+// Date: 16.10.2026
+//
+// Description:
+// Unit test for recording timed spans and writing them as a Chrome trace.
+//-----------------------------------------------------------------------------
+
+#include <QtTest>
+
+#include <KactusAPI/include/Tracing.h>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+#include <atomic>
+
+class tst_Tracing : public QObject
+{
+    Q_OBJECT
+
+public:
+    tst_Tracing();
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testDisabledSpansAreNotRecorded();
+    void testEnabledSpansAreRecorded();
+    void testNestedSpans();
+    void testRingBufferKeepsLatestSpans();
+    void testCountersAreWritten();
+
+private:
+
+    /*!
+     *  Writes the recorded trace and reads back its events.
+     *
+     *    @param [in] phase   The type of the events to read, e.g. X for spans and C for counters.
+     *
+     *    @return The events of the given type in the written order.
+     */
+    QJsonArray writeEvents(QString const& phase);
+
+    //! The directory for the written traces.
+    QTemporaryDir traceDirectory_;
+};
+
+//-----------------------------------------------------------------------------
+// Function: tst_Tracing::tst_Tracing()
+//-----------------------------------------------------------------------------
+tst_Tracing::tst_Tracing()
+{
+
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_Tracing::init()
+//-----------------------------------------------------------------------------
+void tst_Tracing::init()
+{
+    Tracing::setCapacity(1 << 16);
+    Tracing::setEnabled(true);
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_Tracing::cleanup()
+//-----------------------------------------------------------------------------
+void tst_Tracing::cleanup()
+{
+    Tracing::setEnabled(false);
+    Tracing::clear();
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_Tracing::testDisabledSpansAreNotRecorded()
+//-----------------------------------------------------------------------------
+void tst_Tracing::testDisabledSpansAreNotRecorded()
+{
+    Tracing::setEnabled(false);
+    QCOMPARE(Tracing::isEnabled(), false);
+
+    {
+        Tracing::Span span("test", "disabled");
+        QCOMPARE(span.isRecording(), false);
+    }
+
+    QCOMPARE(writeEvents("X").size(), 0);
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_Tracing::testEnabledSpansAreRecorded()
+//-----------------------------------------------------------------------------
+void tst_Tracing::testEnabledSpansAreRecorded()
+{
+    QCOMPARE(Tracing::isEnabled(), true);
+
+    {
+        KACTUS2_TRACE_SCOPE("test", "plain");
+    }
+    {
+        KACTUS2_TRACE_SCOPE_DETAIL("test", "detailed", QStringLiteral("first.xml"));
+    }
+
+    QJsonArray events = writeEvents("X");
+    QCOMPARE(events.size(), 2);
+
+    QJsonObject plain = events.at(0).toObject();
+    QCOMPARE(plain.value("name").toString(), QString("plain"));
+    QCOMPARE(plain.value("cat").toString(), QString("test"));
+    QVERIFY(plain.value("dur").toDouble() >= 0.0);
+    QCOMPARE(plain.contains("args"), false);
+
+    QJsonObject detailed = events.at(1).toObject();
+    QCOMPARE(detailed.value("name").toString(), QString("detailed"));
+    QCOMPARE(detailed.value("args").toObject().value("detail").toString(), QString("first.xml"));
+    QVERIFY(detailed.value("ts").toDouble() >= plain.value("ts").toDouble());
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_Tracing::testNestedSpans()
+//-----------------------------------------------------------------------------
+void tst_Tracing::testNestedSpans()
+{
+    {
+        KACTUS2_TRACE_SCOPE("test", "outer");
+        {
+            KACTUS2_TRACE_SCOPE("test", "inner");
+            QTest::qSleep(2);
+        }
+    }
+
+    // The spans are recorded when they end, so the inner span comes first.
+    QJsonArray events = writeEvents("X");
+    QCOMPARE(events.size(), 2);
+
+    QJsonObject inner = events.at(0).toObject();
+    QJsonObject outer = events.at(1).toObject();
+    QCOMPARE(inner.value("name").toString(), QString("inner"));
+    QCOMPARE(outer.value("name").toString(), QString("outer"));
+    QCOMPARE(inner.value("tid").toInt(), outer.value("tid").toInt());
+
+    const double innerStart = inner.value("ts").toDouble();
+    const double outerStart = outer.value("ts").toDouble();
+    QVERIFY(innerStart >= outerStart);
+    QVERIFY(innerStart + inner.value("dur").toDouble() <= outerStart + outer.value("dur").toDouble());
+    QVERIFY(inner.value("dur").toDouble() >= 1000.0);
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_Tracing::testRingBufferKeepsLatestSpans()
+//-----------------------------------------------------------------------------
+void tst_Tracing::testRingBufferKeepsLatestSpans()
+{
+    Tracing::setCapacity(3);
+
+    for (int i = 0; i < 5; ++i)
+    {
+        KACTUS2_TRACE_SCOPE_DETAIL("test", "repeated", QString::number(i));
+    }
+
+    QJsonArray events = writeEvents("X");
+    QCOMPARE(events.size(), 3);
+
+    for (int i = 0; i < events.size(); ++i)
+    {
+        QCOMPARE(events.at(i).toObject().value("args").toObject().value("detail").toString(),
+            QString::number(i + 2));
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_Tracing::testCountersAreWritten()
+//-----------------------------------------------------------------------------
+void tst_Tracing::testCountersAreWritten()
+{
+    // The counters stay registered, so they must not refer to the stack of the test.
+    auto hits = QSharedPointer<std::atomic<qint64> >::create(3);
+    Tracing::addCounters("testCounters", [hits]()
+        {
+            return Tracing::Counters({ { QStringLiteral("hits"), hits->load() } });
+        });
+
+    hits->store(7);
+
+    QJsonObject counters;
+    for (auto const& event : writeEvents("C"))
+    {
+        if (event.toObject().value("name").toString() == QLatin1String("testCounters"))
+        {
+            counters = event.toObject().value("args").toObject();
+        }
+    }
+
+    QCOMPARE(counters.value("hits").toInt(), 7);
+}
+
+//-----------------------------------------------------------------------------
+// Function: tst_Tracing::writeEvents()
+//-----------------------------------------------------------------------------
+QJsonArray tst_Tracing::writeEvents(QString const& phase)
+{
+    const QString tracePath = traceDirectory_.filePath("trace.json");
+    if (Tracing::writeChromeTrace(tracePath) == false)
+    {
+        return QJsonArray();
+    }
+
+    QFile traceFile(tracePath);
+    traceFile.open(QIODevice::ReadOnly);
+
+    QJsonArray events;
+    for (auto const& event : QJsonDocument::fromJson(traceFile.readAll()).object().value("traceEvents").toArray())
+    {
+        if (event.toObject().value("ph").toString() == phase)
+        {
+            events.append(event);
+        }
+    }
+
+    return events;
+}
+
+QTEST_MAIN(tst_Tracing)
+
+#include "tst_Tracing.moc"
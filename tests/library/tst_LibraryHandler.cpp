@@ -15,6 +15,11 @@
 #include <Plugins/PluginSystem/GeneratorPlugin/MessagePasser.h>
 #include <KactusAPI/include/LibraryHandler.h>
 
+#include <IPXACTmodels/common/ConfigurableVLNVReference.h>
+#include <IPXACTmodels/Component/Component.h>
+#include <IPXACTmodels/Design/ComponentInstance.h>
+#include <IPXACTmodels/Design/Design.h>
+
 void noMessageOutput(QtMsgType type, const QMessageLogContext &context, const QString &msg) {}
 
 class tst_LibraryHandler : public QObject
@@ -30,6 +35,12 @@ private:
     
     void setupTestLibrary();
 
+    bool writeComponent(VLNV const& vlnv, QString const& path, QString const& description = QString());
+
+    bool setModificationTime(QString const& path, QDateTime const& time);
+
+    QString indexFilePath(QString const& location) const;
+
     MessagePasser messageChannel_;
 
 private slots:
@@ -42,6 +53,26 @@ private slots:
 
     void testLibraryGetModel();
 
+    void testSharedModelIsCopiedOnEdit();
+
+    void testEvictedModelIsReadAgain();
+
+    void testMetadataMatchesModel();
+
+    void testGroupedSavesAreCommittedTogether();
+
+    void testItemRemovedInSaveGroupIsNotWritten();
+
+    void testSavingRevalidatesDependents();
+
+    void testUnchangedLibraryIsNotReadAgain();
+
+    void testStaleIndexEntriesAreNotUsed();
+
+    void testChangedFilesAreRefreshed();
+
+    void testProgressiveSearchShowsItemsInBatches();
+
     void testDocumentsInLocationAreRead();
 
 
@@ -74,6 +105,29 @@ LibraryHandler* tst_LibraryHandler::createLibraryHandler()
     return LibraryHandler::getInstance();
 }
 
+bool tst_LibraryHandler::writeComponent(VLNV const& vlnv, QString const& path, QString const& description)
+{
+    QSharedPointer<Component> component(new Component(vlnv, Document::Revision::Std22));
+    component->setDescription(description);
+
+    return DocumentFileAccess::writeDocument(component, path);
+}
+
+bool tst_LibraryHandler::setModificationTime(QString const& path, QDateTime const& time)
+{
+    QFile file(path);
+    return file.open(QFile::ReadWrite) && file.setFileTime(time, QFileDevice::FileModificationTime);
+}
+
+QString tst_LibraryHandler::indexFilePath(QString const& location) const
+{
+    QByteArray const locationHash =
+        QCryptographicHash::hash(QDir::cleanPath(location).toUtf8(), QCryptographicHash::Sha1).toHex();
+
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/libraryIndex/") +
+        QString::fromLatin1(locationHash) + QStringLiteral(".idx");
+}
+
 void tst_LibraryHandler::testLibraryDoesNotContainItem()
 {
     QScopedPointer<LibraryHandler> library(createLibraryHandler());
@@ -127,6 +181,432 @@ void tst_LibraryHandler::testLibraryGetModel()
     QVERIFY(model.isNull() == false);
 }
 
+void tst_LibraryHandler::testSharedModelIsCopiedOnEdit()
+{
+    QScopedPointer<LibraryHandler> library(createLibraryHandler());
+
+    library->searchForIPXactFiles();
+
+    VLNV validItem(VLNV::COMPONENT, QStringLiteral("tut.fi:cpu.logic:alu:1.0"));
+
+    SharedDocument<Document> firstHandle = library->getSharedModel<Document>(validItem);
+    SharedDocument<Document> secondHandle = library->getSharedModel<Document>(validItem);
+
+    QVERIFY(firstHandle.isNull() == false);
+    QVERIFY(firstHandle.get() == secondHandle.get());
+    QVERIFY(firstHandle.get() == library->getModelReadOnly(validItem));
+
+    QSharedPointer<Document> editedModel = firstHandle.edit();
+
+    QVERIFY(firstHandle.isDetached());
+    QVERIFY(secondHandle.isDetached() == false);
+    QVERIFY(firstHandle.get() == editedModel);
+    QVERIFY(secondHandle.get() == library->getModelReadOnly(validItem));
+    QVERIFY(editedModel != library->getModelReadOnly(validItem));
+    QCOMPARE(editedModel->getVlnv(), validItem);
+
+    // Copies of an unedited handle are edited separately, e.g. by the instances of a component in a design
+    // that add ports to the instance.
+    SharedDocument<Document> firstInstance = secondHandle;
+    SharedDocument<Document> secondInstance = secondHandle;
+    QVERIFY(firstInstance.edit() != secondInstance.edit());
+    QVERIFY(secondHandle.isDetached() == false);
+
+    QVERIFY(library->getModel(validItem) != library->getModelReadOnly(validItem));
+}
+
+void tst_LibraryHandler::testEvictedModelIsReadAgain()
+{
+    QScopedPointer<LibraryHandler> library(createLibraryHandler());
+
+    library->searchForIPXactFiles();
+
+    VLNV validItem(VLNV::COMPONENT, QStringLiteral("tut.fi:cpu.logic:alu:1.0"));
+
+    // Without any budget, every document is evicted right after it has been read.
+    library->setCacheBudget(0);
+
+    LibraryHandler::CacheStatistics before = library->getCacheStatistics();
+
+    QSharedPointer<Document const> model = library->getModelReadOnly(validItem);
+    QVERIFY(model.isNull() == false);
+    QCOMPARE(library->getCacheStatistics().cachedDocuments, 0);
+    QVERIFY(library->getCacheStatistics().evictions > before.evictions);
+
+    // The dropped model is still in use here, so its memory is counted as retained instead of freed.
+    QVERIFY(library->getCacheStatistics().retainedBytes > 0);
+
+    // A model still in use is taken back instead of reading it again.
+    QVERIFY(library->getModelReadOnly(validItem) == model);
+
+    qint64 missesBeforeRead = library->getCacheStatistics().misses;
+    model.clear();
+
+    QSharedPointer<Document const> readModel = library->getModelReadOnly(validItem);
+    QVERIFY(readModel.isNull() == false);
+    QCOMPARE(readModel->getVlnv(), validItem);
+    QCOMPARE(library->getCacheStatistics().misses, missesBeforeRead + 1);
+    QVERIFY(library->isValid(validItem));
+
+    library->setCacheBudget(1024LL * 1024 * 1024);
+}
+
+void tst_LibraryHandler::testMetadataMatchesModel()
+{
+    QScopedPointer<LibraryHandler> library(createLibraryHandler());
+
+    library->searchForIPXactFiles();
+
+    VLNV validItem(VLNV::COMPONENT, QStringLiteral("tut.fi:cpu.logic:alu:1.0"));
+
+    DocumentMetadata metadata = library->getMetadata(validItem);
+    QSharedPointer<Document const> model = library->getModelReadOnly(validItem);
+
+    QVERIFY(metadata.isKnown());
+    QCOMPARE(metadata.type, VLNV::COMPONENT);
+    QCOMPARE(metadata.implementation, model->getImplementation());
+    QCOMPARE(metadata.firmness, model->getFirmness());
+    QVERIFY(metadata.revision == model->getRevision());
+    QCOMPARE(metadata.tags.size(), model->getTags().size());
+    QCOMPARE(metadata.isValid, library->isValid(validItem));
+
+    for (VLNV const& dependency : metadata.dependencies)
+    {
+        QVERIFY(model->getDependentVLNVs().contains(dependency));
+    }
+
+    QVERIFY(library->getMetadata(VLNV(VLNV::COMPONENT, QStringLiteral("tut.fi:testLibrary:noItem:0"))).isKnown() == false);
+}
+
+void tst_LibraryHandler::testGroupedSavesAreCommittedTogether()
+{
+    QScopedPointer<LibraryHandler> library(createLibraryHandler());
+
+    library->searchForIPXactFiles();
+
+    QTemporaryDir saveDirectory;
+    QVERIFY(saveDirectory.isValid());
+
+    QSharedPointer<Document> model = library->getModel(VLNV(VLNV::COMPONENT, QStringLiteral("tut.fi:cpu.logic:alu:1.0")));
+    QVERIFY(model.isNull() == false);
+
+    VLNV firstItem(VLNV::COMPONENT, QStringLiteral("tut.fi:testLibrary:savedFirst:1.0"));
+    VLNV secondItem(VLNV::COMPONENT, QStringLiteral("tut.fi:testLibrary:savedSecond:1.0"));
+
+    library->beginSave();
+
+    model->setVlnv(firstItem);
+    QVERIFY(library->writeModelToFile(saveDirectory.path(), model));
+
+    model->setVlnv(secondItem);
+    QVERIFY(library->writeModelToFile(saveDirectory.path(), model));
+
+    // The saved documents are available right away, even before they have been written.
+    QVERIFY(library->contains(firstItem));
+    QCOMPARE(library->getModelReadOnly(firstItem)->getVlnv(), firstItem);
+
+    library->endSave();
+    library->waitForPendingWrites();
+
+    QDir savedFiles(saveDirectory.path());
+    QCOMPARE(savedFiles.entryList(QDir::Files), QStringList({ QStringLiteral("savedFirst.1.0.xml"),
+        QStringLiteral("savedSecond.1.0.xml") }));
+
+    QSharedPointer<Document> writtenModel = DocumentFileAccess::readDocument(library->getPath(secondItem));
+    QVERIFY(writtenModel.isNull() == false);
+    QCOMPARE(writtenModel->getVlnv(), secondItem);
+
+    library->removeObjects({ firstItem, secondItem });
+    QVERIFY(savedFiles.entryList(QDir::Files).isEmpty());
+}
+
+void tst_LibraryHandler::testItemRemovedInSaveGroupIsNotWritten()
+{
+    QScopedPointer<LibraryHandler> library(createLibraryHandler());
+
+    library->searchForIPXactFiles();
+
+    QTemporaryDir saveDirectory;
+    QVERIFY(saveDirectory.isValid());
+
+    QSharedPointer<Document> model = library->getModel(VLNV(VLNV::COMPONENT, QStringLiteral("tut.fi:cpu.logic:alu:1.0")));
+    QVERIFY(model.isNull() == false);
+
+    VLNV removedItem(VLNV::COMPONENT, QStringLiteral("tut.fi:testLibrary:removedInGroup:1.0"));
+    VLNV keptItem(VLNV::COMPONENT, QStringLiteral("tut.fi:testLibrary:keptInGroup:1.0"));
+
+    library->beginSave();
+
+    model->setVlnv(removedItem);
+    QVERIFY(library->writeModelToFile(saveDirectory.path(), model));
+
+    model->setVlnv(keptItem);
+    QVERIFY(library->writeModelToFile(saveDirectory.path(), model));
+
+    // The queued documents are read instead of the files, which have not been written yet.
+    library->setCacheBudget(0);
+    QSharedPointer<Document const> queuedModel = library->getModelReadOnly(keptItem);
+    QVERIFY(queuedModel.isNull() == false);
+    QCOMPARE(queuedModel->getVlnv(), keptItem);
+    library->setCacheBudget(1024LL * 1024 * 1024);
+
+    library->removeObject(removedItem);
+    QVERIFY(library->contains(removedItem) == false);
+
+    library->endSave();
+    library->waitForPendingWrites();
+
+    // Only the item still in the library is written when the group ends.
+    QDir savedFiles(saveDirectory.path());
+    QCOMPARE(savedFiles.entryList(QDir::Files), QStringList(QStringLiteral("keptInGroup.1.0.xml")));
+
+    library->removeObject(keptItem);
+    QVERIFY(savedFiles.entryList(QDir::Files).isEmpty());
+}
+
+void tst_LibraryHandler::testSavingRevalidatesDependents()
+{
+    QScopedPointer<LibraryHandler> library(createLibraryHandler());
+
+    library->searchForIPXactFiles();
+
+    QTemporaryDir saveDirectory;
+    QVERIFY(saveDirectory.isValid());
+
+    VLNV componentVLNV(VLNV::COMPONENT, QStringLiteral("tut.fi:testLibrary:instantiated:1.0"));
+    VLNV designVLNV(VLNV::DESIGN, QStringLiteral("tut.fi:testLibrary:instantiating.design:1.0"));
+
+    // The design instantiates a component that is not yet in the library.
+    QSharedPointer<Design> design(new Design(designVLNV, Document::Revision::Std22));
+    QSharedPointer<ConfigurableVLNVReference> componentReference(new ConfigurableVLNVReference(componentVLNV));
+    design->getComponentInstances()->append(QSharedPointer<ComponentInstance>(
+        new ComponentInstance(QStringLiteral("instance"), componentReference)));
+
+    QVERIFY(library->writeModelToFile(saveDirectory.path(), design));
+    library->waitForPendingWrites();
+
+    // The design is invalid only because of the missing component, not e.g. because its file is being written.
+    QString const missingComponent =
+        QStringLiteral("The referenced VLNV was not found in the library: ") + componentVLNV.toString();
+
+    QVERIFY(library->isValid(designVLNV) == false);
+    QVERIFY(library->findErrorsInDocument(design, library->getPath(designVLNV)).contains(missingComponent));
+
+    QList<VLNV> owners;
+    QCOMPARE(library->getOwners(owners, componentVLNV), 1);
+    QCOMPARE(owners.first(), designVLNV);
+
+    QSharedPointer<Document> component = library->getModel(VLNV(VLNV::COMPONENT, QStringLiteral("tut.fi:cpu.logic:alu:1.0")));
+    QVERIFY(component.isNull() == false);
+    component->setVlnv(componentVLNV);
+
+    QSignalSpy validitySpy(library.data(), SIGNAL(validityChanged(VLNV const&, bool)));
+
+    // Saving the instantiated component makes the design valid without a full integrity check.
+    QVERIFY(library->writeModelToFile(saveDirectory.path(), component));
+    library->waitForPendingWrites();
+
+    QVERIFY(library->isValid(designVLNV));
+    QVERIFY(library->findErrorsInDocument(design, library->getPath(designVLNV)).isEmpty());
+
+    QCOMPARE(validitySpy.count(), 1);
+    QCOMPARE(validitySpy.first().at(0).value<VLNV>(), designVLNV);
+    QCOMPARE(validitySpy.first().at(1).toBool(), true);
+
+    library->removeObjects({ designVLNV, componentVLNV });
+}
+
+void tst_LibraryHandler::testUnchangedLibraryIsNotReadAgain()
+{
+    QScopedPointer<LibraryHandler> library(createLibraryHandler());
+
+    library->searchForIPXactFiles();
+    QVERIFY(library->getAllVLNVs().isEmpty() == false);
+
+    qint64 const readsBeforeSearch = library->getCacheStatistics().reads;
+
+    // The items checked in the previous search keep their validity, summary and tags without reading them.
+    library->searchForIPXactFiles();
+    QCOMPARE(library->getCacheStatistics().reads, readsBeforeSearch);
+
+    // A full integrity check reads every item again.
+    library->onCheckLibraryIntegrity();
+    QVERIFY(library->getCacheStatistics().reads > readsBeforeSearch);
+}
+
+void tst_LibraryHandler::testStaleIndexEntriesAreNotUsed()
+{
+    QScopedPointer<LibraryHandler> library(createLibraryHandler());
+
+    QTemporaryDir location;
+    QVERIFY(location.isValid());
+
+    QSettings settings;
+    QVariant const activeLocations = settings.value(QStringLiteral("Library/ActiveLocations"));
+    settings.setValue(QStringLiteral("Library/ActiveLocations"), QStringList(location.path()));
+
+    QString const filePath = location.filePath(QStringLiteral("indexed.xml"));
+
+    VLNV alpha(VLNV::COMPONENT, QStringLiteral("tut.fi:testLibrary:alpha:1.0"));
+    VLNV bravo(VLNV::COMPONENT, QStringLiteral("tut.fi:testLibrary:bravo:1.0"));
+    VLNV charlie(VLNV::COMPONENT, QStringLiteral("tut.fi:testLibrary:charlie:1.0"));
+    VLNV foxtrot(VLNV::COMPONENT, QStringLiteral("tut.fi:testLibrary:foxtrot:1.0"));
+    VLNV juliett(VLNV::COMPONENT, QStringLiteral("tut.fi:testLibrary:juliett:1.0"));
+
+    QVERIFY(writeComponent(alpha, filePath));
+    library->searchForIPXactFiles();
+    QVERIFY(library->contains(alpha));
+    QVERIFY(QFileInfo::exists(indexFilePath(location.path())));
+
+    // A file of the same size is read again, if its modification time has changed.
+    qint64 const indexedSize = QFileInfo(filePath).size();
+    QDateTime const modified = QFileInfo(filePath).lastModified().addSecs(10);
+
+    QVERIFY(writeComponent(bravo, filePath));
+    QCOMPARE(QFileInfo(filePath).size(), indexedSize);
+    QVERIFY(setModificationTime(filePath, modified));
+
+    library->searchForIPXactFiles();
+    QVERIFY(library->contains(alpha) == false);
+    QVERIFY(library->contains(bravo));
+
+    // A file with the same modification time is read again, if its size has changed.
+    QVERIFY(writeComponent(charlie, filePath));
+    QVERIFY(QFileInfo(filePath).size() != indexedSize);
+    QVERIFY(setModificationTime(filePath, modified));
+
+    library->searchForIPXactFiles();
+    QVERIFY(library->contains(bravo) == false);
+    QVERIFY(library->contains(charlie));
+
+    // An index of another version is not used, even if its entries match the files.
+    QFile indexFile(indexFilePath(location.path()));
+    QVERIFY(indexFile.open(QFile::ReadWrite));
+
+    QDataStream indexStream(&indexFile);
+    quint32 magic = 0;
+    quint32 version = 0;
+    indexStream >> magic >> version;
+    indexFile.seek(sizeof(quint32));
+    indexStream << version + 1;
+    indexFile.close();
+
+    QVERIFY(writeComponent(foxtrot, filePath));
+    QVERIFY(setModificationTime(filePath, modified));
+
+    library->searchForIPXactFiles();
+    QVERIFY(library->contains(charlie) == false);
+    QVERIFY(library->contains(foxtrot));
+
+    // A corrupted index is not used either.
+    QVERIFY(indexFile.open(QFile::ReadWrite));
+    QVERIFY(indexFile.resize(indexFile.size() / 2));
+    indexFile.close();
+
+    QVERIFY(writeComponent(juliett, filePath));
+    QVERIFY(setModificationTime(filePath, modified));
+
+    library->searchForIPXactFiles();
+    QVERIFY(library->contains(foxtrot) == false);
+    QVERIFY(library->contains(juliett));
+
+    settings.setValue(QStringLiteral("Library/ActiveLocations"), activeLocations);
+    QFile::remove(indexFilePath(location.path()));
+
+    library->searchForIPXactFiles();
+}
+
+void tst_LibraryHandler::testChangedFilesAreRefreshed()
+{
+    QScopedPointer<LibraryHandler> library(createLibraryHandler());
+
+    QTemporaryDir location;
+    QVERIFY(location.isValid());
+
+    QSettings settings;
+    QVariant const activeLocations = settings.value(QStringLiteral("Library/ActiveLocations"));
+    settings.setValue(QStringLiteral("Library/ActiveLocations"), QStringList(location.path()));
+
+    VLNV modifiedItem(VLNV::COMPONENT, QStringLiteral("tut.fi:testLibrary:modified:1.0"));
+    VLNV removedItem(VLNV::COMPONENT, QStringLiteral("tut.fi:testLibrary:removed:1.0"));
+    VLNV renamedItem(VLNV::COMPONENT, QStringLiteral("tut.fi:testLibrary:renamed:1.0"));
+    VLNV addedItem(VLNV::COMPONENT, QStringLiteral("tut.fi:testLibrary:added:1.0"));
+
+    QVERIFY(writeComponent(modifiedItem, location.filePath(QStringLiteral("modified.xml"))));
+    QVERIFY(writeComponent(removedItem, location.filePath(QStringLiteral("removed.xml"))));
+    QVERIFY(writeComponent(renamedItem, location.filePath(QStringLiteral("renamed.xml"))));
+
+    library->searchForIPXactFiles();
+    QCOMPARE(library->getAllVLNVs().count(), 3);
+
+    QSharedPointer<Document const> model = library->getModelReadOnly(modifiedItem);
+    QVERIFY(model.isNull() == false);
+    QVERIFY(model->getDescription().isEmpty());
+
+    // The files in the watched directory are changed outside the library.
+    QVERIFY(writeComponent(addedItem, location.filePath(QStringLiteral("added.xml"))));
+    QVERIFY(writeComponent(modifiedItem, location.filePath(QStringLiteral("modified.xml")),
+        QStringLiteral("Changed outside the library.")));
+    QVERIFY(QFile::remove(location.filePath(QStringLiteral("removed.xml"))));
+    QVERIFY(QFile::rename(location.filePath(QStringLiteral("renamed.xml")),
+        location.filePath(QStringLiteral("moved.xml"))));
+
+    // The watcher reports the changed directory, and the changes are refreshed in a single round.
+    QVERIFY(QMetaObject::invokeMethod(library.data(), "onDirectoryChanged", Qt::DirectConnection,
+        Q_ARG(QString, location.path())));
+    QVERIFY(QMetaObject::invokeMethod(library.data(), "onRefreshChangedDirectories", Qt::DirectConnection));
+
+    QCOMPARE(library->getAllVLNVs().count(), 3);
+    QVERIFY(library->contains(addedItem));
+    QVERIFY(library->contains(removedItem) == false);
+
+    QVERIFY(library->contains(renamedItem));
+    QCOMPARE(QFileInfo(library->getPath(renamedItem)).fileName(), QStringLiteral("moved.xml"));
+
+    // The modified item is read again instead of using the model read before the change.
+    QCOMPARE(library->getModelReadOnly(modifiedItem)->getDescription(), QStringLiteral("Changed outside the library."));
+
+    settings.setValue(QStringLiteral("Library/ActiveLocations"), activeLocations);
+    QFile::remove(indexFilePath(location.path()));
+
+    library->searchForIPXactFiles();
+}
+
+void tst_LibraryHandler::testProgressiveSearchShowsItemsInBatches()
+{
+    QScopedPointer<LibraryHandler> library(createLibraryHandler());
+
+    library->searchForIPXactFiles();
+    int const itemCount = library->getAllVLNVs().count();
+    QVERIFY(itemCount > 0);
+
+    QSignalSpy progressSpy(library.data(), SIGNAL(libraryScanProgress(int, int)));
+    QSignalSpy finishedSpy(library.data(), SIGNAL(libraryScanFinished()));
+
+    // The search returns right away and the items are added as they are found.
+    library->startLibrarySearch();
+    QVERIFY(library->isLibraryScanRunning());
+
+    library->waitForLibraryScan();
+    QVERIFY(library->isLibraryScanRunning() == false);
+    QCOMPARE(finishedSpy.count(), 1);
+    QVERIFY(progressSpy.isEmpty() == false);
+    QCOMPARE(progressSpy.last().at(0).toInt(), progressSpy.last().at(1).toInt());
+    QCOMPARE(library->getAllVLNVs().count(), itemCount);
+
+    // The previous items stay in the library during the search, and a cancelled search removes none of them.
+    library->startLibrarySearch();
+    QCOMPARE(library->getAllVLNVs().count(), itemCount);
+    library->cancelLibraryScan();
+
+    QVERIFY(library->isLibraryScanRunning() == false);
+    QCOMPARE(finishedSpy.count(), 2);
+    QCOMPARE(library->getAllVLNVs().count(), itemCount);
+
+    library->searchForIPXactFiles();
+    QCOMPARE(library->getAllVLNVs().count(), itemCount);
+}
+
 void tst_LibraryHandler::testDocumentsInLocationAreRead()
 {
     QScopedPointer<LibraryHandler> library(createLibraryHandler());